@@ -0,0 +1,103 @@
+#!/usr/bin/env node
+/**
+ * Startup benchmark - what importing @ssxv/node-printer costs a cold process
+ * Run with: npm run bench:startup [-- --runs 20 --json]
+ *
+ * Each run is a fresh Node process (so module and addon caches are cold) that measures:
+ *   import      require() of the package; must not load the addon or touch the spooler
+ *   addon       first native call (metrics.get): dlopen plus Init, still no spooler calls
+ *   firstList   first printers.list(): backend creation plus the first CUPS/Winspool round-trip
+ *   warmup      printers.warmup() in place of the first list, then a printers.list() after it
+ * Requires a built package (npm run build).
+ */
+const { execFileSync } = require('child_process');
+const path = require('path');
+
+const PACKAGE = path.join(__dirname, '..');
+
+function child() {
+  const ms = start => Number(process.hrtime.bigint() - start) / 1e6;
+  const result = {};
+
+  let start = process.hrtime.bigint();
+  const { printers, metrics } = require(PACKAGE);
+  result.import = ms(start);
+
+  (async () => {
+    start = process.hrtime.bigint();
+    const before = await metrics.get();
+    result.addon = ms(start);
+    result.backendsAtLoad = before.backends;
+
+    if (process.argv.includes('--warmup')) {
+      start = process.hrtime.bigint();
+      await printers.warmup();
+      result.warmup = ms(start);
+    }
+
+    start = process.hrtime.bigint();
+    await printers.list();
+    result.firstList = ms(start);
+
+    process.stdout.write(JSON.stringify(result));
+  })().catch(error => {
+    process.stderr.write(String(error && error.stack ? error.stack : error));
+    process.exit(1);
+  });
+}
+
+function median(values) {
+  const sorted = values.filter(value => typeof value === 'number').sort((a, b) => a - b);
+  if (sorted.length === 0) return undefined;
+  const middle = Math.floor(sorted.length / 2);
+  return sorted.length % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+function run(args) {
+  const output = execFileSync(process.execPath, [__filename, '--child', ...args], { encoding: 'utf8' });
+  return JSON.parse(output);
+}
+
+function main() {
+  const runsIndex = process.argv.indexOf('--runs');
+  const runs = runsIndex > 0 ? Number(process.argv[runsIndex + 1]) || 10 : 10;
+  const json = process.argv.includes('--json');
+
+  const cold = [];
+  const warmed = [];
+  for (let i = 0; i < runs; i++) {
+    cold.push(run([]));
+    warmed.push(run(['--warmup']));
+  }
+
+  const summary = {
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    runs,
+    medianMs: {
+      import: median(cold.map(r => r.import)),
+      addon: median(cold.map(r => r.addon)),
+      firstList: median(cold.map(r => r.firstList)),
+      warmup: median(warmed.map(r => r.warmup)),
+      listAfterWarmup: median(warmed.map(r => r.firstList))
+    },
+    backendsAtLoad: cold[0] && cold[0].backendsAtLoad
+  };
+
+  if (json) {
+    console.log(JSON.stringify(summary, null, 2));
+    return;
+  }
+
+  console.log(`=== Startup (${summary.platform}, Node ${summary.node}, median of ${runs} cold processes) ===\n`);
+  for (const [name, value] of Object.entries(summary.medianMs)) {
+    console.log(`${name.padEnd(16)} ${value === undefined ? '-' : value.toFixed(2) + ' ms'}`);
+  }
+  console.log(`\nBackends created by loading the addon: ${JSON.stringify(summary.backendsAtLoad)}`);
+}
+
+if (process.argv.includes('--child')) {
+  child();
+} else {
+  main();
+}
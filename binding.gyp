@@ -8,7 +8,20 @@
           {
             "sources": [
               "src/native/addon.cpp",
-              "src/native/errors.cpp"
+              "src/native/errors.cpp",
+              "src/native/native_core.cpp",
+              "src/native/printer_pool.cpp",
+              "src/native/printer_health.cpp",
+              "src/native/printer_state_table.cpp",
+              "src/native/submission_queue.cpp",
+              "src/native/rate_limiter.cpp",
+              "src/native/retry_policy.cpp",
+              "src/native/job_ledger.cpp",
+              "src/native/raster_encoder.cpp",
+              "src/native/image_processor.cpp",
+              "src/native/template_engine.cpp",
+              "src/native/format_sniffer.cpp",
+              "src/native/transcoder.cpp"
             ]
           }
         ],
@@ -17,12 +30,33 @@
           {
             "sources": [
               "src/native/addon.cpp",
-              "src/native/errors.cpp"
+              "src/native/errors.cpp",
+              "src/native/native_core.cpp",
+              "src/native/printer_pool.cpp",
+              "src/native/printer_health.cpp",
+              "src/native/printer_state_table.cpp",
+              "src/native/submission_queue.cpp",
+              "src/native/rate_limiter.cpp",
+              "src/native/retry_policy.cpp",
+              "src/native/job_ledger.cpp",
+              "src/native/raster_encoder.cpp",
+              "src/native/image_processor.cpp",
+              "src/native/template_engine.cpp",
+              "src/native/format_sniffer.cpp",
+              "src/native/transcoder.cpp"
             ],
             "libraries": [
               "-lcups"
             ]
           }
+        ],
+        [
+          "OS=='mac'",
+          {
+            "libraries": [
+              "-liconv"
+            ]
+          }
         ]
       ],
       "include_dirs": [
@@ -53,6 +53,23 @@ async function testErrorHandling() {
     console.log(`✅ Correctly caught error: ${error.message}`);
   }
 
+  // Test 4: holdUntil in the past
+  console.log('\n❌ Test 4: holdUntil Date in the past');
+  try {
+    await jobs.printRaw({
+      data: Buffer.from('test'),
+      printer: 'AnyPrinter',
+      options: { holdUntil: new Date(Date.now() - 60 * 1000) }
+    });
+    console.log('⚠️ Unexpected: Should have thrown error');
+  } catch (error) {
+    if (error.code === 'INVALID_ARGUMENTS') {
+      console.log(`✅ Correctly rejected: ${error.message}`);
+    } else {
+      console.log(`⚠️ Unexpected error code ${error.code}: ${error.message}`);
+    }
+  }
+
   // Test 5: Error types and properties
   console.log('\n🔍 Test 5: Error types and properties');
   try {
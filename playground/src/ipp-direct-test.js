@@ -0,0 +1,71 @@
+#!/usr/bin/env node
+/**
+ * Direct IPP test - Submit straight to an IPP Everywhere printer, bypassing cupsd
+ * Starts a local ippeveprinter (from cups-ipp-utils) unless IPP_PRINTER_URI is set
+ * Run with: node ipp-direct-test.js
+ */
+
+const path = require('path');
+const { spawn } = require('child_process');
+
+console.log('=== Direct IPP Test ===\n');
+
+const { jobs } = require('@ssxv/node-printer');
+const samplePdfFile = path.join(__dirname, 'test-files', 'sample.pdf');
+
+const port = 8631;
+const printerUri = process.env.IPP_PRINTER_URI || `ipp://localhost:${port}/ipp/print`;
+
+function startIppEvePrinter() {
+  if (process.env.IPP_PRINTER_URI) return null;
+
+  const child = spawn('ippeveprinter', ['-p', String(port), '-f', 'application/pdf,image/jpeg,text/plain', 'node-printer-test'], {
+    stdio: 'ignore'
+  });
+  child.on('error', error => console.error('❌ Could not start ippeveprinter:', error.message));
+  return child;
+}
+
+async function testDirectIpp() {
+  const printer = startIppEvePrinter();
+  await new Promise(resolve => setTimeout(resolve, 1500));
+
+  try {
+    console.log(`\n📄 Test 1: Print raw text to ${printerUri}`);
+    let job;
+    try {
+      job = await jobs.printRaw({
+        printer: printerUri,
+        data: Buffer.from('Hello from node-printer over direct IPP\n'),
+        format: 'TEXT'
+      });
+      console.log(`✅ Job submitted:`, job);
+    } catch (error) {
+      console.error('❌ Direct raw print failed:', error.message);
+    }
+
+    console.log('\n📄 Test 2: Print PDF file');
+    try {
+      const pdfJob = await jobs.printFile({ printer: printerUri, file: samplePdfFile });
+      console.log(`✅ Job submitted:`, pdfJob);
+    } catch (error) {
+      console.error('❌ Direct file print failed:', error.message);
+    }
+
+    console.log('\n📄 Test 3: Job status from the device');
+    try {
+      if (job) {
+        console.log(`✅ Job status:`, await jobs.get(printerUri, job.id));
+      }
+      console.log(`✅ Device jobs:`, await jobs.list({ printer: printerUri }));
+    } catch (error) {
+      console.error('❌ Status query failed:', error.message);
+    }
+  } finally {
+    if (printer) printer.kill();
+  }
+}
+
+if (require.main === module) {
+  testDirectIpp().catch(console.error);
+}
@@ -73,6 +73,37 @@ async function testPrinting() {
   } catch (error) {
     console.error('❌ Modern API print failed:', error.message);
   }
+
+  console.log('\n📄 Test 8: Iterate active jobs of mixed priority');
+  const held = [];
+  try {
+    // Held so they stay active; cupsd lists active jobs by priority, not by ID
+    for (const priority of [10, 90, 50, 100, 1]) {
+      const job = await jobs.printRaw({
+        printer: printerName,
+        data: Buffer.from(`priority ${priority}\n`),
+        options: { priority, holdUntil: 'indefinite', jobName: `iterate-${priority}` }
+      });
+      held.push(job.id);
+    }
+
+    const seen = new Set();
+    for await (const job of jobs.iterate({ printer: printerName, which: 'active', pageSize: 2 })) {
+      seen.add(job.id);
+    }
+    const missing = held.filter(id => !seen.has(id));
+    if (missing.length === 0) {
+      console.log(`✅ All ${held.length} held jobs listed across pages`);
+    } else {
+      console.error(`❌ Jobs missing from the iteration: ${missing.join(', ')}`);
+    }
+  } catch (error) {
+    console.error('❌ Iterate failed:', error.message);
+  } finally {
+    for (const id of held) {
+      await jobs.cancel(printerName, id).catch(() => {});
+    }
+  }
 }
 
 if (require.main === module) {
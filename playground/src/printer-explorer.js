@@ -26,6 +26,13 @@ async function explorePrinters() {
 
   console.log('\n📄 Test 5: Printer driverOptions');
   console.log(await printers.driverOptions(printerName));
+
+  console.log('\n📄 Test 6: Discover printers incrementally');
+  const started = Date.now();
+  const discovery = printers.discover({ timeout: 3000 });
+  for await (const printer of discovery) {
+    console.log(`+${Date.now() - started}ms`, printer.name, printer.state);
+  }
 }
 
 if (require.main === module) {
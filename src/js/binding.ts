@@ -1,76 +1,53 @@
-// Modern native binding loader for @ssxv/node-printer
+// Native binding loader for @ssxv/node-printer
 // Strategy:
-// 1. Try to require the locally-built addon: build/Release/node_printer.node
-// 2. If that fails, try `prebuild-install` to fetch a prebuilt binary
-// 3. If still not found, try to fallback to `node-gyp rebuild` (requires build toolchain)
-// 4. Export whatever native binding we obtain (or throw an informative error)
+// 1. Nothing is loaded at require time: the exported object resolves the addon
+//    on first property access, so importing the package costs no dlopen and no
+//    native initialization
+// 2. Only an already-built addon is loaded (build/Release, then build/Debug).
+//    Downloading prebuilt binaries or compiling is the install script's job
+//    (`prebuild-install || node-gyp rebuild`) and never happens at runtime
 
 import * as path from 'path';
 import * as fs from 'fs';
+import { PrinterError } from './errors';
 
-function tryRequireBuilt(): any {
-  const builtPath = path.join(__dirname, '..', '..', 'build', 'Release', 'node_printer.node');
-  if (fs.existsSync(builtPath)) {
-    return require(builtPath);
-  }
-  return null;
-}
+const CANDIDATES = ['Release', 'Debug'].map(config =>
+  path.join(__dirname, '..', '..', 'build', config, 'node_printer.node')
+);
 
-function tryPrebuildInstall(): any {
-  try {
-    // prebuild-install will attempt to download a matching prebuilt binary into the package
-    // and then we can require the same path as above.
-    const prebuildInstall = require('prebuild-install');
-    // Call prebuild-install programmatically
-    // Note: this call exits the process on failure when run as CLI; here we use programmatic API.
-    prebuildInstall.prebuild({ module_name: 'node_printer', module_path: './build/Release' });
-    const built = tryRequireBuilt();
-    if (built) return built;
-  } catch (e) {
-    // ignore and fallback
-  }
-  return null;
-}
+let native: any;
 
-function tryNodeGypRebuild(): any {
-  try {
-    // Attempt an in-process rebuild via node-gyp. This is best-effort and requires a native toolchain.
-    // Use child_process.spawnSync to run `node-gyp rebuild`.
-    const child = require('child_process');
-    const res = child.spawnSync(
-      process.execPath,
-      [require.resolve('node-gyp/bin/node-gyp'), 'rebuild', '--target=node_printer'],
-      {
-        stdio: 'inherit',
-        cwd: path.join(__dirname, '..', '..')
+function loadBinding(): any {
+  if (native) return native;
+
+  for (const candidate of CANDIDATES) {
+    if (fs.existsSync(candidate)) {
+      try {
+        native = require(candidate);
+        return native;
+      } catch (error) {
+        throw new PrinterError(`Failed to load native printer binding from ${candidate}`, 'DRIVER_ERROR', error);
       }
-    );
-    if (res.status === 0) {
-      return tryRequireBuilt();
     }
-  } catch (e) {
-    // ignore
   }
-  return null;
-}
 
-function loadBinding(): any {
-  // 1. local build
-  let binding = tryRequireBuilt();
-  if (binding) return binding;
-
-  // 2. prebuild-install
-  binding = tryPrebuildInstall();
-  if (binding) return binding;
-
-  // 3. node-gyp rebuild
-  binding = tryNodeGypRebuild();
-  if (binding) return binding;
-
-  // 4. cannot load
-  throw new Error(
-    'Failed to load modern node_printer binding. Tried build/Release/node_printer.node, prebuild-install, and node-gyp rebuild. Ensure native build succeeded or install prebuilt binaries.'
+  throw new PrinterError(
+    'Native printer binding not found (build/Release/node_printer.node). Reinstall the package or run `npm run build`; it is never built or downloaded at runtime.',
+    'DRIVER_ERROR'
   );
 }
 
-export = loadBinding();
+// Property reads load the addon; `binding.getPrinters(...)` behaves exactly as before
+const binding: any = new Proxy(
+  {},
+  {
+    get(_target, name) {
+      return loadBinding()[name];
+    },
+    has(_target, name) {
+      return name in loadBinding();
+    }
+  }
+);
+
+export = binding;
@@ -0,0 +1,104 @@
+// Runtime configuration of the native layer
+
+import { NativeConfig, RateLimit } from './types';
+import { PrinterError } from './errors';
+
+// Dynamic binding loader - will be replaced with proper loader
+let binding: any;
+try {
+  binding = require('./binding');
+} catch (error) {
+  throw new PrinterError('Failed to load native printer binding', 'DRIVER_ERROR', error);
+}
+
+function positiveInteger(value: any): number | undefined {
+  return typeof value === 'number' && value > 0 ? Math.floor(value) : undefined;
+}
+
+function positiveNumber(value: any): number | undefined {
+  return typeof value === 'number' && value > 0 ? value : undefined;
+}
+
+function nonNegativeNumber(value: any): number | undefined {
+  return typeof value === 'number' && value >= 0 ? value : undefined;
+}
+
+function rateLimit(limit: RateLimit | undefined): RateLimit | undefined {
+  if (!limit) return undefined;
+  return {
+    jobsPerSecond: positiveNumber(limit.jobsPerSecond),
+    bytesPerSecond: positiveNumber(limit.bytesPerSecond),
+    burstJobs: positiveNumber(limit.burstJobs),
+    burstBytes: positiveNumber(limit.burstBytes)
+  };
+}
+
+function rateLimitMap(limits: Record<string, RateLimit> | undefined): Record<string, RateLimit> {
+  const result: Record<string, RateLimit> = {};
+  for (const [name, limit] of Object.entries(limits || {})) {
+    result[name] = rateLimit(limit) as RateLimit;
+  }
+  return result;
+}
+
+/**
+ * Tune native behaviour; settings apply process-wide
+ */
+export function configure(config: NativeConfig): void {
+  try {
+    if (config.connectionPool) {
+      const pool = config.connectionPool;
+      binding.configureConnectionPool({
+        maxPerServer: positiveInteger(pool.maxPerServer),
+        idleTimeoutMs: positiveInteger(pool.idleTimeoutMs),
+        connectTimeoutMs: positiveInteger(pool.connectTimeoutMs),
+        connectAttempts: positiveInteger(pool.connectAttempts),
+        maxBackoffMs: positiveInteger(pool.maxBackoffMs)
+      });
+    }
+
+    if (config.submissionQueue) {
+      const queue = config.submissionQueue;
+      binding.configureSubmissionQueue({
+        maxInFlight: positiveInteger(queue.maxInFlight),
+        maxQueuedBytes: positiveInteger(queue.maxQueuedBytes),
+        maxQueuedJobs: positiveInteger(queue.maxQueuedJobs),
+        workers: positiveInteger(queue.workers),
+        adaptive: typeof queue.adaptive === 'boolean' ? queue.adaptive : undefined,
+        initialInFlight: positiveInteger(queue.initialInFlight),
+        latencyTolerance: positiveNumber(queue.latencyTolerance)
+      });
+    }
+
+    if (config.rateLimits) {
+      const limits = config.rateLimits;
+      binding.configureRateLimits({
+        printer: rateLimit(limits.printer),
+        server: rateLimit(limits.server),
+        printers: rateLimitMap(limits.printers),
+        servers: rateLimitMap(limits.servers)
+      });
+    }
+
+    if (config.retry) {
+      const retry = config.retry;
+      binding.configureRetry({
+        maxAttempts: positiveInteger(retry.maxAttempts),
+        initialDelayMs: nonNegativeNumber(retry.initialDelayMs),
+        maxDelayMs: nonNegativeNumber(retry.maxDelayMs),
+        multiplier: positiveNumber(retry.multiplier),
+        jitter: nonNegativeNumber(retry.jitter),
+        retryableStatuses: Array.isArray(retry.retryableStatuses)
+          ? retry.retryableStatuses.filter(status => Number.isInteger(status))
+          : undefined
+      });
+    }
+
+    if (config.ledger) {
+      const path = config.ledger.path;
+      binding.configureLedger({ path: typeof path === 'string' && path ? path : undefined });
+    }
+  } catch (error) {
+    throw PrinterError.fromNativeError(error);
+  }
+}
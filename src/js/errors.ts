@@ -10,17 +10,37 @@ export type PrinterErrorCode =
   | 'INVALID_ARGUMENTS'
   | 'FILE_NOT_FOUND'
   | 'UNSUPPORTED_FORMAT'
+  | 'QUEUE_FULL'
+  | 'UNSUPPORTED_OPERATION'
   | 'UNKNOWN';
 
+const PRINTER_ERROR_CODES: readonly string[] = [
+  'PRINTER_NOT_FOUND',
+  'PRINTER_OFFLINE',
+  'ACCESS_DENIED',
+  'JOB_NOT_FOUND',
+  'DRIVER_ERROR',
+  'INVALID_ARGUMENTS',
+  'FILE_NOT_FOUND',
+  'UNSUPPORTED_FORMAT',
+  'QUEUE_FULL',
+  'UNSUPPORTED_OPERATION'
+];
+
 export class PrinterError extends Error {
   public readonly code: PrinterErrorCode;
   public readonly originalError?: any;
+  /** Status reported by the OS (Win32 error or IPP status), when there was one */
+  public readonly platformCode?: number;
 
   constructor(message: string, code: PrinterErrorCode = 'UNKNOWN', originalError?: any) {
     super(message);
     this.name = 'PrinterError';
     this.code = code;
     this.originalError = originalError;
+    if (typeof originalError?.platformCode === 'number') {
+      this.platformCode = originalError.platformCode;
+    }
 
     // Maintains proper stack trace for where error was thrown (only on V8)
     if (Error.captureStackTrace) {
@@ -33,9 +53,15 @@ export class PrinterError extends Error {
       return nativeError;
     }
 
-    // Map common native error messages/codes to PrinterErrorCode
     const message = nativeError?.message || String(nativeError);
 
+    // Native errors arrive classified from the platform status; trust that first
+    if (PRINTER_ERROR_CODES.includes(nativeError?.code)) {
+      return new PrinterError(message, nativeError.code, nativeError);
+    }
+
+    // Fall back to matching common messages
+
     if (message.includes('printer') && message.includes('not found')) {
       return new PrinterError(message, 'PRINTER_NOT_FOUND', nativeError);
     }
@@ -56,6 +82,10 @@ export class PrinterError extends Error {
       return new PrinterError(message, 'DRIVER_ERROR', nativeError);
     }
 
+    if (message.includes('queue') && message.includes('is full')) {
+      return new PrinterError(message, 'QUEUE_FULL', nativeError);
+    }
+
     if (message.includes('file') && message.includes('not found')) {
       return new PrinterError(message, 'FILE_NOT_FOUND', nativeError);
     }
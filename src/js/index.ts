@@ -3,25 +3,82 @@
 import { printers } from './printers';
 import { jobs } from './jobs';
 import { PrinterError } from './errors';
+import { metrics } from './metrics';
+import { configure } from './config';
+import { templates } from './templates';
+import { ledger } from './ledger';
+import { PrinterStateTable } from './state-table';
 
 // Named exports
-export { printers, jobs, PrinterError };
+export { printers, jobs, templates, ledger, metrics, configure, PrinterError, PrinterStateTable };
 
 // Re-export types for convenience
 export type {
   Printer,
   PrinterCapabilities,
   PrintJob,
+  ListJobsOptions,
+  IterateJobsOptions,
+  ListAllJobsOptions,
+  PrinterJobs,
+  WhichJobs,
+  JobRef,
+  JobLookupResult,
+  JobCommandResult,
+  PurgeOptions,
+  HoldUntil,
+  JobUpdateOptions,
+  DocumentFormatOption,
+  DetectedFormat,
   PrintFileOptions,
   PrintRawOptions,
+  CodePage,
+  TextEncoding,
+  PrintDocumentsOptions,
+  PoolSubmitOptions,
+  PoolStrategy,
+  QueuedPrintOptions,
+  RasterPage,
+  PrintRasterOptions,
+  RasterProcessing,
+  PrintTemplate,
+  TemplateRecord,
+  PrintTemplateOptions,
   PrintOptions,
   PrintJobResult,
-  PrinterDriverOptions
+  PrinterDriverOptions,
+  DiscoveryOptions,
+  PrinterDiscovery,
+  StateTableOptions,
+  PrinterStateEntry,
+  NativeConfig,
+  ConnectionPoolOptions,
+  SubmissionQueueOptions,
+  RateLimit,
+  RateLimitOptions,
+  RetryOptions,
+  LedgerOptions,
+  LedgerQuery,
+  LedgerEntry,
+  NativeMetrics,
+  BackendMetrics,
+  ConnectionPoolMetrics,
+  PrinterLoadMetrics,
+  SubmissionQueueMetrics,
+  RateLimitMetrics,
+  RetryMetrics,
+  LedgerMetrics,
+  StateTableMetrics,
+  TemplateBufferMetrics
 } from './types';
 
 // Default export - modern API only
 export default {
   printers,
   jobs,
+  templates,
+  ledger,
+  metrics,
+  configure,
   PrinterError
 };
@@ -1,6 +1,29 @@
 // Abstracts away OS-specific job management (Winspool/CUPS)
 
-import { PrintJob, PrintFileOptions, PrintRawOptions, PrintJobResult } from './types';
+import {
+  PrintJob,
+  PrintFileOptions,
+  PrintRawOptions,
+  PrintDocumentsOptions,
+  PrintJobResult,
+  JobRef,
+  JobLookupResult,
+  JobCommandResult,
+  PurgeOptions,
+  HoldUntil,
+  JobUpdateOptions,
+  PoolSubmitOptions,
+  QueuedPrintOptions,
+  PrintRasterOptions,
+  PrintTemplateOptions,
+  DocumentFormatOption,
+  DetectedFormat,
+  TextEncoding,
+  ListJobsOptions,
+  IterateJobsOptions,
+  ListAllJobsOptions,
+  PrinterJobs
+} from './types';
 import { PrinterError } from './errors';
 
 // Dynamic binding loader - will be replaced with proper loader
@@ -25,7 +48,8 @@ function normalizeJobState(rawState: any): PrintJob['state'] {
   if (state.includes('CANCELLED') || state.includes('CANCELED')) return 'canceled';
   if (state.includes('PAUSED')) return 'paused';
   if (state.includes('PENDING') || state.includes('WAITING')) return 'pending';
-  if (state.includes('ERROR') || state.includes('ABORTED')) return 'error';
+  if (state.includes('ABORTED')) return 'aborted';
+  if (state.includes('ERROR')) return 'error';
 
   return 'pending'; // Default to pending for unknown states
 }
@@ -48,6 +72,134 @@ function normalizeJobStatus(raw: any): PrintJob {
   };
 }
 
+function toDate(seconds: number | undefined): Date | undefined {
+  return seconds ? new Date(seconds * 1000) : undefined;
+}
+
+/**
+ * PrintJob view over one job of a native snapshot (jobs.list({ lazy: true }))
+ * Nothing is converted up front; each getter reads its field from the snapshot.
+ * JSON.stringify and toJSON() give a plain PrintJob.
+ */
+class LazyPrintJob implements PrintJob {
+  constructor(
+    private readonly snapshot: any,
+    private readonly index: number
+  ) {}
+
+  get id(): number {
+    return this.snapshot.id(this.index);
+  }
+
+  get state(): PrintJob['state'] {
+    return normalizeJobState(this.snapshot.state(this.index));
+  }
+
+  get printer(): string | undefined {
+    return this.snapshot.printer(this.index);
+  }
+
+  get title(): string | undefined {
+    return this.snapshot.title(this.index);
+  }
+
+  get user(): string | undefined {
+    return this.snapshot.user(this.index);
+  }
+
+  get creationTime(): Date | undefined {
+    return toDate(this.snapshot.creationTime(this.index));
+  }
+
+  get processingTime(): Date | undefined {
+    return toDate(this.snapshot.processingTime(this.index));
+  }
+
+  get completedTime(): Date | undefined {
+    return toDate(this.snapshot.completedTime(this.index));
+  }
+
+  get pages(): number | undefined {
+    return this.snapshot.pages(this.index);
+  }
+
+  get size(): number | undefined {
+    return this.snapshot.size(this.index);
+  }
+
+  toJSON(): PrintJob {
+    return normalizeJobStatus(this.snapshot.toObject(this.index));
+  }
+}
+
+/**
+ * Normalize per-job command results from cancelJobs/purgeJobs
+ */
+function normalizeCommandResults(rawResults: any[]): JobCommandResult[] {
+  return rawResults.map(raw => {
+    if (raw.ok) {
+      return { id: raw.id, ok: true };
+    }
+    return {
+      id: raw.id,
+      ok: false,
+      error: new PrinterError(raw.error?.message || 'Job command failed', raw.error?.code || 'UNKNOWN')
+    };
+  });
+}
+
+/**
+ * Map a public format option to the native format name
+ */
+function nativeFormat(format: DocumentFormatOption | undefined): string {
+  return format === 'detect' ? 'DETECT' : format || 'RAW';
+}
+
+const HOLD_KEYWORDS = ['no-hold', 'indefinite', 'day-time', 'evening', 'night', 'second-shift', 'third-shift', 'weekend'];
+const HOLD_WINDOW_MS = 24 * 60 * 60 * 1000;
+
+/**
+ * Validate job priority (1-100)
+ */
+function normalizePriority(priority: any): number {
+  if (typeof priority !== 'number' || !Number.isInteger(priority) || priority < 1 || priority > 100) {
+    throw new PrinterError('priority must be an integer between 1 and 100', 'INVALID_ARGUMENTS');
+  }
+  return priority;
+}
+
+/**
+ * Convert holdUntil to a job-hold-until value (keyword or UTC "HH:MM:SS")
+ */
+function normalizeHoldUntil(holdUntil: HoldUntil): string {
+  if (holdUntil instanceof Date) {
+    if (isNaN(holdUntil.getTime())) {
+      throw new PrinterError('holdUntil is an invalid Date', 'INVALID_ARGUMENTS');
+    }
+    // job-hold-until only carries a time of day: a later Date would be released early, and
+    // cupsd reads a time that has passed as tomorrow's, holding the job for a day
+    const delay = holdUntil.getTime() - Date.now();
+    if (delay <= 0) {
+      throw new PrinterError('holdUntil Date is in the past', 'INVALID_ARGUMENTS');
+    }
+    if (delay > HOLD_WINDOW_MS) {
+      throw new PrinterError('holdUntil Date must be within the next 24 hours', 'INVALID_ARGUMENTS');
+    }
+    // Round up to the whole second, so a Date later this second is not truncated into the past
+    return new Date(Math.ceil(holdUntil.getTime() / 1000) * 1000).toISOString().substring(11, 19);
+  }
+
+  if (typeof holdUntil === 'string') {
+    if (HOLD_KEYWORDS.includes(holdUntil)) return holdUntil;
+    if (/^([01]\d|2[0-3]):[0-5]\d(:[0-5]\d)?$/.test(holdUntil)) return holdUntil;
+  }
+
+  throw new PrinterError(
+    `holdUntil must be a Date, 'HH:MM[:SS]' (UTC) or one of: ${HOLD_KEYWORDS.join(', ')}`,
+    'INVALID_ARGUMENTS'
+  );
+}
+
 /**
  * Validate print options and convert to native format
  */
@@ -78,9 +230,46 @@ function validateAndNormalizePrintOptions(options: any = {}): any {
     normalized.docname = options.jobName;
   }
 
+  if (options.priority !== undefined) {
+    normalized.priority = normalizePriority(options.priority);
+  }
+
+  if (options.holdUntil !== undefined) {
+    normalized.holdUntil = normalizeHoldUntil(options.holdUntil);
+  }
+
+  if (options.tags && typeof options.tags === 'object') {
+    normalized.tags = {};
+    for (const [key, value] of Object.entries(options.tags)) {
+      if (typeof value === 'string') normalized.tags[key] = value;
+    }
+  }
+
   return normalized;
 }
 
+/**
+ * Submit to the first healthy printer of an ordered list (native health cache decides)
+ */
+async function printWithFailover(
+  printers: string[],
+  source: Buffer | string,
+  format: string,
+  options: any
+): Promise<PrintJobResult> {
+  if (!printers.every(printer => typeof printer === 'string' && printer)) {
+    throw new PrinterError('Fallback printer names must be non-empty strings', 'INVALID_ARGUMENTS');
+  }
+
+  const result = await binding.printWithFailover(printers, source, format, options);
+
+  if (!result || !result.id || result.id <= 0) {
+    throw new PrinterError('Failed to queue print job', 'UNKNOWN');
+  }
+
+  return { id: result.id, printer: result.printer, skipped: result.skipped, throttledMs: result.throttledMs };
+}
+
 export const jobs = {
   /**
    * Print a file
@@ -93,13 +282,27 @@ export const jobs = {
 
       const normalizedOptions = validateAndNormalizePrintOptions(options.options);
 
-      const jobId = await binding.printFile(options.file, options.printer, normalizedOptions);
+      if (options.fallbacks?.length) {
+        return await printWithFailover(
+          [options.printer, ...options.fallbacks],
+          options.file,
+          nativeFormat(options.format),
+          normalizedOptions
+        );
+      }
+
+      const result = await binding.printFile(
+        options.file,
+        options.printer,
+        normalizedOptions,
+        nativeFormat(options.format)
+      );
 
-      if (!jobId || jobId <= 0) {
+      if (!result || !result.id || result.id <= 0) {
         throw new PrinterError('Failed to queue print job', 'UNKNOWN');
       }
 
-      return { id: jobId, printer: options.printer };
+      return { id: result.id, printer: options.printer, throttledMs: result.throttledMs };
     } catch (error) {
       throw PrinterError.fromNativeError(error);
     }
@@ -114,24 +317,278 @@ export const jobs = {
         throw new PrinterError('Printer name and data are required', 'INVALID_ARGUMENTS');
       }
 
-      if (!Buffer.isBuffer(options.data)) {
-        throw new PrinterError('Data must be a Buffer', 'INVALID_ARGUMENTS');
+      if (!Buffer.isBuffer(options.data) && typeof options.data !== 'string') {
+        throw new PrinterError('Data must be a Buffer or a string', 'INVALID_ARGUMENTS');
+      }
+
+      if (options.encoding && typeof options.data !== 'string') {
+        throw new PrinterError('encoding applies to string data only', 'INVALID_ARGUMENTS');
       }
 
       const normalizedOptions = validateAndNormalizePrintOptions(options.options);
 
-      const jobId = await binding.printDirect(
+      if (options.fallbacks?.length) {
+        // Failover takes bytes; a string would be read as a file path
+        const data =
+          typeof options.data === 'string'
+            ? options.encoding
+              ? binding.transcode(options.data, options.encoding)
+              : Buffer.from(options.data)
+            : options.data;
+
+        return await printWithFailover(
+          [options.printer, ...options.fallbacks],
+          data,
+          nativeFormat(options.format),
+          normalizedOptions
+        );
+      }
+
+      const result = await binding.printDirect(
         options.data,
         options.printer,
-        options.format || 'RAW',
+        nativeFormat(options.format),
+        normalizedOptions,
+        options.encoding
+      );
+
+      if (!result || !result.id || result.id <= 0) {
+        throw new PrinterError('Failed to queue print job', 'UNKNOWN');
+      }
+
+      return { id: result.id, printer: options.printer, throttledMs: result.throttledMs };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Print many documents as one job
+   * The job is created once and every document is streamed into it (no temp files), so
+   * per-job scheduling, banner and filter startup costs are paid once for the whole batch
+   */
+  async printDocuments(options: PrintDocumentsOptions): Promise<PrintJobResult> {
+    try {
+      if (!options?.printer || !Array.isArray(options.documents) || options.documents.length === 0) {
+        throw new PrinterError('Printer name and a non-empty documents array are required', 'INVALID_ARGUMENTS');
+      }
+
+      for (const document of options.documents) {
+        if (!Buffer.isBuffer(document) && (typeof document !== 'string' || !document)) {
+          throw new PrinterError('Each document must be a file path or a Buffer', 'INVALID_ARGUMENTS');
+        }
+      }
+
+      const normalizedOptions = validateAndNormalizePrintOptions(options.options);
+
+      const result = await binding.printDocuments(
+        options.printer,
+        options.documents,
+        nativeFormat(options.format),
+        normalizedOptions
+      );
+
+      if (!result || !result.id || result.id <= 0) {
+        throw new PrinterError('Failed to queue print job', 'UNKNOWN');
+      }
+
+      return { id: result.id, printer: options.printer, throttledMs: result.throttledMs };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Convert text to a printer code page natively
+   * The returned Buffer wraps pooled native memory; no copy is made on the way to JavaScript
+   */
+  transcode(text: string, encoding: TextEncoding): Buffer {
+    try {
+      if (typeof text !== 'string' || !encoding?.codePage) {
+        throw new PrinterError('Text and encoding.codePage are required', 'INVALID_ARGUMENTS');
+      }
+
+      return binding.transcode(text, encoding);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Recognize a document's format from its first bytes, as format: 'detect' does
+   */
+  detectFormat(data: Buffer): DetectedFormat {
+    try {
+      if (!Buffer.isBuffer(data)) {
+        throw new PrinterError('Data must be a Buffer', 'INVALID_ARGUMENTS');
+      }
+
+      return binding.detectFormat(data);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Print bitmaps as PWG Raster or Apple URF
+   * Pages are encoded natively and submitted as image/pwg-raster or image/urf, which IPP Everywhere
+   * and AirPrint printers take without any cupsd filtering
+   */
+  async printRaster(options: PrintRasterOptions): Promise<PrintJobResult> {
+    try {
+      if (!options?.printer || !Array.isArray(options.pages) || options.pages.length === 0) {
+        throw new PrinterError('Printer name and a non-empty pages array are required', 'INVALID_ARGUMENTS');
+      }
+
+      for (const page of options.pages) {
+        if (!page || !Buffer.isBuffer(page.data)) {
+          throw new PrinterError('Each raster page needs a data Buffer', 'INVALID_ARGUMENTS');
+        }
+      }
+
+      const [xResolution, yResolution] = Array.isArray(options.resolution)
+        ? options.resolution
+        : [options.resolution || 300, options.resolution || 300];
+
+      const normalizedOptions = validateAndNormalizePrintOptions(options.options);
+
+      const result = await binding.printRaster(
+        options.printer,
+        options.pages.map(page => ({ width: page.width, height: page.height, bpp: page.bpp || 8, data: page.data })),
+        {
+          format: options.format || 'pwg',
+          resolution: xResolution,
+          yResolution,
+          mediaName: options.mediaName,
+          process: options.process
+        },
+        normalizedOptions
+      );
+
+      if (!result || !result.id || result.id <= 0) {
+        throw new PrinterError('Failed to queue print job', 'UNKNOWN');
+      }
+
+      return { id: result.id, printer: options.printer, throttledMs: result.throttledMs };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Render records with a compiled template and print them as one raw job
+   * Rendering happens natively into a pooled buffer that is handed straight to the raw print path
+   */
+  async printTemplate(options: PrintTemplateOptions): Promise<PrintJobResult> {
+    try {
+      if (!options?.printer || !options.template) {
+        throw new PrinterError('Printer name and template are required', 'INVALID_ARGUMENTS');
+      }
+
+      if (!Array.isArray(options.records) || options.records.length === 0) {
+        throw new PrinterError('A non-empty records array is required', 'INVALID_ARGUMENTS');
+      }
+
+      const normalizedOptions = validateAndNormalizePrintOptions(options.options);
+
+      const result = await binding.printTemplate(
+        options.printer,
+        options.template.id,
+        options.records,
+        options.separator,
+        nativeFormat(options.format),
         normalizedOptions
       );
 
-      if (!jobId || jobId <= 0) {
+      if (!result || !result.id || result.id <= 0) {
         throw new PrinterError('Failed to queue print job', 'UNKNOWN');
       }
 
-      return { id: jobId, printer: options.printer };
+      return { id: result.id, printer: options.printer, throttledMs: result.throttledMs };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Print to whichever printer of a pool is least loaded
+   * The native scheduler tracks queue depth and bytes per printer and picks the target at submit time
+   */
+  async submitToPool(options: PoolSubmitOptions): Promise<PrintJobResult> {
+    try {
+      if (!Array.isArray(options?.printers) || options.printers.length === 0) {
+        throw new PrinterError('A non-empty printers array is required', 'INVALID_ARGUMENTS');
+      }
+
+      if (!options.data === !options.file) {
+        throw new PrinterError('Exactly one of data or file is required', 'INVALID_ARGUMENTS');
+      }
+
+      if (options.data && !Buffer.isBuffer(options.data)) {
+        throw new PrinterError('Data must be a Buffer', 'INVALID_ARGUMENTS');
+      }
+
+      const normalizedOptions = validateAndNormalizePrintOptions(options.options);
+
+      const result = await binding.submitToPool(
+        options.printers,
+        options.data || options.file,
+        nativeFormat(options.format),
+        normalizedOptions,
+        options.strategy || 'least-queued'
+      );
+
+      if (!result || !result.id || result.id <= 0) {
+        throw new PrinterError('Failed to queue print job', 'UNKNOWN');
+      }
+
+      return { id: result.id, printer: result.printer, throttledMs: result.throttledMs };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Queue a job in the native per-printer submission queue
+   * Returns at once with a promise for the job; rejects with QUEUE_FULL when the printer's
+   * queue is at its job or byte limit (see configure({ submissionQueue }))
+   */
+  enqueue(options: QueuedPrintOptions): Promise<PrintJobResult> {
+    try {
+      if (!options?.printer) {
+        throw new PrinterError('Printer name is required', 'INVALID_ARGUMENTS');
+      }
+
+      if (!options.data === !options.file) {
+        throw new PrinterError('Exactly one of data or file is required', 'INVALID_ARGUMENTS');
+      }
+
+      if (options.data && !Buffer.isBuffer(options.data)) {
+        throw new PrinterError('Data must be a Buffer', 'INVALID_ARGUMENTS');
+      }
+
+      const normalizedOptions = validateAndNormalizePrintOptions(options.options);
+
+      return binding
+        .enqueueJob(options.printer, options.data || options.file, nativeFormat(options.format), normalizedOptions)
+        .catch((error: any) => {
+          throw PrinterError.fromNativeError(error);
+        });
+    } catch (error) {
+      return Promise.reject(PrinterError.fromNativeError(error));
+    }
+  },
+
+  /**
+   * Resolves once the printer's submission queue can take another job
+   */
+  async ready(printer: string): Promise<void> {
+    try {
+      if (!printer) {
+        throw new PrinterError('Printer name is required', 'INVALID_ARGUMENTS');
+      }
+
+      await binding.queueReady(printer);
     } catch (error) {
       throw PrinterError.fromNativeError(error);
     }
@@ -153,40 +610,128 @@ export const jobs = {
     }
   },
 
+  /**
+   * Get status of many jobs in one call
+   * Lookups run in parallel on pooled connections; results keep the input order
+   */
+  async getMany(refs: JobRef[]): Promise<JobLookupResult[]> {
+    try {
+      if (!Array.isArray(refs)) {
+        throw new PrinterError('An array of { printer, id } is required', 'INVALID_ARGUMENTS');
+      }
+
+      const rawResults: any[] = await binding.getJobsBatch(refs);
+
+      return rawResults.map(raw => {
+        if (raw.job) {
+          return { printer: raw.printer, id: raw.id, job: normalizeJobStatus(raw.job) };
+        }
+        return {
+          printer: raw.printer,
+          id: raw.id,
+          error: new PrinterError(raw.error?.message || 'Job lookup failed', raw.error?.code || 'UNKNOWN')
+        };
+      });
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
   /**
    * List jobs for a specific printer or all printers
+   * With `lazy`, jobs are views over a native snapshot and each field is converted on first read
    */
-  async list(options?: { printer?: string }): Promise<PrintJob[]> {
+  async list(options?: ListJobsOptions): Promise<PrintJob[]> {
     try {
-      let rawJobs: any[];
+      const lazy = options?.lazy === true;
+      let listings: any[];
 
       if (options?.printer) {
         // Get jobs for specific printer using dedicated getJobs method
-        rawJobs = await binding.getJobs(options.printer);
+        listings = [await (lazy ? binding.getJobsSnapshot(options.printer) : binding.getJobs(options.printer))];
       } else {
-        // Get jobs for all printers
-        const printers = await binding.getPrinters();
-        const allJobs: any[] = [];
-
-        // Get jobs for each printer individually
-        for (const printer of printers) {
-          try {
-            const printerJobs = await binding.getJobs(printer.name || printer.printer);
-            allJobs.push(...printerJobs);
-          } catch (error) {
+        // Every printer's jobs in one native call
+        const groups: any[] = await binding.getAllJobs({ lazy });
+        listings = [];
+        for (const group of groups) {
+          if (group.error) {
             // Continue with other printers if one fails
-            console.warn(`Failed to get jobs for printer ${printer.name || printer.printer}:`, error);
+            console.warn(`Failed to get jobs for printer ${group.printer}:`, group.error.message);
           }
+          listings.push(group.jobs);
         }
-        rawJobs = allJobs;
       }
 
-      return rawJobs.map(normalizeJobStatus);
+      const jobs: PrintJob[] = [];
+      for (const listing of listings) {
+        if (lazy) {
+          for (let i = 0; i < listing.length; i++) {
+            jobs.push(new LazyPrintJob(listing, i));
+          }
+        } else {
+          for (const rawJob of listing) {
+            jobs.push(normalizeJobStatus(rawJob));
+          }
+        }
+      }
+      return jobs;
     } catch (error) {
       throw PrinterError.fromNativeError(error);
     }
   },
 
+  /**
+   * Every printer's jobs, grouped by printer
+   * One IPP Get-Jobs on CUPS; on Windows the queues are enumerated in parallel.
+   * Printers without matching jobs are left out.
+   */
+  async listAll(options: ListAllJobsOptions = {}): Promise<PrinterJobs[]> {
+    try {
+      const groups: any[] = await binding.getAllJobs({
+        which: options.which,
+        limit: options.limit && options.limit > 0 ? Math.floor(options.limit) : undefined
+      });
+
+      return groups.map(group => {
+        const result: PrinterJobs = { printer: group.printer, jobs: group.jobs.map(normalizeJobStatus) };
+        if (group.error) {
+          result.error = new PrinterError(group.error.message || 'Job listing failed', group.error.code || 'UNKNOWN');
+        }
+        return result;
+      });
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Walk a job listing page by page, oldest first
+   * Each page is one Get-Jobs round-trip (first-job-id/limit on CUPS), fetched
+   * when the previous one is used up, so memory stays bounded by pageSize.
+   */
+  async *iterate(options?: IterateJobsOptions): AsyncGenerator<PrintJob, void, undefined> {
+    const pageSize = options?.pageSize && options.pageSize > 0 ? Math.floor(options.pageSize) : 500;
+    let cursor = 0;
+
+    do {
+      let page: { jobs: any[]; nextCursor: number };
+      try {
+        page = await binding.getJobsPage(options?.printer || '', {
+          which: options?.which,
+          cursor,
+          limit: pageSize
+        });
+      } catch (error) {
+        throw PrinterError.fromNativeError(error);
+      }
+
+      for (const rawJob of page.jobs) {
+        yield normalizeJobStatus(rawJob);
+      }
+      cursor = page.nextCursor;
+    } while (cursor > 0);
+  },
+
   /**
    * Cancel a specific job
    */
@@ -202,6 +747,102 @@ export const jobs = {
     }
   },
 
+  /**
+   * Cancel many jobs on one printer
+   * Uses a single Cancel-Jobs request per batch on CUPS; results keep the input order
+   */
+  async cancelMany(printer: string, jobIds: number[]): Promise<JobCommandResult[]> {
+    try {
+      if (!printer || !Array.isArray(jobIds)) {
+        throw new PrinterError('Printer name and an array of job IDs are required', 'INVALID_ARGUMENTS');
+      }
+
+      const rawResults: any[] = await binding.cancelJobs(printer, jobIds);
+      return normalizeCommandResults(rawResults);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Cancel every active job on a printer, optionally clearing finished jobs too
+   */
+  async purge(printer: string, options: PurgeOptions = {}): Promise<JobCommandResult[]> {
+    try {
+      if (!printer) {
+        throw new PrinterError('Printer name is required', 'INVALID_ARGUMENTS');
+      }
+
+      if (options.which && options.which !== 'active' && options.which !== 'all') {
+        throw new PrinterError("which must be 'active' or 'all'", 'INVALID_ARGUMENTS');
+      }
+
+      const rawResults: any[] = await binding.purgeJobs(printer, {
+        which: options.which || 'active',
+        user: options.user
+      });
+      return normalizeCommandResults(rawResults);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Hold a queued job; it keeps its place in the spool and prints after release()
+   */
+  async hold(printer: string, jobId: number): Promise<void> {
+    try {
+      if (!printer || jobId <= 0) {
+        throw new PrinterError('Valid printer name and job ID are required', 'INVALID_ARGUMENTS');
+      }
+
+      await binding.setJob(printer, jobId, 'pause');
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Release a held job
+   */
+  async release(printer: string, jobId: number): Promise<void> {
+    try {
+      if (!printer || jobId <= 0) {
+        throw new PrinterError('Valid printer name and job ID are required', 'INVALID_ARGUMENTS');
+      }
+
+      await binding.setJob(printer, jobId, 'resume');
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Change priority or hold time of a queued job without resubmitting it
+   */
+  async update(printer: string, jobId: number, update: JobUpdateOptions): Promise<void> {
+    try {
+      if (!printer || jobId <= 0) {
+        throw new PrinterError('Valid printer name and job ID are required', 'INVALID_ARGUMENTS');
+      }
+
+      const nativeUpdate: any = {};
+      if (update?.priority !== undefined) {
+        nativeUpdate.priority = normalizePriority(update.priority);
+      }
+      if (update?.holdUntil !== undefined) {
+        nativeUpdate.holdUntil = normalizeHoldUntil(update.holdUntil);
+      }
+      if (nativeUpdate.priority === undefined && nativeUpdate.holdUntil === undefined) {
+        throw new PrinterError('priority or holdUntil is required', 'INVALID_ARGUMENTS');
+      }
+
+      await binding.updateJob(printer, jobId, nativeUpdate);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
   /**
    * Set native job command (escape hatch for platform-specific operations)
    */
@@ -0,0 +1,48 @@
+// Local job ledger: submissions recorded natively, queried without the spooler
+
+import { LedgerEntry, LedgerQuery } from './types';
+import { PrinterError } from './errors';
+
+// Dynamic binding loader - will be replaced with proper loader
+let binding: any;
+try {
+  binding = require('./binding');
+} catch (error) {
+  throw new PrinterError('Failed to load native printer binding', 'DRIVER_ERROR', error);
+}
+
+function toMillis(value: Date | number | undefined): number | undefined {
+  if (value instanceof Date) return value.getTime();
+  return typeof value === 'number' ? value : undefined;
+}
+
+export const ledger = {
+  /**
+   * Recorded submissions matching every given filter, newest first
+   * Served from in-memory indexes; returns [] while no ledger is configured
+   */
+  query(query: LedgerQuery = {}): LedgerEntry[] {
+    try {
+      const rawEntries: any[] = binding.queryLedger({
+        printer: query.printer,
+        tags: query.tags,
+        state: query.state,
+        since: toMillis(query.since),
+        until: toMillis(query.until),
+        limit: query.limit && query.limit > 0 ? Math.floor(query.limit) : undefined
+      });
+
+      return rawEntries.map(raw => ({
+        id: raw.id,
+        printer: raw.printer,
+        tags: raw.tags,
+        bytes: raw.bytes,
+        submittedAt: new Date(raw.submittedAt),
+        finishedAt: raw.finishedAt ? new Date(raw.finishedAt) : undefined,
+        state: raw.state
+      }));
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  }
+};
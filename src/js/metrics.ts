@@ -0,0 +1,26 @@
+// Native runtime metrics (connection pool, schedulers, retries)
+
+import { NativeMetrics } from './types';
+import { PrinterError } from './errors';
+
+// Dynamic binding loader - will be replaced with proper loader
+let binding: any;
+try {
+  binding = require('./binding');
+} catch (error) {
+  throw new PrinterError('Failed to load native printer binding', 'DRIVER_ERROR', error);
+}
+
+export const metrics = {
+  /**
+   * Snapshot of native counters
+   * Sections that do not apply to the current platform are omitted
+   */
+  async get(): Promise<NativeMetrics> {
+    try {
+      return binding.getMetrics();
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  }
+};
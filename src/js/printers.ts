@@ -1,7 +1,15 @@
 // Abstracts away OS-specific concepts (Winspool/CUPS)
 
-import { Printer, PrinterCapabilities, PrinterDriverOptions } from './types';
+import {
+  Printer,
+  PrinterCapabilities,
+  PrinterDriverOptions,
+  DiscoveryOptions,
+  PrinterDiscovery,
+  StateTableOptions
+} from './types';
 import { PrinterError } from './errors';
+import { PrinterStateTable, stateTableBytes } from './state-table';
 
 // Dynamic binding loader - will be replaced with proper loader
 let binding: any;
@@ -45,6 +53,8 @@ function normalizePrinter(raw: any): Printer {
     name: raw.name || '',
     isDefault: Boolean(raw.isDefault),
     state: normalizePrinterState(raw.status),
+    stateReasons: Array.isArray(raw.stateReasons) ? raw.stateReasons : undefined,
+    acceptingJobs: typeof raw.acceptingJobs === 'boolean' ? raw.acceptingJobs : undefined,
     location: raw.location || undefined,
     description: raw.description || raw.comment || undefined
   };
@@ -69,6 +79,93 @@ function normalizeCapabilities(raw: any): PrinterCapabilities {
   };
 }
 
+/**
+ * Bridge native discovery callbacks to an async iterator
+ */
+function createDiscovery(options: DiscoveryOptions): PrinterDiscovery {
+  const found: Printer[] = [];
+  const buffered: Printer[] = [];
+  const waiting: ((result: IteratorResult<Printer>) => void)[] = [];
+  const failing: ((error: any) => void)[] = [];
+  let finished = false;
+  let failure: PrinterError | undefined;
+  let resolveDone!: (printers: Printer[]) => void;
+  let rejectDone!: (error: any) => void;
+
+  const done = new Promise<Printer[]>((resolve, reject) => {
+    resolveDone = resolve;
+    rejectDone = reject;
+  });
+  // Avoid unhandled rejections when callers only iterate
+  done.catch(() => undefined);
+
+  const finish = (error?: any) => {
+    if (finished) return;
+    finished = true;
+
+    if (error) {
+      failure = PrinterError.fromNativeError(error);
+      rejectDone(failure);
+      failing.splice(0).forEach(reject => reject(failure));
+      waiting.splice(0);
+    } else {
+      resolveDone(found);
+      waiting.splice(0).forEach(resolve => resolve({ value: undefined, done: true }));
+      failing.splice(0);
+    }
+  };
+
+  const handle = binding.discoverPrinters(
+    { timeout: options.timeout, type: options.type, mask: options.mask },
+    (error: any, raw: any) => {
+      if (error) return finish(error);
+      if (!raw) return finish();
+      if (finished) return;
+
+      const printer = normalizePrinter(raw);
+      found.push(printer);
+      options.onPrinter?.(printer);
+
+      const next = waiting.shift();
+      failing.shift();
+      if (next) {
+        next({ value: printer, done: false });
+      } else {
+        buffered.push(printer);
+      }
+    }
+  );
+
+  return {
+    done,
+    cancel() {
+      handle.cancel();
+      finish();
+    },
+    [Symbol.asyncIterator]() {
+      return {
+        next(): Promise<IteratorResult<Printer>> {
+          if (buffered.length > 0) {
+            return Promise.resolve({ value: buffered.shift() as Printer, done: false });
+          }
+          if (failure) return Promise.reject(failure);
+          if (finished) return Promise.resolve({ value: undefined, done: true });
+
+          return new Promise((resolve, reject) => {
+            waiting.push(resolve);
+            failing.push(reject);
+          });
+        },
+        return(): Promise<IteratorResult<Printer>> {
+          handle.cancel();
+          finish();
+          return Promise.resolve({ value: undefined, done: true });
+        }
+      };
+    }
+  };
+}
+
 export const printers = {
   /**
    * List all available printers
@@ -82,6 +179,18 @@ export const printers = {
     }
   },
 
+  /**
+   * Discover printers incrementally
+   * Yields each printer as soon as it is found instead of waiting for the full list
+   */
+  discover(options: DiscoveryOptions = {}): PrinterDiscovery {
+    try {
+      return createDiscovery(options);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
   /**
    * Get the default printer
    */
@@ -151,5 +260,54 @@ export const printers = {
     } catch (error) {
       throw PrinterError.fromNativeError(error);
     }
+  },
+
+  /**
+   * Load the addon, create the native backends and prime the printer health cache
+   * Optional - all of it otherwise happens on first use. Call without awaiting to
+   * warm up in the background. Resolves with the number of printers seen.
+   */
+  async warmup(): Promise<number> {
+    try {
+      return await binding.warmup();
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Start publishing printer state into a SharedArrayBuffer
+   * A native poller writes the table; pass `table.buffer` to workers (e.g. via
+   * workerData) and open it there with attachStateTable(). There is one poller
+   * per process: this replaces a table this thread is already publishing, and
+   * throws UNSUPPORTED_OPERATION while another thread's is running.
+   */
+  createStateTable(options: StateTableOptions = {}): PrinterStateTable {
+    const capacity = options.capacity && options.capacity > 0 ? Math.floor(options.capacity) : 256;
+    try {
+      const buffer = new SharedArrayBuffer(stateTableBytes(capacity));
+      binding.startStateMonitor(new Int32Array(buffer), {
+        intervalMs: options.intervalMs,
+        queueDepth: options.queueDepth
+      });
+      return new PrinterStateTable(buffer);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Read a table created by createStateTable(), typically in a worker thread
+   * Reads are plain shared-memory loads; no native calls are made.
+   */
+  attachStateTable(buffer: SharedArrayBuffer): PrinterStateTable {
+    return new PrinterStateTable(buffer);
+  },
+
+  /**
+   * Stop the poller this thread started; tables keep their last published state
+   */
+  stopStateTable(): void {
+    binding.stopStateMonitor();
   }
 };
@@ -0,0 +1,153 @@
+// Reader for the shared printer-state table published by the native poller
+
+import { PrinterStateEntry } from './types';
+import { PrinterError } from './errors';
+
+// Layout (in 32-bit words) - must match StateTableLayout in printer_state_table.h
+const MAGIC = 0x5453504e;
+const VERSION = 1;
+const HEADER_WORDS = 16;
+const H_MAGIC = 0;
+const H_VERSION = 1;
+const H_SEQUENCE = 2;
+const H_CAPACITY = 3;
+const H_COUNT = 4;
+const H_LAYOUT = 5;
+const H_POLLED_HI = 6;
+const H_POLLED_LO = 7;
+const NAME_BYTES = 128;
+const ROW_WORDS = 8 + NAME_BYTES / 4;
+const R_STATE = 0;
+const R_FLAGS = 1;
+const R_QUEUED = 2;
+const R_CHANGED = 3;
+const R_NAME_LENGTH = 4;
+const R_NAME = 8;
+
+const PRESENT = 1;
+const ACCEPTING = 2;
+const HEALTHY = 4;
+
+const STATES: PrinterStateEntry['state'][] = ['unknown', 'idle', 'printing', 'stopped', 'offline', 'error'];
+
+/**
+ * Bytes needed for a table with room for capacity printers
+ */
+export function stateTableBytes(capacity: number): number {
+  return (HEADER_WORDS + capacity * ROW_WORDS) * 4;
+}
+
+/**
+ * Read-only view over a state table
+ * Reads never call into the native addon, so any worker holding the buffer can
+ * use one; each read retries until it sees a consistent snapshot.
+ */
+export class PrinterStateTable {
+  private readonly words: Int32Array;
+  private readonly bytes: Uint8Array;
+  private layout = -1;
+  private indexes = new Map<string, number>();
+
+  constructor(readonly buffer: SharedArrayBuffer) {
+    if (!(buffer instanceof SharedArrayBuffer) || buffer.byteLength < stateTableBytes(1)) {
+      throw new PrinterError('Printer state table requires a SharedArrayBuffer', 'INVALID_ARGUMENTS');
+    }
+    this.words = new Int32Array(buffer);
+    this.bytes = new Uint8Array(buffer);
+    if (Atomics.load(this.words, H_MAGIC) !== MAGIC || Atomics.load(this.words, H_VERSION) !== VERSION) {
+      throw new PrinterError('Buffer is not an initialized printer state table', 'INVALID_ARGUMENTS');
+    }
+  }
+
+  /**
+   * Publish count; changes every time the poller writes the table
+   */
+  get sequence(): number {
+    return Atomics.load(this.words, H_SEQUENCE);
+  }
+
+  /**
+   * Time of the last completed poll, or undefined before the first one
+   */
+  get polledAt(): Date | undefined {
+    return this.read(() => {
+      const ms = this.words[H_POLLED_HI] * 0x100000000 + (this.words[H_POLLED_LO] >>> 0);
+      return ms > 0 ? new Date(ms) : undefined;
+    });
+  }
+
+  /**
+   * State of one printer, or undefined if the poller has never seen it
+   */
+  get(name: string): PrinterStateEntry | undefined {
+    return this.read(() => {
+      this.refreshIndexes();
+      const index = this.indexes.get(name);
+      return index === undefined ? undefined : this.row(index);
+    });
+  }
+
+  /**
+   * Every printer the poller has seen, including ones no longer listed (present: false)
+   */
+  list(): PrinterStateEntry[] {
+    return this.read(() => {
+      this.refreshIndexes();
+      const entries: PrinterStateEntry[] = [];
+      for (const index of this.indexes.values()) {
+        entries.push(this.row(index));
+      }
+      return entries;
+    });
+  }
+
+  /**
+   * Seqlock read: retry while a publish is in progress or completed underneath us
+   */
+  private read<T>(snapshot: () => T): T {
+    for (;;) {
+      const before = Atomics.load(this.words, H_SEQUENCE);
+      if (before & 1) continue;
+      const result = snapshot();
+      if (Atomics.load(this.words, H_SEQUENCE) === before) return result;
+      // The name index may have been rebuilt from a torn layout
+      this.layout = -1;
+    }
+  }
+
+  private refreshIndexes(): void {
+    const layout = this.words[H_LAYOUT];
+    if (layout === this.layout) return;
+
+    const count = Math.min(this.words[H_COUNT], this.words[H_CAPACITY]);
+    const indexes = new Map<string, number>();
+    for (let index = 0; index < count; index++) {
+      indexes.set(this.name(index), index);
+    }
+    this.indexes = indexes;
+    this.layout = layout;
+  }
+
+  private name(index: number): string {
+    const base = (HEADER_WORDS + index * ROW_WORDS) * 4;
+    const length = Math.min(Math.max(this.words[HEADER_WORDS + index * ROW_WORDS + R_NAME_LENGTH], 0), NAME_BYTES);
+    // slice() copies out of shared memory; decoders refuse shared views
+    const copy = this.bytes.slice(base + R_NAME * 4, base + R_NAME * 4 + length);
+    return Buffer.from(copy.buffer, copy.byteOffset, copy.byteLength).toString('utf8');
+  }
+
+  private row(index: number): PrinterStateEntry {
+    const base = HEADER_WORDS + index * ROW_WORDS;
+    const flags = this.words[base + R_FLAGS];
+    return {
+      name: this.name(index),
+      index,
+      state: STATES[this.words[base + R_STATE]] || 'unknown',
+      present: (flags & PRESENT) !== 0,
+      acceptingJobs: (flags & ACCEPTING) !== 0,
+      healthy: (flags & HEALTHY) !== 0,
+      queuedJobs: this.words[base + R_QUEUED],
+      changedAt: this.words[base + R_CHANGED]
+    };
+  }
+}
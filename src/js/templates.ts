@@ -0,0 +1,58 @@
+// Native raw-data templates (ESC/POS, ZPL, ...) with {{field}} placeholders
+
+import { PrintTemplate, TemplateRecord } from './types';
+import { PrinterError } from './errors';
+
+// Dynamic binding loader - will be replaced with proper loader
+let binding: any;
+try {
+  binding = require('./binding');
+} catch (error) {
+  throw new PrinterError('Failed to load native printer binding', 'DRIVER_ERROR', error);
+}
+
+export const templates = {
+  /**
+   * Compile a layout once for repeated rendering
+   * Placeholders: {{name}}, {{name:20}} (left-aligned, padded/cut to 20 characters), {{name:>8}} (right-aligned)
+   */
+  compile(source: string | Buffer): PrintTemplate {
+    try {
+      if (typeof source !== 'string' && !Buffer.isBuffer(source)) {
+        throw new PrinterError('Template source must be a string or Buffer', 'INVALID_ARGUMENTS');
+      }
+
+      const compiled = binding.compileTemplate(source);
+      return { id: compiled.id, fields: compiled.fields };
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Fill in records, back to back, into one Buffer backed by pooled native memory
+   * @param separator Bytes written between records (e.g. a cut command)
+   */
+  render(template: PrintTemplate, records: TemplateRecord[], separator?: string | Buffer): Buffer {
+    try {
+      if (!Array.isArray(records)) {
+        throw new PrinterError('Records must be an array', 'INVALID_ARGUMENTS');
+      }
+
+      return binding.renderTemplate(template?.id, records, separator);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  },
+
+  /**
+   * Free a compiled template; it cannot be rendered afterwards
+   */
+  release(template: PrintTemplate): boolean {
+    try {
+      return binding.releaseTemplate(template?.id);
+    } catch (error) {
+      throw PrinterError.fromNativeError(error);
+    }
+  }
+};
@@ -1,13 +1,61 @@
 // TypeScript type definitions for @ssxv/node-printer
 
+import type { PrinterError } from './errors';
+
 export interface Printer {
   name: string;
   isDefault: boolean;
   state: 'idle' | 'printing' | 'stopped' | 'offline' | 'error';
+  /** Detail behind the state, e.g. 'media-empty-error' or 'offline-report' */
+  stateReasons?: string[];
+  /** False when the queue rejects new jobs (CUPS) */
+  acceptingJobs?: boolean;
   location?: string;
   description?: string;
 }
 
+export interface DiscoveryOptions {
+  /** How long to keep looking for network printers, in milliseconds (default 5000) */
+  timeout?: number;
+  /** Printer type bits that must be set (CUPS cups_ptype_t, e.g. 0x2 for remote) */
+  type?: number;
+  /** Which printer type bits to compare against `type` */
+  mask?: number;
+  /** Called for each printer as it is found */
+  onPrinter?: (printer: Printer) => void;
+}
+
+export interface PrinterDiscovery extends AsyncIterable<Printer> {
+  /** Resolves with every printer found once discovery finishes or is cancelled */
+  readonly done: Promise<Printer[]>;
+  /** Stop discovering; printers found so far are kept */
+  cancel(): void;
+}
+
+export interface StateTableOptions {
+  /** Printers the table has rows for (default 256); later printers are dropped */
+  capacity?: number;
+  /** Poll interval in milliseconds (default 2000, minimum 100) */
+  intervalMs?: number;
+  /** Also publish each printer's queued job count (default true; one job listing per poll) */
+  queueDepth?: boolean;
+}
+
+export interface PrinterStateEntry {
+  name: string;
+  /** Row in the table; stable for the table's lifetime */
+  index: number;
+  state: 'unknown' | 'idle' | 'printing' | 'stopped' | 'offline' | 'error';
+  /** False once the printer stops being listed */
+  present: boolean;
+  acceptingJobs: boolean;
+  /** Whether fallback routing would pick this printer */
+  healthy: boolean;
+  queuedJobs: number;
+  /** Table sequence at which this row last changed */
+  changedAt: number;
+}
+
 export interface PrinterCapabilities {
   formats: ('PDF' | 'TEXT' | 'RAW' | 'IMAGE')[];
   paperSizes?: string[];
@@ -17,7 +65,7 @@ export interface PrinterCapabilities {
 
 export interface PrintJob {
   id: number;
-  state: 'pending' | 'printing' | 'completed' | 'canceled' | 'paused' | 'error';
+  state: 'pending' | 'printing' | 'completed' | 'canceled' | 'paused' | 'aborted' | 'error';
   printer?: string;
   title?: string;
   user?: string;
@@ -28,16 +76,215 @@ export interface PrintJob {
   size?: number;
 }
 
+export interface ListJobsOptions {
+  /** Only this printer's jobs (default: every printer) */
+  printer?: string;
+  /**
+   * Return views over a native snapshot instead of plain objects; fields such as title,
+   * user and the Dates are only converted when read. Use toJSON() for a plain copy
+   */
+  lazy?: boolean;
+}
+
+/** Which jobs a listing covers: unfinished, finished (completed, canceled, aborted) or both */
+export type WhichJobs = 'all' | 'active' | 'completed';
+
+export interface IterateJobsOptions {
+  /** Only this printer's jobs (default: every printer on CUPS; required on Windows) */
+  printer?: string;
+  which?: WhichJobs;
+  /** Jobs fetched per round-trip; at most this many are held at once (default 500) */
+  pageSize?: number;
+}
+
+export interface ListAllJobsOptions {
+  which?: WhichJobs;
+  /** Most jobs returned across all printers (default: no limit) */
+  limit?: number;
+}
+
+export interface PrinterJobs {
+  printer: string;
+  jobs: PrintJob[];
+  /** Present when this printer's jobs could not be listed */
+  error?: PrinterError;
+}
+
+export interface JobRef {
+  printer: string;
+  id: number;
+}
+
+export interface JobLookupResult {
+  printer: string;
+  id: number;
+  /** Present when the lookup succeeded */
+  job?: PrintJob;
+  /** Present when the lookup failed */
+  error?: PrinterError;
+}
+
+export interface JobCommandResult {
+  id: number;
+  ok: boolean;
+  /** Present when the command failed for this job */
+  error?: PrinterError;
+}
+
+export interface PurgeOptions {
+  /** 'active' cancels pending/printing jobs; 'all' also removes finished jobs from history. Default 'active' */
+  which?: 'active' | 'all';
+  /** Only affect jobs submitted by this user */
+  user?: string;
+}
+
+/**
+ * 'detect' recognizes the document from its first bytes (PDF, PostScript, PCL, ZPL, ESC/POS, ...)
+ * and submits it with that document-format; printer languages always bypass CUPS filters
+ */
+export type DocumentFormatOption = 'RAW' | 'detect';
+
+export interface DetectedFormat {
+  /** 'PDF', 'POSTSCRIPT', 'PJL', 'PCL', 'PWG', 'CUPS_RASTER', 'URF', 'JPEG', 'PNG', 'ZPL', 'ESCPOS', 'TEXT' or 'RAW' */
+  name: string;
+  mimeType: string;
+  /** A printer language that is sent to the printer unfiltered */
+  printerReady: boolean;
+}
+
 export interface PrintFileOptions {
+  /** Queue name, or an ipp:// / ipps:// URI to submit directly to the device (CUPS only) */
   printer: string;
   file: string;
+  /** 'detect' sets the document-format from the file contents (CUPS; Windows always prints files RAW) */
+  format?: 'detect';
   options?: PrintOptions;
+  /** Printers to use, in order, if `printer` is stopped, offline or reporting an error */
+  fallbacks?: string[];
+}
+
+export type CodePage = 'cp437' | 'cp858' | 'cp1252' | 'shift_jis';
+
+/**
+ * Printer code page for text
+ * Control characters (ESC/POS commands, line feeds) pass through unchanged
+ */
+export interface TextEncoding {
+  codePage: CodePage;
+  /** Characters the code page lacks, and invalid UTF-8: 'replace' (default), 'skip' or 'error' */
+  unmappable?: 'replace' | 'skip' | 'error';
+  /** Written for each unmappable character, already in the code page (default '?') */
+  replacement?: string | Buffer;
 }
 
 export interface PrintRawOptions {
+  /** Queue name, or an ipp:// / ipps:// URI to submit directly to the device (CUPS only) */
   printer: string;
+  /** Bytes to send, or text (sent as UTF-8 unless `encoding` is given) */
+  data: Buffer | string;
+  /** Transcode string data natively into a printer code page */
+  encoding?: TextEncoding;
+  format?: DocumentFormatOption;
+  options?: PrintOptions;
+  /** Printers to use, in order, if `printer` is stopped, offline or reporting an error */
+  fallbacks?: string[];
+}
+
+export interface PrintDocumentsOptions {
+  /** Queue name, or an ipp:// / ipps:// URI to submit directly to the device (CUPS only) */
+  printer: string;
+  /** File paths and/or Buffers, printed in order as the documents of a single job */
+  documents: Array<string | Buffer>;
+  /** 'detect' sets each document's format from its contents; by default CUPS types each document itself */
+  format?: DocumentFormatOption;
+  options?: PrintOptions;
+}
+
+/**
+ * One uncompressed page: rows top to bottom, each padded to a whole byte
+ * bpp 1 = bilevel (1 is black, PWG only), 8 = sGray (0 is black), 24 = sRGB
+ */
+export interface RasterPage {
+  width: number;
+  height: number;
+  bpp?: 1 | 8 | 24;
   data: Buffer;
-  format?: 'RAW';
+}
+
+export interface PrintRasterOptions {
+  /** Queue name, or an ipp:// / ipps:// URI of an IPP Everywhere / AirPrint device */
+  printer: string;
+  pages: RasterPage[];
+  /** DPI, or [x, y] (default 300; URF needs x === y) */
+  resolution?: number | [number, number];
+  /** 'pwg' (image/pwg-raster, default) or 'urf' (image/urf) */
+  format?: 'pwg' | 'urf';
+  /** PWG media name written into each page header, e.g. 'na_letter_8.5x11in' */
+  mediaName?: string;
+  /** Convert pages to gray, shrink them to the printer and dither them natively before encoding */
+  process?: RasterProcessing;
+  options?: PrintOptions;
+}
+
+/**
+ * Device-side page preparation for printRaster
+ * Pages larger than the fit box are area-averaged down to it (never scaled up), so full-size
+ * photos reach a 203 dpi label printer as a few kilobytes of bilevel raster
+ */
+export interface RasterProcessing {
+  /** Output depth: 1 (bilevel, default for 'pwg') or 8 (gray, default and only choice for 'urf') */
+  bpp?: 1 | 8;
+  /** How gray becomes black and white at 1 bpp (default 'floyd-steinberg') */
+  dither?: 'threshold' | 'ordered' | 'floyd-steinberg';
+  /** Fit box in device pixels; defaults to the size of `mediaName` at `resolution` */
+  maxWidth?: number;
+  maxHeight?: number;
+}
+
+/** Handle to a layout compiled with templates.compile */
+export interface PrintTemplate {
+  id: number;
+  /** Distinct placeholder names, in order of first use */
+  fields: string[];
+}
+
+/** Field values by placeholder name; Buffers are inserted as raw bytes */
+export type TemplateRecord = Record<string, string | number | boolean | Buffer | null | undefined>;
+
+export interface PrintTemplateOptions {
+  printer: string;
+  template: PrintTemplate;
+  /** Rendered back to back into a single job */
+  records: TemplateRecord[];
+  /** Bytes written between records (e.g. a cut command) */
+  separator?: string | Buffer;
+  format?: DocumentFormatOption;
+  options?: PrintOptions;
+}
+
+export type PoolStrategy = 'least-queued' | 'least-bytes' | 'round-robin';
+
+export interface PoolSubmitOptions {
+  /** Equivalent printers to choose from */
+  printers: string[];
+  /** Raw data to send; mutually exclusive with file */
+  data?: Buffer;
+  /** File to print; mutually exclusive with data */
+  file?: string;
+  /** Format of raw data */
+  format?: DocumentFormatOption;
+  options?: PrintOptions;
+  /** How the target is chosen (default 'least-queued') */
+  strategy?: PoolStrategy;
+}
+
+export interface QueuedPrintOptions {
+  printer: string;
+  /** Raw data to send; mutually exclusive with file */
+  data?: Buffer;
+  /** File to print; mutually exclusive with data */
+  file?: string;
+  format?: DocumentFormatOption;
   options?: PrintOptions;
 }
 
@@ -48,13 +295,283 @@ export interface PrintOptions {
   paperSize?: string;
   orientation?: 'portrait' | 'landscape';
   jobName?: string;
+  /** Queue priority 1-100, higher prints first (CUPS job-priority; mapped to 1-99 on Windows) */
+  priority?: number;
+  /** Hold the job until then (CUPS only; rejected with UNSUPPORTED_OPERATION on Windows); see {@link HoldUntil} */
+  holdUntil?: HoldUntil;
+  /** Caller metadata (order number, user, ...) recorded in the job ledger; never sent to the printer */
+  tags?: Record<string, string>;
+}
+
+/**
+ * When a held job is released (CUPS job-hold-until)
+ * - a keyword: 'indefinite' (until jobs.release), 'day-time', 'evening', 'night', 'second-shift',
+ *   'third-shift', 'weekend', or 'no-hold'
+ * - a time of day 'HH:MM' or 'HH:MM:SS' in UTC (the next occurrence within 24 hours)
+ * - a future Date within the next 24 hours (past Dates are rejected)
+ */
+export type HoldUntil = string | Date;
+
+export interface JobUpdateOptions {
+  priority?: number;
+  holdUntil?: HoldUntil;
 }
 
 export interface PrintJobResult {
   id: number;
+  /** Printer the job was queued on (a fallback when failover kicked in) */
   printer: string;
+  /** Printers passed over by failover, with the reason */
+  skipped?: Array<{ printer: string; reason: string }>;
+  /** Time the submission was delayed by rate limits (see configure({ rateLimits })) */
+  throttledMs?: number;
 }
 
 export interface PrinterDriverOptions {
   [key: string]: any;
 }
+
+export interface ConnectionPoolOptions {
+  /** Maximum open connections per CUPS server (default 4) */
+  maxPerServer?: number;
+  /** Idle connections older than this are closed (default 30000) */
+  idleTimeoutMs?: number;
+  /** Connect timeout and maximum wait for a free connection (default 30000) */
+  connectTimeoutMs?: number;
+  /** Connect attempts before failing, with exponential backoff (default 3) */
+  connectAttempts?: number;
+  /** Upper bound of the backoff between connect attempts (default 2000) */
+  maxBackoffMs?: number;
+}
+
+export interface SubmissionQueueOptions {
+  /** Concurrent submissions per printer; the ceiling when adaptive (default 8) */
+  maxInFlight?: number;
+  /** Data or file bytes held per printer, waiting or in flight (default 64 MiB) */
+  maxQueuedBytes?: number;
+  /** Jobs held per printer, waiting or in flight (default 1000) */
+  maxQueuedJobs?: number;
+  /** Worker threads shared by all printers (default 4; can only grow) */
+  workers?: number;
+  /** Tune each printer's limit from submit latency, errors and completion time (default true) */
+  adaptive?: boolean;
+  /** Starting limit of an adaptive printer (default 2) */
+  initialInFlight?: number;
+  /** Back off once submit latency exceeds this multiple of the best seen (default 2) */
+  latencyTolerance?: number;
+}
+
+/** Token-bucket limits; omitted rates are unlimited */
+export interface RateLimit {
+  jobsPerSecond?: number;
+  bytesPerSecond?: number;
+  /** Jobs that may go out back to back (default: one second's worth, at least 1) */
+  burstJobs?: number;
+  /** Bytes that may go out back to back (default: one second's worth) */
+  burstBytes?: number;
+}
+
+export interface RateLimitOptions {
+  /** Limit for every printer without its own entry */
+  printer?: RateLimit;
+  /** Limit for every server without its own entry */
+  server?: RateLimit;
+  /** Per-printer limits, keyed by printer name or URI */
+  printers?: Record<string, RateLimit>;
+  /**
+   * Per-server limits: host[:port] of an ipp:// URI, the server of a \\server\printer share,
+   * or 'default' for local queues
+   */
+  servers?: Record<string, RateLimit>;
+}
+
+export interface RetryOptions {
+  /** Tries per operation, including the first; 1 disables retries (default 3) */
+  maxAttempts?: number;
+  /** Delay before the first retry (default 100) */
+  initialDelayMs?: number;
+  /** Cap on any single delay (default 2000) */
+  maxDelayMs?: number;
+  /** Delay growth per retry (default 2) */
+  multiplier?: number;
+  /** Fraction of each delay that is randomized, 0-1 (default 0.5) */
+  jitter?: number;
+  /**
+   * Platform statuses worth retrying: IPP status codes on CUPS, Win32 error codes on Windows.
+   * Replaces the defaults (busy, service unavailable, temporary/internal errors, timeouts,
+   * RPC failures while the spooler restarts); an empty array restores them
+   */
+  retryableStatuses?: number[];
+}
+
+export interface LedgerOptions {
+  /**
+   * Append-only log file, created if missing; earlier entries are indexed on open.
+   * One process at a time may hold a ledger. Omit to close the ledger
+   */
+  path?: string;
+}
+
+export interface LedgerQuery {
+  printer?: string;
+  /** Entries carrying every one of these tags */
+  tags?: Record<string, string>;
+  state?: LedgerEntry['state'];
+  /** Submitted at or after */
+  since?: Date | number;
+  /** Submitted at or before */
+  until?: Date | number;
+  /** Maximum entries, newest first (default 1000) */
+  limit?: number;
+}
+
+export interface LedgerEntry {
+  id: number;
+  printer: string;
+  tags: Record<string, string>;
+  /** Submitted size */
+  bytes: number;
+  submittedAt: Date;
+  /** When the final state was first seen */
+  finishedAt?: Date;
+  /** Final states are recorded when observed through jobs.get/getMany/list/iterate or a cancel */
+  state: 'submitted' | 'completed' | 'canceled' | 'aborted';
+}
+
+export interface NativeConfig {
+  connectionPool?: ConnectionPoolOptions;
+  submissionQueue?: SubmissionQueueOptions;
+  /** Replaces all rate limits; submissions over a limit are delayed, not rejected */
+  rateLimits?: RateLimitOptions;
+  /** Retries of transient spooler failures, applied to every job operation */
+  retry?: RetryOptions;
+  /** Record every submission in a local job ledger (see ledger.query) */
+  ledger?: LedgerOptions;
+}
+
+export interface ConnectionPoolMetrics {
+  hits: number;
+  creates: number;
+  failures: number;
+  reconnects: number;
+  reaped: number;
+  waits: number;
+  idle: number;
+  inUse: number;
+}
+
+export interface PrinterLoadMetrics {
+  printer: string;
+  /** Jobs on the printer (last queue refresh) plus our submissions since */
+  queuedJobs: number;
+  /** Estimated bytes behind those jobs */
+  queuedBytes: number;
+  /** Submissions currently uploading */
+  inFlight: number;
+}
+
+export interface SubmissionQueueMetrics {
+  printer: string;
+  queued: number;
+  inFlight: number;
+  queuedBytes: number;
+  submitted: number;
+  failed: number;
+  /** Jobs refused with QUEUE_FULL */
+  rejected: number;
+  /** Current in-flight limit */
+  limit: number;
+  /** Smoothed submit latency */
+  latencyMs: number;
+  /** Best submit latency seen */
+  baselineLatencyMs: number;
+  /** Smoothed share of failed submissions (0-1) */
+  errorRate: number;
+  /** Smoothed time from submission to a final job state, from sampled jobs */
+  completionMs: number;
+  /** Times the limit was cut */
+  decreases: number;
+  /** Why the limit last stopped growing: 'errors', 'latency' or 'backlog' */
+  throttleReason?: string;
+}
+
+export interface RateLimitMetrics {
+  /** Set for printer limits */
+  printer?: string;
+  /** Set for server limits */
+  server?: string;
+  /** Submissions that had to wait */
+  throttled: number;
+  throttledMs: number;
+}
+
+export interface TemplateBufferMetrics {
+  /** Renders served from a recycled buffer */
+  hits: number;
+  /** Renders that had to allocate */
+  misses: number;
+}
+
+export interface RetryMetrics {
+  /** Job operations run */
+  operations: number;
+  attempts: number;
+  retries: number;
+  /** Operations that succeeded after a retry */
+  recovered: number;
+  /** Operations that still failed with a retryable status after maxAttempts */
+  exhausted: number;
+  /** Total time spent backing off */
+  backoffMs: number;
+  /** Successful operations by attempt: [first, second, ...] */
+  succeededOnAttempt: number[];
+  /** Retried failures keyed by platform status (decimal) */
+  retriedStatuses: Record<string, number>;
+}
+
+export interface LedgerMetrics {
+  /** Submissions indexed */
+  records: number;
+  usedBytes: number;
+  capacityBytes: number;
+  /** Records dropped because the log could not grow */
+  writeErrors: number;
+}
+
+export interface StateTableMetrics {
+  polls: number;
+  /** Polls where the printer list could not be read */
+  pollErrors: number;
+  /** Row updates published */
+  changes: number;
+  printers: number;
+  /** Printers that did not fit in the table */
+  dropped: number;
+}
+
+export interface BackendMetrics {
+  /** Whether each lazily created part of the native core exists yet */
+  printers: boolean;
+  jobs: boolean;
+  healthCache: boolean;
+}
+
+export interface NativeMetrics {
+  connectionPool?: ConnectionPoolMetrics;
+  /** Load estimates for printers used with jobs.submitToPool */
+  printerPool: PrinterLoadMetrics[];
+  /** Per-printer state of the jobs.enqueue queue */
+  submissionQueue: SubmissionQueueMetrics[];
+  /** Throttling per rate-limited printer and server */
+  rateLimits: RateLimitMetrics[];
+  /** Native backends created so far (see printers.warmup) */
+  backends: BackendMetrics;
+  /** Retries of transient spooler failures */
+  retry: RetryMetrics;
+  /** Present while a job ledger is open */
+  ledger?: LedgerMetrics;
+  /** Present while printers.createStateTable() is publishing, from any thread */
+  stateTable?: StateTableMetrics;
+  /** Pooled buffers used by template rendering */
+  templateBuffers: TemplateBufferMetrics;
+}
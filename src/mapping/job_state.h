@@ -71,7 +71,7 @@ std::string mapCupsJobState(int cupsState) {
         case IPP_JOB_CANCELLED:
             return "canceled";
         case IPP_JOB_ABORTED:
-            return "error";
+            return "aborted";
         case IPP_JOB_COMPLETED:
             return "completed";
         default:
@@ -162,8 +162,11 @@ std::string mapJobStateString(const std::string& statusStr) {
         return "canceled";
     }
     
+    if (upperStatus.find("ABORTED") != std::string::npos) {
+        return "aborted";
+    }
+    
     if (upperStatus.find("ERROR") != std::string::npos ||
-        upperStatus.find("ABORTED") != std::string::npos ||
         upperStatus.find("STOPPED") != std::string::npos) {
         return "error";  
     }
@@ -2,15 +2,38 @@
 // Coordinates platform-specific implementations and exposes unified API
 
 #include <napi.h>
+#include <uv.h>
 #include "printer_api.h"
 #include "job_api.h"
 #include "errors.h"
+#include "printer_pool.h"
+#include "submission_queue.h"
+#include "rate_limiter.h"
+#include "retry_policy.h"
+#include "job_ledger.h"
+#include "printer_state_table.h"
+#include "native_core.h"
+#include "raster_encoder.h"
+#include "image_processor.h"
+#include "template_engine.h"
+#include "format_sniffer.h"
+#include "transcoder.h"
+#include <cmath>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <functional>
 
 #ifdef _WIN32
 #include "win/printers_win.cpp"
 #include "win/jobs_win.cpp"
 #else
+#include "cups/connection_pool_cups.cpp"
+#include "cups/ipp_utils_cups.cpp"
+#include "cups/ipp_direct_cups.cpp"
 #include "cups/printers_cups.cpp"
 #include "cups/jobs_cups.cpp"
 #endif
@@ -34,9 +57,75 @@ std::unique_ptr<IJobAPI> createJobAPI() {
 #endif
 }
 
-// Global API instances (initialized at module load)
-static std::unique_ptr<IPrinterAPI> g_printerAPI;
-static std::unique_ptr<IJobAPI> g_jobAPI;
+/**
+ * Settles submission-queue promises on the thread of the environment that queued them
+ * The callback is created on first use. open is cleared, under the mutex, when
+ * the callback is finalized, so queue threads never call into a torn-down environment.
+ */
+struct QueueChannel {
+    std::mutex mutex;
+    Napi::ThreadSafeFunction callback;
+    bool created = false;
+    bool open = false;
+    size_t outstanding = 0;       // Only touched on the environment's thread
+};
+
+/**
+ * One-shot timer on an environment's event loop (see runAfter)
+ */
+struct LoopTimer {
+    uv_timer_t handle;
+    napi_env env;
+    std::function<void(Napi::Env)> fire;
+};
+
+static void deleteLoopTimer(uv_handle_t* handle) {
+    delete static_cast<LoopTimer*>(handle->data);
+}
+
+/**
+ * Per-environment state (main thread or one worker_thread), kept as N-API instance data
+ * Deleted when the environment shuts down, which stops the state table if this
+ * environment owns it and releases its reference to the shared NativeCore.
+ */
+struct AddonData {
+    std::shared_ptr<NativeCore> core;
+    Napi::FunctionReference jobSnapshot;
+    
+    // Compiled templates by ID; async work holds its own reference
+    std::map<uint32_t, std::shared_ptr<PrintTemplate>> templates;
+    uint32_t nextTemplateId = 1;
+    
+    std::shared_ptr<QueueChannel> queue = std::make_shared<QueueChannel>();
+    
+    // Memory of the process's state table when this environment started it; the
+    // reference keeps the SharedArrayBuffer alive while the core's poller writes
+    Napi::ObjectReference stateTableMemory;
+    
+    // Pending rate-limit waits; closed with the environment so its loop can shut down
+    std::set<LoopTimer*> timers;
+    
+    ~AddonData() {
+        if (core) {
+            core->stopStateTable(this);   // Joins the poller before the memory is released
+        }
+        for (LoopTimer* timer : timers) {
+            uv_timer_stop(&timer->handle);
+            uv_close(reinterpret_cast<uv_handle_t*>(&timer->handle), deleteLoopTimer);
+        }
+    }
+    
+    static AddonData& from(Napi::Env env) {
+        return *env.GetInstanceData<AddonData>();
+    }
+};
+
+/**
+ * The process-wide core; valid in every binding, since the calling environment holds a reference
+ */
+static NativeCore& core() {
+    return NativeCore::current();
+}
 
 /**
  * Convert PrinterException to enhanced Napi::Error
@@ -82,6 +171,13 @@ Napi::Object printerInfoToJS(const PrinterInfo& info, Napi::Env env) {
     statusArr.Set(0u, info.state);
     obj.Set("status", statusArr);
     
+    Napi::Array reasons = Napi::Array::New(env, info.stateReasons.size());
+    for (size_t i = 0; i < info.stateReasons.size(); ++i) {
+        reasons[i] = Napi::String::New(env, info.stateReasons[i]);
+    }
+    obj.Set("stateReasons", reasons);
+    obj.Set("acceptingJobs", info.acceptingJobs);
+    
     if (!info.location.empty()) {
         obj.Set("location", info.location);
     }
@@ -140,6 +236,126 @@ Napi::Object jobInfoToJS(const JobInfo& info, Napi::Env env) {
     return obj;
 }
 
+/**
+ * Jobs from one listing, kept native until JavaScript reads them
+ * Each accessor converts a single field of a single job, so a caller that only
+ * looks at id and state never pays for titles, users or timestamps.
+ */
+class JobSnapshot : public Napi::ObjectWrap<JobSnapshot> {
+public:
+    static Napi::Function Init(Napi::Env env) {
+        return DefineClass(env, "JobSnapshot", {
+            InstanceAccessor("length", &JobSnapshot::Length, nullptr),
+            InstanceMethod("id", &JobSnapshot::Id),
+            InstanceMethod("state", &JobSnapshot::State),
+            InstanceMethod("printer", &JobSnapshot::Printer),
+            InstanceMethod("title", &JobSnapshot::Title),
+            InstanceMethod("user", &JobSnapshot::User),
+            InstanceMethod("creationTime", &JobSnapshot::CreationTime),
+            InstanceMethod("processingTime", &JobSnapshot::ProcessingTime),
+            InstanceMethod("completedTime", &JobSnapshot::CompletedTime),
+            InstanceMethod("pages", &JobSnapshot::Pages),
+            InstanceMethod("size", &JobSnapshot::Size),
+            InstanceMethod("toObject", &JobSnapshot::ToObject),
+        });
+    }
+    
+    static Napi::Object New(Napi::Env env, std::vector<JobInfo> jobs) {
+        Napi::Object obj = AddonData::from(env).jobSnapshot.New({});
+        Unwrap(obj)->jobs_ = std::move(jobs);
+        return obj;
+    }
+    
+    JobSnapshot(const Napi::CallbackInfo& info) : Napi::ObjectWrap<JobSnapshot>(info) {}
+
+private:
+    std::vector<JobInfo> jobs_;
+    
+    /**
+     * Job at info[0], or nullptr (with a pending RangeError) if the index is bad
+     */
+    const JobInfo* at(const Napi::CallbackInfo& info) {
+        if (info.Length() < 1 || !info[0].IsNumber()) {
+            Napi::TypeError::New(info.Env(), "Job index required").ThrowAsJavaScriptException();
+            return nullptr;
+        }
+        int64_t index = info[0].As<Napi::Number>().Int64Value();
+        if (index < 0 || static_cast<size_t>(index) >= jobs_.size()) {
+            Napi::RangeError::New(info.Env(), "Job index out of range").ThrowAsJavaScriptException();
+            return nullptr;
+        }
+        return &jobs_[static_cast<size_t>(index)];
+    }
+    
+    static Napi::Value optionalString(Napi::Env env, const std::string& value) {
+        return value.empty() ? env.Undefined() : Napi::String::New(env, value);
+    }
+    
+    static Napi::Value optionalNumber(Napi::Env env, int64_t value) {
+        return value > 0 ? Napi::Number::New(env, static_cast<double>(value)) : env.Undefined();
+    }
+    
+    Napi::Value Length(const Napi::CallbackInfo& info) {
+        return Napi::Number::New(info.Env(), static_cast<double>(jobs_.size()));
+    }
+    
+    Napi::Value Id(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? Napi::Number::New(info.Env(), job->id) : info.Env().Null();
+    }
+    
+    Napi::Value State(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? Napi::String::New(info.Env(), job->state) : info.Env().Null();
+    }
+    
+    Napi::Value Printer(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalString(info.Env(), job->printer) : info.Env().Null();
+    }
+    
+    Napi::Value Title(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalString(info.Env(), job->title) : info.Env().Null();
+    }
+    
+    Napi::Value User(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalString(info.Env(), job->user) : info.Env().Null();
+    }
+    
+    Napi::Value CreationTime(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalNumber(info.Env(), job->creationTime) : info.Env().Null();
+    }
+    
+    Napi::Value ProcessingTime(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalNumber(info.Env(), job->processingTime) : info.Env().Null();
+    }
+    
+    Napi::Value CompletedTime(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalNumber(info.Env(), job->completedTime) : info.Env().Null();
+    }
+    
+    Napi::Value Pages(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalNumber(info.Env(), job->pages) : info.Env().Null();
+    }
+    
+    Napi::Value Size(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? optionalNumber(info.Env(), job->size) : info.Env().Null();
+    }
+    
+    // Every field at once, in the getJobs() shape
+    Napi::Value ToObject(const Napi::CallbackInfo& info) {
+        const JobInfo* job = at(info);
+        return job ? jobInfoToJS(*job, info.Env()) : info.Env().Null();
+    }
+};
+
 /**
  * Convert JavaScript print options to PrintOptions struct
  */
@@ -174,20 +390,92 @@ PrintOptions jsTorintOptions(const Napi::Value& jsOptions) {
         } else if (optObj.Has("jobName") && optObj.Get("jobName").IsString()) {
             options.jobName = optObj.Get("jobName").As<Napi::String>().Utf8Value();
         }
+        
+        if (optObj.Has("priority") && optObj.Get("priority").IsNumber()) {
+            options.priority = optObj.Get("priority").As<Napi::Number>().Int32Value();
+        }
+        
+        if (optObj.Has("holdUntil") && optObj.Get("holdUntil").IsString()) {
+            options.holdUntil = optObj.Get("holdUntil").As<Napi::String>().Utf8Value();
+        }
+        
+        if (optObj.Has("tags") && optObj.Get("tags").IsObject()) {
+            Napi::Object tags = optObj.Get("tags").As<Napi::Object>();
+            Napi::Array keys = tags.GetPropertyNames();
+            for (uint32_t i = 0; i < keys.Length(); ++i) {
+                std::string key = keys.Get(i).As<Napi::String>().Utf8Value();
+                if (tags.Get(key).IsString()) {
+                    options.tags[key] = tags.Get(key).As<Napi::String>().Utf8Value();
+                }
+            }
+        }
     }
     
     return options;
 }
 
+/**
+ * Convert JavaScript { codePage, unmappable, replacement } to TranscodeOptions
+ * @returns false (with a pending TypeError) for unknown code pages or modes
+ */
+bool jsToTranscodeOptions(Napi::Env env, const Napi::Value& value, TranscodeOptions& options) {
+    Napi::Object obj = value.As<Napi::Object>();
+    
+    if (!obj.Get("codePage").IsString() ||
+        !parseCodePage(obj.Get("codePage").As<Napi::String>().Utf8Value(), options.codePage)) {
+        Napi::TypeError::New(env, "Invalid codePage. Use 'cp437', 'cp858', 'cp1252' or 'shift_jis'").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    if (obj.Get("unmappable").IsString() &&
+        !parseUnmappable(obj.Get("unmappable").As<Napi::String>().Utf8Value(), options.unmappable)) {
+        Napi::TypeError::New(env, "Invalid unmappable. Use 'replace', 'skip' or 'error'").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    Napi::Value replacement = obj.Get("replacement");
+    if (replacement.IsBuffer()) {
+        Napi::Buffer<char> buffer = replacement.As<Napi::Buffer<char>>();
+        options.replacement.assign(buffer.Data(), buffer.Length());
+    } else if (replacement.IsString()) {
+        options.replacement = replacement.As<Napi::String>().Utf8Value();
+    }
+    
+    return true;
+}
+
+/**
+ * Convert a JavaScript which-jobs keyword ("all", "active", "completed")
+ * @returns false (with a pending TypeError) for unknown keywords
+ */
+bool jsToWhichJobs(Napi::Env env, const Napi::Value& value, WhichJobs& which) {
+    if (value.IsUndefined()) {
+        return true;
+    }
+    
+    std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : "";
+    if (name == "all") {
+        which = WhichJobs::ALL;
+    } else if (name == "active") {
+        which = WhichJobs::ACTIVE;
+    } else if (name == "completed") {
+        which = WhichJobs::COMPLETED;
+    } else {
+        Napi::TypeError::New(env, "Invalid which. Use 'all', 'active' or 'completed'").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
 // Async worker classes for non-blocking operations
 class GetPrintersWorker : public Napi::AsyncWorker {
 public:
     GetPrintersWorker(Napi::Function& callback) 
-        : Napi::AsyncWorker(callback) {}
+        : Napi::AsyncWorker(callback), coreRef(AddonData::from(callback.Env()).core) {}
     
     void Execute() override {
         try {
-            printers = g_printerAPI->getPrinters();
+            printers = core().printerAPI->getPrinters();
         } catch (const std::exception& e) {
             SetError(e.what());
         }
@@ -205,9 +493,278 @@ public:
     }
 
 private:
+    std::shared_ptr<NativeCore> coreRef;      // Keeps the core alive if the environment exits first
     std::vector<PrinterInfo> printers;
 };
 
+/**
+ * Runs a task on the libuv thread pool and settles a promise with its result
+ * PrinterExceptions are rejected with the enhanced error (code, platformCode)
+ */
+template <typename Result>
+class PromiseWorker : public Napi::AsyncWorker {
+public:
+    using Task = std::function<Result()>;
+    using Convert = std::function<Napi::Value(Napi::Env, Result&)>;
+    
+    static Napi::Promise Run(Napi::Env env, Task task, Convert convert) {
+        PromiseWorker* worker = new PromiseWorker(env, std::move(task), std::move(convert));
+        Napi::Promise promise = worker->deferred.Promise();
+        worker->Queue();
+        return promise;
+    }
+    
+    void Execute() override {
+        try {
+            result = task();
+        } catch (const PrinterException& e) {
+            failure.reset(new PrinterException(e));
+            SetError(e.what());
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+    
+    void OnOK() override {
+        deferred.Resolve(convert(Env(), result));
+    }
+    
+    void OnError(const Napi::Error& e) override {
+        if (failure) {
+            deferred.Reject(createEnhancedNapiError(Env(), *failure).Value());
+        } else {
+            deferred.Reject(e.Value());
+        }
+    }
+
+private:
+    PromiseWorker(Napi::Env env, Task task, Convert convert)
+        : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)),
+          task(std::move(task)), convert(std::move(convert)), coreRef(AddonData::from(env).core) {}
+    
+    Napi::Promise::Deferred deferred;
+    Task task;
+    Convert convert;
+    Result result;
+    std::unique_ptr<PrinterException> failure;
+    std::shared_ptr<NativeCore> coreRef;      // Keeps the core alive if the environment exits first
+};
+
+/**
+ * Call fire on the environment's thread once delayMs has passed
+ * The wait is a libuv timer, so it holds neither the event loop nor a pool thread.
+ */
+void runAfter(Napi::Env env, double delayMs, std::function<void(Napi::Env)> fire) {
+    if (delayMs <= 0) {
+        fire(env);
+        return;
+    }
+    
+    uv_loop_t* loop = nullptr;
+    napi_get_uv_event_loop(env, &loop);
+    
+    LoopTimer* timer = new LoopTimer();
+    timer->env = env;
+    timer->fire = std::move(fire);
+    timer->handle.data = timer;
+    uv_timer_init(loop, &timer->handle);
+    AddonData::from(env).timers.insert(timer);
+    
+    uv_timer_start(&timer->handle, [](uv_timer_t* handle) {
+        LoopTimer* timer = static_cast<LoopTimer*>(handle->data);
+        Napi::Env env(timer->env);
+        AddonData::from(env).timers.erase(timer);
+        {
+            Napi::HandleScope scope(env);
+            timer->fire(env);
+        }
+        uv_close(reinterpret_cast<uv_handle_t*>(handle), deleteLoopTimer);
+    }, static_cast<uint64_t>(std::ceil(delayMs)), 0);
+}
+
+/**
+ * Convert a captured exception to the value a promise is rejected with
+ */
+Napi::Value exceptionToJS(Napi::Env env, std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const PrinterException& e) {
+        return createEnhancedNapiError(env, e).Value();
+    } catch (const std::exception& e) {
+        return Napi::Error::New(env, e.what()).Value();
+    } catch (...) {
+        return Napi::Error::New(env, "Unknown error").Value();
+    }
+}
+
+/**
+ * Runs one step of a multi-step task on the libuv thread pool
+ * done is called on the environment's thread with the step's exception, if any.
+ */
+class StepWorker : public Napi::AsyncWorker {
+public:
+    using Step = std::function<void()>;
+    using Done = std::function<void(Napi::Env, std::exception_ptr)>;
+    
+    static void Run(Napi::Env env, Step step, Done done) {
+        (new StepWorker(env, std::move(step), std::move(done)))->Queue();
+    }
+    
+    void Execute() override {
+        try {
+            step();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    
+    void OnOK() override {
+        done(Env(), error);
+    }
+
+private:
+    StepWorker(Napi::Env env, Step step, Done done)
+        : Napi::AsyncWorker(env), step(std::move(step)), done(std::move(done)),
+          coreRef(AddonData::from(env).core) {}
+    
+    Step step;
+    Done done;
+    std::exception_ptr error;
+    std::shared_ptr<NativeCore> coreRef;
+};
+
+/**
+ * Printer and size a submission is rate-limited by
+ */
+struct ThrottleTarget {
+    std::string printer;
+    uint64_t bytes = 0;
+};
+
+/**
+ * Runs a submission whose rate-limit wait is a timer on the event loop
+ *
+ * prepare() runs on the thread pool and settles the printer and size (rendering,
+ * checking health, choosing from a pool). The tokens are then reserved on the
+ * JS thread and the wait runs as a loop timer, so a throttled job holds no pool
+ * thread, before submit() sends the job from the pool. submit() gets the total
+ * wait so far and returns false to go round again (failover). Without rate
+ * limits both steps run as a single task.
+ */
+template <typename Result>
+class ThrottledSubmit {
+public:
+    using Prepare = std::function<ThrottleTarget()>;
+    using Submit = std::function<bool(const ThrottleTarget& target, double throttledMs, Result& result)>;
+    using Convert = std::function<Napi::Value(Napi::Env, Result&)>;
+    
+    static Napi::Promise Run(Napi::Env env, Prepare prepare, Submit submit, Convert convert) {
+        if (!core().rateLimiter->enabled()) {
+            return PromiseWorker<Result>::Run(
+                env,
+                [prepare, submit]() {
+                    Result result;
+                    while (!submit(prepare(), 0, result)) {
+                    }
+                    return result;
+                },
+                std::move(convert));
+        }
+        
+        auto state = std::make_shared<State>(env);
+        state->prepare = std::move(prepare);
+        state->submit = std::move(submit);
+        state->convert = std::move(convert);
+        Napi::Promise promise = state->deferred.Promise();
+        prepareStep(env, state);
+        return promise;
+    }
+
+private:
+    struct State {
+        explicit State(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+        
+        Napi::Promise::Deferred deferred;
+        Prepare prepare;
+        Submit submit;
+        Convert convert;
+        ThrottleTarget target;
+        Result result;
+        double throttledMs = 0;
+        bool done = false;
+    };
+    
+    static void prepareStep(Napi::Env env, std::shared_ptr<State> state) {
+        StepWorker::Run(
+            env, [state]() { state->target = state->prepare(); },
+            [state](Napi::Env env, std::exception_ptr error) {
+                if (error) {
+                    state->deferred.Reject(exceptionToJS(env, error));
+                    return;
+                }
+                
+                double waitMs = core().rateLimiter->reserve(state->target.printer, state->target.bytes);
+                auto started = std::chrono::steady_clock::now();
+                runAfter(env, waitMs, [state, waitMs, started](Napi::Env env) {
+                    if (waitMs > 0) {
+                        state->throttledMs += std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - started).count();
+                    }
+                    submitStep(env, state);
+                });
+            });
+    }
+    
+    static void submitStep(Napi::Env env, std::shared_ptr<State> state) {
+        StepWorker::Run(
+            env, [state]() { state->done = state->submit(state->target, state->throttledMs, state->result); },
+            [state](Napi::Env env, std::exception_ptr error) {
+                if (error) {
+                    state->deferred.Reject(exceptionToJS(env, error));
+                } else if (state->done) {
+                    state->deferred.Resolve(state->convert(env, state->result));
+                } else {
+                    prepareStep(env, state);
+                }
+            });
+    }
+};
+
+/**
+ * Convert per-job command results to a JavaScript array
+ */
+Napi::Array jobCommandResultsToJS(const std::vector<JobCommandResult>& results, Napi::Env env) {
+    Napi::Array arr = Napi::Array::New(env, results.size());
+    
+    for (size_t i = 0; i < results.size(); ++i) {
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("id", results[i].id);
+        entry.Set("ok", results[i].ok);
+        
+        if (!results[i].ok) {
+            Napi::Object error = Napi::Object::New(env);
+            error.Set("message", results[i].error);
+            error.Set("code", printerErrorCodeToString(results[i].errorCode));
+            entry.Set("error", error);
+        }
+        
+        arr[i] = entry;
+    }
+    
+    return arr;
+}
+
+/**
+ * Convert an accepted submission to { id, printer, throttledMs }
+ */
+Napi::Object submissionToJS(Napi::Env env, int jobId, const std::string& printer, double throttledMs) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("id", jobId);
+    result.Set("printer", printer);
+    result.Set("throttledMs", throttledMs);
+    return result;
+}
+
 // N-API function bindings
 
 Napi::Value GetPrinters(const Napi::CallbackInfo& info) {
@@ -223,7 +780,7 @@ Napi::Value GetPrinters(const Napi::CallbackInfo& info) {
     
     // Synchronous mode
     try {
-        std::vector<PrinterInfo> printers = g_printerAPI->getPrinters();
+        std::vector<PrinterInfo> printers = core().printerAPI->getPrinters();
         Napi::Array result = Napi::Array::New(env, printers.size());
         
         for (size_t i = 0; i < printers.size(); ++i) {
@@ -237,11 +794,101 @@ Napi::Value GetPrinters(const Napi::CallbackInfo& info) {
     }
 }
 
+/**
+ * Shared state between a running discovery thread and its JS handle
+ */
+struct DiscoveryState {
+    std::atomic<int> cancel{0};
+    std::thread thread;
+};
+
+Napi::Value DiscoverPrinters(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[1].IsFunction()) {
+        Napi::TypeError::New(env, "Discovery callback required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    DiscoveryOptions options;
+    if (info[0].IsObject()) {
+        Napi::Object optObj = info[0].As<Napi::Object>();
+        
+        if (optObj.Has("timeout") && optObj.Get("timeout").IsNumber()) {
+            options.timeoutMs = optObj.Get("timeout").As<Napi::Number>().Int32Value();
+        }
+        
+        if (optObj.Has("type") && optObj.Get("type").IsNumber()) {
+            options.type = optObj.Get("type").As<Napi::Number>().Uint32Value();
+        }
+        
+        if (optObj.Has("mask") && optObj.Get("mask").IsNumber()) {
+            options.mask = optObj.Get("mask").As<Napi::Number>().Uint32Value();
+        }
+    }
+    
+    auto state = std::make_shared<DiscoveryState>();
+    
+    // Callback protocol: (null, printer) per printer, (null, null) when finished, (error) on failure
+    Napi::ThreadSafeFunction tsfn = Napi::ThreadSafeFunction::New(
+        env, info[1].As<Napi::Function>(), "printerDiscovery", 0, 1,
+        [state](Napi::Env) {
+            if (state->thread.joinable()) {
+                state->thread.join();
+            }
+        });
+    
+    std::shared_ptr<NativeCore> shared = AddonData::from(env).core;
+    state->thread = std::thread([state, tsfn, options, shared]() {
+        std::unique_ptr<PrinterException> error;
+        
+        try {
+            shared->printerAPI->discoverPrinters(options, [&](const PrinterInfo& printer) {
+                PrinterInfo* found = new PrinterInfo(printer);
+                napi_status status = tsfn.BlockingCall(found, [](Napi::Env env, Napi::Function callback, PrinterInfo* data) {
+                    callback.Call({env.Null(), printerInfoToJS(*data, env)});
+                    delete data;
+                });
+                if (status != napi_ok) {
+                    delete found;
+                    return false;
+                }
+                return state->cancel.load() == 0;
+            }, state->cancel);
+        } catch (const PrinterException& e) {
+            error.reset(new PrinterException(e));
+        } catch (const std::exception& e) {
+            error.reset(new PrinterException(e.what()));
+        }
+        
+        PrinterException* failure = error.release();
+        napi_status status = tsfn.BlockingCall(failure, [](Napi::Env env, Napi::Function callback, PrinterException* data) {
+            if (data) {
+                callback.Call({createEnhancedNapiError(env, *data).Value()});
+                delete data;
+            } else {
+                callback.Call({env.Null(), env.Null()});
+            }
+        });
+        if (status != napi_ok) {
+            delete failure;
+        }
+        tsfn.Release();
+    });
+    
+    Napi::Object handle = Napi::Object::New(env);
+    handle.Set("cancel", Napi::Function::New(env, [state](const Napi::CallbackInfo& info) -> Napi::Value {
+        state->cancel.store(1);
+        return info.Env().Undefined();
+    }));
+    return handle;
+}
+
 Napi::Value GetDefaultPrinterName(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        std::string defaultName = g_printerAPI->getDefaultPrinterName();
+        std::string defaultName = core().printerAPI->getDefaultPrinterName();
         return Napi::String::New(env, defaultName);
     } catch (const std::exception& e) {
         handleException(env, e);
@@ -253,7 +900,7 @@ Napi::Value GetSupportedPrintFormats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        auto formats = g_printerAPI->getSupportedFormats();
+        auto formats = core().printerAPI->getSupportedFormats();
         Napi::Array result = Napi::Array::New(env, formats.size());
         
         for (size_t i = 0; i < formats.size(); ++i) {
@@ -277,7 +924,7 @@ Napi::Value GetPrinter(const Napi::CallbackInfo& info) {
     
     try {
         std::string name = info[0].As<Napi::String>().Utf8Value();
-        PrinterInfo printer = g_printerAPI->getPrinter(name);
+        PrinterInfo printer = core().printerAPI->getPrinter(name);
         return printerInfoToJS(printer, env);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
@@ -295,7 +942,7 @@ Napi::Value GetPrinterDriverOptions(const Napi::CallbackInfo& info) {
     
     try {
         std::string name = info[0].As<Napi::String>().Utf8Value();
-        return g_printerAPI->getDriverOptions(name, env);
+        return core().printerAPI->getDriverOptions(name, env);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -310,24 +957,39 @@ Napi::Value PrintFile(const Napi::CallbackInfo& info) {
         return env.Null();
     }
     
+    auto request = std::make_shared<PrintFileRequest>();
     try {
-        PrintFileRequest request;
-        
         // Extract filename and printer from separate arguments
-        request.filename = info[0].As<Napi::String>().Utf8Value();
-        request.printer = info[1].As<Napi::String>().Utf8Value();
+        request->filename = info[0].As<Napi::String>().Utf8Value();
+        request->printer = info[1].As<Napi::String>().Utf8Value();
         
         // Extract options from third argument if present
         if (info.Length() > 2 && info[2].IsObject()) {
-            request.options = jsTorintOptions(info[2]);
+            request->options = jsTorintOptions(info[2]);
         }
         
-        int jobId = g_jobAPI->printFile(request);
-        return Napi::Number::New(env, jobId);
+        // Extract format from fourth argument if present ("DETECT")
+        if (info.Length() > 3 && info[3].IsString()) {
+            request->format = info[3].As<Napi::String>().Utf8Value();
+        }
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
+    
+    // Submission runs off the main thread; a rate-limit wait is a timer on the event loop
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request]() { return ThrottleTarget{request->printer, fileBytes(request->filename)}; },
+        [request](const ThrottleTarget&, double throttledMs, PoolSubmission& submission) {
+            submission.printer = request->printer;
+            submission.throttledMs = throttledMs;
+            submission.jobId = core().jobAPI->printFile(*request);
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
 }
 
 Napi::Value PrintDirect(const Napi::CallbackInfo& info) {
@@ -338,134 +1000,1698 @@ Napi::Value PrintDirect(const Napi::CallbackInfo& info) {
         return env.Null();
     }
     
+    auto request = std::make_shared<PrintRawRequest>();
+    auto text = std::make_shared<std::string>();
+    std::shared_ptr<TranscodeOptions> encoding;
     try {
-        PrintRawRequest request;
-        
         // Extract data from first argument
         if (info[0].IsBuffer()) {
             Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
-            request.data.assign(buffer.Data(), buffer.Data() + buffer.Length());
+            request->data.assign(buffer.Data(), buffer.Data() + buffer.Length());
+        } else if (info[0].IsString()) {
+            *text = info[0].As<Napi::String>().Utf8Value();
         } else {
-            Napi::TypeError::New(env, "Data must be a Buffer").ThrowAsJavaScriptException();
+            Napi::TypeError::New(env, "Data must be a Buffer or a string").ThrowAsJavaScriptException();
             return env.Null();
         }
         
         // Extract printer from second argument
-        request.printer = info[1].As<Napi::String>().Utf8Value();
+        request->printer = info[1].As<Napi::String>().Utf8Value();
         
         // Extract format/type from third argument if present
         if (info.Length() > 2 && info[2].IsString()) {
-            request.format = info[2].As<Napi::String>().Utf8Value();
+            request->format = info[2].As<Napi::String>().Utf8Value();
         }
         
         // Extract options from fourth argument if present
         if (info.Length() > 3 && info[3].IsObject()) {
-            request.options = jsTorintOptions(info[3]);
+            request->options = jsTorintOptions(info[3]);
         }
         
-        int jobId = g_jobAPI->printRaw(request);
-        return Napi::Number::New(env, jobId);
+        // Extract text encoding from fifth argument if present
+        if (info.Length() > 4 && info[4].IsObject()) {
+            encoding = std::make_shared<TranscodeOptions>();
+            if (!jsToTranscodeOptions(env, info[4], *encoding)) {
+                return env.Null();
+            }
+        }
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
+    
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request, text, encoding]() {
+            // Text is transcoded on the worker straight into the job data
+            if (encoding) {
+                transcodeUtf8(reinterpret_cast<const uint8_t*>(text->data()), text->size(), *encoding, request->data);
+            } else if (!text->empty()) {
+                request->data.assign(text->begin(), text->end());
+            }
+            return ThrottleTarget{request->printer, request->data.size()};
+        },
+        [request](const ThrottleTarget&, double throttledMs, PoolSubmission& submission) {
+            submission.printer = request->printer;
+            submission.throttledMs = throttledMs;
+            submission.jobId = core().jobAPI->printRaw(*request);
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
 }
 
-Napi::Value GetJob(const Napi::CallbackInfo& info) {
+Napi::Value DetectFormat(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    if (info.Length() < 2) {
-        Napi::TypeError::New(env, "Missing arguments: printer and jobId required").ThrowAsJavaScriptException();
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Data must be a Buffer").ThrowAsJavaScriptException();
         return env.Null();
     }
     
-    try {
-        std::string printer = info[0].As<Napi::String>().Utf8Value();
-        int jobId = info[1].As<Napi::Number>().Int32Value();
-        
-        JobInfo job = g_jobAPI->getJob(printer, jobId);
-        return jobInfoToJS(job, env);
-    } catch (const std::exception& e) {
-        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-        return env.Null();
-    }
-}
-
-Napi::Value GetJobs(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
+    // Only the first SNIFF_BYTES are inspected, so this is cheap on the main thread
+    Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+    DocumentFormat format = sniffDocumentFormat(buffer.Data(), buffer.Length());
     
-    try {
-        std::string printer = "";
-        if (info.Length() > 0 && info[0].IsString()) {
-            printer = info[0].As<Napi::String>().Utf8Value();
-        }
-        
-        std::vector<JobInfo> jobs = g_jobAPI->getJobs(printer);
-        Napi::Array result = Napi::Array::New(env, jobs.size());
-        
-        for (size_t i = 0; i < jobs.size(); ++i) {
-            result[i] = jobInfoToJS(jobs[i], env);
-        }
-        
-        return result;
-    } catch (const std::exception& e) {
-        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-        return env.Null();
-    }
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("name", format.name);
+    result.Set("mimeType", format.mimeType);
+    result.Set("printerReady", format.printerReady);
+    return result;
 }
 
-Napi::Value SetJob(const Napi::CallbackInfo& info) {
+Napi::Value PrintRaster(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    if (info.Length() < 3) {
-        Napi::TypeError::New(env, "Missing arguments: printer, jobId, and command required").ThrowAsJavaScriptException();
+    // printer, pages [{ width, height, bpp, data }], { format, resolution, mediaName }, options
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsArray()) {
+        Napi::TypeError::New(env, "Missing arguments: printer and pages array required").ThrowAsJavaScriptException();
         return env.Null();
     }
     
-    try {
-        std::string printer = info[0].As<Napi::String>().Utf8Value();
-        int jobId = info[1].As<Napi::Number>().Int32Value();
-        std::string cmdStr = info[2].As<Napi::String>().Utf8Value();
-        
-        JobCommand command;
-        if (cmdStr == "pause") command = JobCommand::PAUSE;
-        else if (cmdStr == "resume") command = JobCommand::RESUME;
-        else if (cmdStr == "cancel") command = JobCommand::CANCEL;
-        else {
-            Napi::TypeError::New(env, "Invalid command. Use 'pause', 'resume', or 'cancel'").ThrowAsJavaScriptException();
+    auto pages = std::make_shared<std::vector<RasterPage>>();
+    auto raster = std::make_shared<RasterOptions>();
+    std::shared_ptr<ImageProcessing> processing;
+    auto request = std::make_shared<PrintRawRequest>();
+    request->printer = info[0].As<Napi::String>().Utf8Value();
+    
+    Napi::Array pageArray = info[1].As<Napi::Array>();
+    for (uint32_t i = 0; i < pageArray.Length(); ++i) {
+        Napi::Value value = pageArray.Get(i);
+        if (!value.IsObject()) {
+            Napi::TypeError::New(env, "Each page must be an object").ThrowAsJavaScriptException();
             return env.Null();
         }
         
-        g_jobAPI->setJob(printer, jobId, command);
-        return env.Undefined();
-    } catch (const std::exception& e) {
-        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-        return env.Null();
+        Napi::Object pageObj = value.As<Napi::Object>();
+        if (!pageObj.Get("width").IsNumber() || !pageObj.Get("height").IsNumber() || !pageObj.Get("data").IsBuffer()) {
+            Napi::TypeError::New(env, "Each page needs numeric width/height and a data Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        RasterPage page;
+        page.width = pageObj.Get("width").As<Napi::Number>().Uint32Value();
+        page.height = pageObj.Get("height").As<Napi::Number>().Uint32Value();
+        if (pageObj.Get("bpp").IsNumber()) {
+            page.bitsPerPixel = pageObj.Get("bpp").As<Napi::Number>().Uint32Value();
+        }
+        Napi::Buffer<uint8_t> data = pageObj.Get("data").As<Napi::Buffer<uint8_t>>();
+        page.data.assign(data.Data(), data.Data() + data.Length());
+        pages->push_back(std::move(page));
+    }
+    
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object rasterObj = info[2].As<Napi::Object>();
+        
+        if (rasterObj.Get("format").IsString() &&
+            !parseRasterFormat(rasterObj.Get("format").As<Napi::String>().Utf8Value(), raster->format)) {
+            Napi::TypeError::New(env, "Invalid raster format. Use 'pwg' or 'urf'").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        if (rasterObj.Get("resolution").IsNumber()) {
+            raster->xResolution = rasterObj.Get("resolution").As<Napi::Number>().Uint32Value();
+            raster->yResolution = raster->xResolution;
+        }
+        
+        if (rasterObj.Get("yResolution").IsNumber()) {
+            raster->yResolution = rasterObj.Get("yResolution").As<Napi::Number>().Uint32Value();
+        }
+        
+        if (rasterObj.Get("mediaName").IsString()) {
+            raster->mediaName = rasterObj.Get("mediaName").As<Napi::String>().Utf8Value();
+        }
+        
+        if (rasterObj.Get("process").IsObject()) {
+            Napi::Object processObj = rasterObj.Get("process").As<Napi::Object>();
+            processing = std::make_shared<ImageProcessing>();
+            
+            // URF has no bilevel pages
+            processing->bitsPerPixel = raster->format == RasterFormat::URF ? 8 : 1;
+            if (processObj.Get("bpp").IsNumber()) {
+                processing->bitsPerPixel = processObj.Get("bpp").As<Napi::Number>().Uint32Value();
+            }
+            
+            if (processObj.Get("dither").IsString() &&
+                !parseDitherMethod(processObj.Get("dither").As<Napi::String>().Utf8Value(), processing->dither)) {
+                Napi::TypeError::New(env, "Invalid dither. Use 'threshold', 'ordered' or 'floyd-steinberg'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            
+            // Fit box: explicit, or the printable size of the media at the job's resolution
+            if (!raster->mediaName.empty()) {
+                mediaSizeInPixels(raster->mediaName, raster->xResolution, raster->yResolution,
+                                  processing->maxWidth, processing->maxHeight);
+            }
+            if (processObj.Get("maxWidth").IsNumber()) {
+                processing->maxWidth = processObj.Get("maxWidth").As<Napi::Number>().Uint32Value();
+            }
+            if (processObj.Get("maxHeight").IsNumber()) {
+                processing->maxHeight = processObj.Get("maxHeight").As<Napi::Number>().Uint32Value();
+            }
+        }
+    }
+    
+    if (info.Length() > 3 && info[3].IsObject()) {
+        request->options = jsTorintOptions(info[3]);
+    }
+    
+#ifdef _WIN32
+    // The spooler only knows datatypes, not MIME types; the stream goes to the device as-is
+    request->format = "RAW";
+#else
+    request->format = rasterMimeType(raster->format);
+#endif
+    
+    // Processing and encoding run on the worker thread along with the submission
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request, pages, raster, processing]() {
+            if (processing) {
+                for (auto& page : *pages) {
+                    page = preparePage(page, *processing);
+                }
+            }
+            
+            request->data = encodeRaster(*pages, *raster);
+            pages->clear();
+            return ThrottleTarget{request->printer, request->data.size()};
+        },
+        [request](const ThrottleTarget&, double throttledMs, PoolSubmission& submission) {
+            submission.printer = request->printer;
+            submission.throttledMs = throttledMs;
+            submission.jobId = core().jobAPI->printRaw(*request);
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
+}
+
+Napi::Value PrintDocuments(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // printer, documents [path | Buffer], format, options
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsArray()) {
+        Napi::TypeError::New(env, "Missing arguments: printer and documents array required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto request = std::make_shared<PrintDocumentsRequest>();
+    request->printer = info[0].As<Napi::String>().Utf8Value();
+    
+    Napi::Array documents = info[1].As<Napi::Array>();
+    request->documents.resize(documents.Length());
+    for (uint32_t i = 0; i < documents.Length(); ++i) {
+        Napi::Value value = documents.Get(i);
+        PrintDocument& document = request->documents[i];
+        if (value.IsBuffer()) {
+            Napi::Buffer<uint8_t> buffer = value.As<Napi::Buffer<uint8_t>>();
+            document.data.assign(buffer.Data(), buffer.Data() + buffer.Length());
+        } else if (value.IsString()) {
+            document.filename = value.As<Napi::String>().Utf8Value();
+        } else {
+            Napi::TypeError::New(env, "Each document must be a Buffer or a file path").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    }
+    
+    if (info.Length() > 2 && info[2].IsString()) {
+        request->format = info[2].As<Napi::String>().Utf8Value();
+    }
+    
+    if (info.Length() > 3 && info[3].IsObject()) {
+        request->options = jsTorintOptions(info[3]);
+    }
+    
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request]() {
+            uint64_t bytes = 0;
+            for (const auto& document : request->documents) {
+                bytes += document.filename.empty() ? document.data.size() : fileBytes(document.filename);
+            }
+            return ThrottleTarget{request->printer, bytes};
+        },
+        [request](const ThrottleTarget&, double throttledMs, PoolSubmission& submission) {
+            submission.printer = request->printer;
+            submission.throttledMs = throttledMs;
+            submission.jobId = core().jobAPI->printDocuments(*request);
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
+}
+
+/**
+ * Read bytes from a string (UTF-8) or a Buffer
+ * @returns false if the value is neither
+ */
+bool jsToBytes(const Napi::Value& value, std::string& bytes) {
+    if (value.IsBuffer()) {
+        Napi::Buffer<char> buffer = value.As<Napi::Buffer<char>>();
+        bytes.assign(buffer.Data(), buffer.Length());
+        return true;
+    }
+    if (value.IsString()) {
+        bytes = value.As<Napi::String>().Utf8Value();
+        return true;
+    }
+    return false;
+}
+
+Napi::Value CompileTemplate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::string source;
+    if (info.Length() < 1 || !jsToBytes(info[0], source)) {
+        Napi::TypeError::New(env, "Template source must be a string or Buffer").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    try {
+        std::shared_ptr<PrintTemplate> compiled =
+            PrintTemplate::compile(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+        
+        AddonData& data = AddonData::from(env);
+        uint32_t id = data.nextTemplateId++;
+        data.templates[id] = compiled;
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("id", id);
+        Napi::Array fields = Napi::Array::New(env, compiled->fields().size());
+        for (size_t i = 0; i < compiled->fields().size(); ++i) {
+            fields[i] = compiled->fields()[i];
+        }
+        result.Set("fields", fields);
+        return result;
+    } catch (const PrinterException& e) {
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+}
+
+Napi::Value ReleaseTemplate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Template ID required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    return Napi::Boolean::New(env, AddonData::from(env).templates.erase(info[0].As<Napi::Number>().Uint32Value()) > 0);
+}
+
+/**
+ * Look up a template and collect its field values from an array of records
+ * Buffers are used as raw bytes, null/undefined as empty, anything else as String(value).
+ * @returns nullptr after throwing a TypeError
+ */
+std::shared_ptr<PrintTemplate> jsToTemplateRecords(const Napi::Value& id, const Napi::Value& rows,
+                                                   std::vector<std::string>& values, size_t& records) {
+    Napi::Env env = id.Env();
+    
+    std::map<uint32_t, std::shared_ptr<PrintTemplate>>& templates = AddonData::from(env).templates;
+    auto it = id.IsNumber() ? templates.find(id.As<Napi::Number>().Uint32Value()) : templates.end();
+    if (it == templates.end()) {
+        Napi::TypeError::New(env, "Unknown or released template").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    
+    if (!rows.IsArray()) {
+        Napi::TypeError::New(env, "Records must be an array").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    
+    const std::vector<std::string>& fields = it->second->fields();
+    Napi::Array rowArray = rows.As<Napi::Array>();
+    records = rowArray.Length();
+    values.resize(records * fields.size());
+    
+    for (uint32_t r = 0; r < records; ++r) {
+        Napi::Value row = rowArray.Get(r);
+        if (!row.IsObject()) {
+            Napi::TypeError::New(env, "Each record must be an object").ThrowAsJavaScriptException();
+            return nullptr;
+        }
+        
+        Napi::Object record = row.As<Napi::Object>();
+        for (size_t f = 0; f < fields.size(); ++f) {
+            Napi::Value value = record.Get(fields[f]);
+            std::string& slot = values[r * fields.size() + f];
+            if (value.IsNull() || value.IsUndefined()) {
+                continue;
+            }
+            if (!jsToBytes(value, slot)) {
+                slot = value.ToString().Utf8Value();
+            }
+        }
+    }
+    
+    return it->second;
+}
+
+/**
+ * Hand a pooled buffer to JavaScript without copying it
+ * The Buffer wraps the pooled memory directly; it returns to the pool when collected
+ */
+Napi::Value pooledBufferToJS(Napi::Env env, std::vector<uint8_t>* buffer) {
+    if (buffer->empty()) {
+        BufferPool::instance().release(std::move(*buffer));
+        delete buffer;
+        return Napi::Buffer<uint8_t>::New(env, 0);
+    }
+    
+    return Napi::Buffer<uint8_t>::New(env, buffer->data(), buffer->size(),
+        [](Napi::Env, uint8_t*, std::vector<uint8_t>* pooled) {
+            BufferPool::instance().release(std::move(*pooled));
+            delete pooled;
+        }, buffer);
+}
+
+Napi::Value RenderTemplate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // id, records, separator
+    std::vector<std::string> values;
+    size_t records = 0;
+    std::shared_ptr<PrintTemplate> compiled =
+        jsToTemplateRecords(info[0], info.Length() > 1 ? info[1] : env.Undefined(), values, records);
+    if (!compiled) {
+        return env.Null();
+    }
+    
+    std::string separator;
+    if (info.Length() > 2) {
+        jsToBytes(info[2], separator);
+    }
+    
+    auto buffer = new std::vector<uint8_t>(BufferPool::instance().acquire(0));
+    try {
+        compiled->render(values, records, separator, *buffer);
+    } catch (const PrinterException& e) {
+        BufferPool::instance().release(std::move(*buffer));
+        delete buffer;
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    
+    return pooledBufferToJS(env, buffer);
+}
+
+Napi::Value Transcode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // text, { codePage, unmappable, replacement }
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Missing arguments: text and encoding required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    TranscodeOptions options;
+    if (!jsToTranscodeOptions(env, info[1], options)) {
+        return env.Null();
+    }
+    
+    std::string text = info[0].As<Napi::String>().Utf8Value();
+    auto buffer = new std::vector<uint8_t>(BufferPool::instance().acquire(text.size()));
+    try {
+        transcodeUtf8(reinterpret_cast<const uint8_t*>(text.data()), text.size(), options, *buffer);
+    } catch (const PrinterException& e) {
+        BufferPool::instance().release(std::move(*buffer));
+        delete buffer;
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    
+    return pooledBufferToJS(env, buffer);
+}
+
+Napi::Value PrintTemplateJob(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // printer, id, records, separator, format, options
+    if (info.Length() < 3 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Missing arguments: printer, template and records required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto values = std::make_shared<std::vector<std::string>>();
+    size_t records = 0;
+    std::shared_ptr<PrintTemplate> compiled = jsToTemplateRecords(info[1], info[2], *values, records);
+    if (!compiled) {
+        return env.Null();
+    }
+    
+    auto separator = std::make_shared<std::string>();
+    if (info.Length() > 3) {
+        jsToBytes(info[3], *separator);
+    }
+    
+    auto request = std::make_shared<PrintRawRequest>();
+    request->printer = info[0].As<Napi::String>().Utf8Value();
+    if (info.Length() > 4 && info[4].IsString()) {
+        request->format = info[4].As<Napi::String>().Utf8Value();
+    }
+    if (info.Length() > 5 && info[5].IsObject()) {
+        request->options = jsTorintOptions(info[5]);
+    }
+    
+    // All records are rendered into one pooled buffer and submitted as a single job
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request, compiled, values, records, separator]() {
+            request->data = BufferPool::instance().acquire(0);
+            try {
+                compiled->render(*values, records, *separator, request->data);
+            } catch (...) {
+                BufferPool::instance().release(std::move(request->data));
+                throw;
+            }
+            return ThrottleTarget{request->printer, request->data.size()};
+        },
+        [request](const ThrottleTarget&, double throttledMs, PoolSubmission& submission) {
+            submission.printer = request->printer;
+            submission.throttledMs = throttledMs;
+            try {
+                submission.jobId = core().jobAPI->printRaw(*request);
+            } catch (...) {
+                BufferPool::instance().release(std::move(request->data));
+                throw;
+            }
+            BufferPool::instance().release(std::move(request->data));
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
+}
+
+/**
+ * Parse (printers, source, format, options) shared by pool, failover and queued submissions
+ * printers is an array or a single name; source is a Buffer for raw data or a string file path
+ * @returns false after throwing a TypeError
+ */
+bool jsToPoolSubmitRequest(const Napi::CallbackInfo& info, PoolSubmitRequest& request) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !(info[0].IsArray() || info[0].IsString())) {
+        Napi::TypeError::New(env, "Missing arguments: printer(s) and data or file required").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    if (info[0].IsString()) {
+        request.printers.push_back(info[0].As<Napi::String>().Utf8Value());
+    } else {
+        Napi::Array printers = info[0].As<Napi::Array>();
+        for (uint32_t i = 0; i < printers.Length(); ++i) {
+            Napi::Value printer = printers.Get(i);
+            if (!printer.IsString()) {
+                Napi::TypeError::New(env, "Printer names must be strings").ThrowAsJavaScriptException();
+                return false;
+            }
+            request.printers.push_back(printer.As<Napi::String>().Utf8Value());
+        }
+    }
+    
+    if (request.printers.empty()) {
+        Napi::TypeError::New(env, "At least one printer is required").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    if (info[1].IsBuffer()) {
+        Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
+        request.raw = true;
+        request.data.assign(buffer.Data(), buffer.Data() + buffer.Length());
+    } else if (info[1].IsString()) {
+        request.filename = info[1].As<Napi::String>().Utf8Value();
+    } else {
+        Napi::TypeError::New(env, "Data must be a Buffer or a file path").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    if (info.Length() > 2 && info[2].IsString()) {
+        request.format = info[2].As<Napi::String>().Utf8Value();
+    }
+    
+    if (info.Length() > 3 && info[3].IsObject()) {
+        request.options = jsTorintOptions(info[3]);
+    }
+    
+    return true;
+}
+
+Napi::Value SubmitToPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // printers, source, format, options, strategy
+    auto request = std::make_shared<PoolSubmitRequest>();
+    if (!jsToPoolSubmitRequest(info, *request)) {
+        return env.Null();
+    }
+    
+    if (info.Length() > 4 && info[4].IsString() &&
+        !parsePoolStrategy(info[4].As<Napi::String>().Utf8Value(), request->strategy)) {
+        Napi::TypeError::New(env, "Invalid strategy. Use 'least-queued', 'least-bytes', or 'round-robin'").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // The chosen printer's slot stays reserved while throttled, so the wait counts as load on it
+    return ThrottledSubmit<PoolSubmission>::Run(
+        env,
+        [request]() {
+            NativeCore& shared = core();
+            uint64_t bytes = requestBytes(*request);
+            return ThrottleTarget{
+                choosePoolPrinter(*shared.poolScheduler, *request, bytes, shared.printerHealth.get()), bytes};
+        },
+        [request](const ThrottleTarget& target, double throttledMs, PoolSubmission& submission) {
+            NativeCore& shared = core();
+            submission.printer = target.printer;
+            submission.throttledMs = throttledMs;
+            submission.jobId = submitToChosen(*shared.jobAPI, *shared.poolScheduler, target.printer, *request,
+                                              target.bytes, shared.printerHealth.get());
+            return true;
+        },
+        [](Napi::Env env, PoolSubmission& submission) -> Napi::Value {
+            return submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+        });
+}
+
+/**
+ * Progress of one failover submission across its steps
+ */
+struct FailoverState {
+    std::unique_ptr<FailoverPlan> plan;
+    uint64_t bytes = 0;
+};
+
+Napi::Value PrintWithFailover(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // printers (primary first, then fallbacks in order), source, format, options
+    auto request = std::make_shared<PoolSubmitRequest>();
+    if (!jsToPoolSubmitRequest(info, *request)) {
+        return env.Null();
+    }
+    
+    // Each candidate is chosen, throttled and submitted in turn until one takes the job
+    auto failover = std::make_shared<FailoverState>();
+    return ThrottledSubmit<FailoverSubmission>::Run(
+        env,
+        [request, failover]() {
+            if (!failover->plan) {
+                failover->bytes = requestBytes(*request);
+                failover->plan.reset(new FailoverPlan(*core().printerHealth, request->printers));
+            }
+            return ThrottleTarget{failover->plan->next(), failover->bytes};
+        },
+        [request, failover](const ThrottleTarget& target, double throttledMs, FailoverSubmission& submission) {
+            try {
+                submission = failover->plan->accepted(submitTo(*core().jobAPI, target.printer, *request));
+            } catch (const PrinterException& e) {
+                if (!failover->plan->failed(e)) {
+                    throw;
+                }
+                return false;
+            }
+            submission.throttledMs = throttledMs;
+            return true;
+        },
+        [](Napi::Env env, FailoverSubmission& submission) -> Napi::Value {
+            Napi::Object result = submissionToJS(env, submission.jobId, submission.printer, submission.throttledMs);
+            
+            Napi::Array skipped = Napi::Array::New(env, submission.skipped.size());
+            for (size_t i = 0; i < submission.skipped.size(); ++i) {
+                Napi::Object entry = Napi::Object::New(env);
+                entry.Set("printer", submission.skipped[i].first);
+                entry.Set("reason", submission.skipped[i].second);
+                skipped[i] = entry;
+            }
+            result.Set("skipped", skipped);
+            return result;
+        });
+}
+
+/**
+ * Outcome of a queued submission or ready() wait, settled on the queuing environment's thread
+ */
+struct QueueCompletion {
+    QueueCompletion(Napi::Env env, std::shared_ptr<QueueChannel> channel)
+        : deferred(Napi::Promise::Deferred::New(env)), channel(std::move(channel)) {}
+    
+    Napi::Promise::Deferred deferred;
+    std::shared_ptr<QueueChannel> channel;
+    bool readyOnly = false;
+    int jobId = 0;
+    std::string printer;
+    double throttledMs = 0;
+    std::unique_ptr<PrinterException> error;
+};
+
+// One thread-safe function per environment settles its queue promises. It only
+// keeps the event loop alive while promises are outstanding.
+QueueCompletion* newQueueCompletion(Napi::Env env) {
+    std::shared_ptr<QueueChannel> channel = AddonData::from(env).queue;
+    
+    if (!channel->created) {
+        channel->callback = Napi::ThreadSafeFunction::New(
+            env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "submissionQueue", 0, 1,
+            new std::shared_ptr<QueueChannel>(channel),
+            [](Napi::Env, std::shared_ptr<QueueChannel>* finalized) {
+                {
+                    std::lock_guard<std::mutex> lock((*finalized)->mutex);
+                    (*finalized)->open = false;
+                }
+                delete finalized;
+            });
+        channel->callback.Unref(env);
+        channel->created = true;
+        channel->open = true;
+    }
+    
+    if (channel->outstanding++ == 0) {
+        channel->callback.Ref(env);
+    }
+    return new QueueCompletion(env, channel);
+}
+
+void settleQueueCompletion(Napi::Env env, QueueCompletion* completion) {
+    if (completion->error) {
+        completion->deferred.Reject(createEnhancedNapiError(env, *completion->error).Value());
+    } else if (completion->readyOnly) {
+        completion->deferred.Resolve(env.Undefined());
+    } else {
+        completion->deferred.Resolve(
+            submissionToJS(env, completion->jobId, completion->printer, completion->throttledMs));
+    }
+    std::shared_ptr<QueueChannel> channel = std::move(completion->channel);
+    delete completion;
+    
+    if (--channel->outstanding == 0) {
+        channel->callback.Unref(env);
+    }
+}
+
+/**
+ * Hand a completion from a queue thread back to the environment that queued it
+ * Dropped if that environment has shut down.
+ */
+void postQueueCompletion(QueueCompletion* completion) {
+    std::shared_ptr<QueueChannel> channel = completion->channel;
+    std::lock_guard<std::mutex> lock(channel->mutex);
+    
+    napi_status status = napi_closing;
+    if (channel->open) {
+        status = channel->callback.BlockingCall(completion,
+            [](Napi::Env env, Napi::Function, QueueCompletion* data) {
+                settleQueueCompletion(env, data);
+            });
+    }
+    if (status != napi_ok) {
+        delete completion;
+    }
+}
+
+Napi::Value EnqueueJob(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // printer, source (Buffer or file path), format, options
+    auto request = std::make_shared<PoolSubmitRequest>();
+    if (!jsToPoolSubmitRequest(info, *request)) {
+        return env.Null();
+    }
+    
+    uint64_t bytes = 0;
+    try {
+        bytes = requestBytes(*request);
+    } catch (const PrinterException& e) {
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    
+    const std::string& printer = request->printers[0];
+    QueueCompletion* completion = newQueueCompletion(env);
+    Napi::Promise promise = completion->deferred.Promise();
+    completion->printer = printer;
+    
+    // Queue threads outlive the current-core pointer, which ~NativeCore clears before the
+    // queue drains; the queue is a member of the core, so capturing the core itself is safe
+    NativeCore* owner = &core();
+    bool queued = owner->submissionQueue->enqueue(printer, bytes, [owner, request, completion](double throttledMs) {
+        completion->throttledMs = throttledMs;
+        try {
+            completion->jobId = submitTo(*owner->jobAPI, completion->printer, *request);
+        } catch (const PrinterException& e) {
+            completion->error.reset(new PrinterException(e));
+        } catch (const std::exception& e) {
+            completion->error.reset(new PrinterException(e.what()));
+        }
+        int jobId = completion->error ? 0 : completion->jobId;
+        postQueueCompletion(completion);
+        return jobId;
+    }, [completion]() {
+        completion->error.reset(new PrinterException("Submission queue shut down before the job was sent"));
+        postQueueCompletion(completion);
+    });
+    
+    if (!queued) {
+        completion->error.reset(new PrinterException("Submission queue for " + printer + " is full",
+                                                     PrinterErrorCode::QUEUE_FULL));
+        settleQueueCompletion(env, completion);
+    }
+    
+    return promise;
+}
+
+Napi::Value QueueReady(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Printer name required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    QueueCompletion* completion = newQueueCompletion(env);
+    completion->readyOnly = true;
+    Napi::Promise promise = completion->deferred.Promise();
+    
+    std::string printer = info[0].As<Napi::String>().Utf8Value();
+    if (core().submissionQueue->whenReady(printer, [completion]() { postQueueCompletion(completion); })) {
+        settleQueueCompletion(env, completion);
+    }
+    
+    return promise;
+}
+
+Napi::Value GetJob(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Missing arguments: printer and jobId required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string printer = info[0].As<Napi::String>().Utf8Value();
+    int jobId = info[1].As<Napi::Number>().Int32Value();
+    
+    return PromiseWorker<JobInfo>::Run(
+        env,
+        [printer, jobId]() { return core().jobAPI->getJob(printer, jobId); },
+        [](Napi::Env env, JobInfo& job) -> Napi::Value {
+            return jobInfoToJS(job, env);
+        });
+}
+
+Napi::Value GetJobs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::string printer = "";
+    if (info.Length() > 0 && info[0].IsString()) {
+        printer = info[0].As<Napi::String>().Utf8Value();
+    }
+    
+    return PromiseWorker<std::vector<JobInfo>>::Run(
+        env,
+        [printer]() { return core().jobAPI->getJobs(printer); },
+        [](Napi::Env env, std::vector<JobInfo>& jobs) -> Napi::Value {
+            Napi::Array result = Napi::Array::New(env, jobs.size());
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                result[i] = jobInfoToJS(jobs[i], env);
+            }
+            return result;
+        });
+}
+
+Napi::Value GetJobsSnapshot(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::string printer = "";
+    if (info.Length() > 0 && info[0].IsString()) {
+        printer = info[0].As<Napi::String>().Utf8Value();
+    }
+    
+    return PromiseWorker<std::vector<JobInfo>>::Run(
+        env,
+        [printer]() { return core().jobAPI->getJobs(printer); },
+        [](Napi::Env env, std::vector<JobInfo>& jobs) -> Napi::Value {
+            return JobSnapshot::New(env, std::move(jobs));
+        });
+}
+
+Napi::Value GetJobsPage(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    JobPageRequest request;
+    if (info.Length() > 0 && info[0].IsString()) {
+        request.printer = info[0].As<Napi::String>().Utf8Value();
+    }
+    
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object optObj = info[1].As<Napi::Object>();
+        
+        if (!jsToWhichJobs(env, optObj.Get("which"), request.which)) {
+            return env.Null();
+        }
+        
+        if (optObj.Has("cursor") && optObj.Get("cursor").IsNumber()) {
+            request.cursor = std::max(0, optObj.Get("cursor").As<Napi::Number>().Int32Value());
+        }
+        
+        if (optObj.Has("limit") && optObj.Get("limit").IsNumber()) {
+            request.limit = std::max(1, optObj.Get("limit").As<Napi::Number>().Int32Value());
+        }
+    }
+    
+    return PromiseWorker<JobPage>::Run(
+        env,
+        [request]() { return core().jobAPI->getJobsPage(request); },
+        [](Napi::Env env, JobPage& page) -> Napi::Value {
+            Napi::Array jobs = Napi::Array::New(env, page.jobs.size());
+            for (size_t i = 0; i < page.jobs.size(); ++i) {
+                jobs[i] = jobInfoToJS(page.jobs[i], env);
+            }
+            
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("jobs", jobs);
+            result.Set("nextCursor", page.nextCursor);
+            return result;
+        });
+}
+
+/**
+ * Every printer's jobs in one call: [{ printer, jobs, error? }]
+ * With lazy: true each group's jobs is a JobSnapshot instead of an array.
+ */
+Napi::Value GetAllJobs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    AllJobsRequest request;
+    bool lazy = false;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object optObj = info[0].As<Napi::Object>();
+        
+        if (!jsToWhichJobs(env, optObj.Get("which"), request.which)) {
+            return env.Null();
+        }
+        
+        if (optObj.Has("limit") && optObj.Get("limit").IsNumber()) {
+            request.limit = std::max(0, optObj.Get("limit").As<Napi::Number>().Int32Value());
+        }
+        
+        if (optObj.Has("lazy") && optObj.Get("lazy").IsBoolean()) {
+            lazy = optObj.Get("lazy").As<Napi::Boolean>().Value();
+        }
+    }
+    
+    return PromiseWorker<std::vector<PrinterJobs>>::Run(
+        env,
+        [request]() { return core().jobAPI->getAllJobs(request); },
+        [lazy](Napi::Env env, std::vector<PrinterJobs>& groups) -> Napi::Value {
+            Napi::Array result = Napi::Array::New(env, groups.size());
+            for (size_t i = 0; i < groups.size(); ++i) {
+                Napi::Object group = Napi::Object::New(env);
+                group.Set("printer", groups[i].printer);
+                
+                if (lazy) {
+                    group.Set("jobs", JobSnapshot::New(env, std::move(groups[i].jobs)));
+                } else {
+                    Napi::Array jobs = Napi::Array::New(env, groups[i].jobs.size());
+                    for (size_t j = 0; j < groups[i].jobs.size(); ++j) {
+                        jobs[j] = jobInfoToJS(groups[i].jobs[j], env);
+                    }
+                    group.Set("jobs", jobs);
+                }
+                
+                if (!groups[i].error.empty()) {
+                    Napi::Object error = Napi::Object::New(env);
+                    error.Set("message", groups[i].error);
+                    error.Set("code", printerErrorCodeToString(groups[i].errorCode));
+                    group.Set("error", error);
+                }
+                result[i] = group;
+            }
+            return result;
+        });
+}
+
+Napi::Value GetJobsBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array of { printer, id } required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Array jsRefs = info[0].As<Napi::Array>();
+    std::vector<JobRef> refs;
+    refs.reserve(jsRefs.Length());
+    
+    for (uint32_t i = 0; i < jsRefs.Length(); ++i) {
+        Napi::Value item = jsRefs.Get(i);
+        if (!item.IsObject()) {
+            Napi::TypeError::New(env, "Each job reference must be an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Object refObj = item.As<Napi::Object>();
+        JobRef ref;
+        if (refObj.Get("printer").IsString()) {
+            ref.printer = refObj.Get("printer").As<Napi::String>().Utf8Value();
+        }
+        if (refObj.Get("id").IsNumber()) {
+            ref.id = refObj.Get("id").As<Napi::Number>().Int32Value();
+        }
+        refs.push_back(std::move(ref));
+    }
+    
+    return PromiseWorker<std::vector<JobLookup>>::Run(
+        env,
+        [refs]() { return core().jobAPI->getJobsBatch(refs); },
+        [](Napi::Env env, std::vector<JobLookup>& results) -> Napi::Value {
+            Napi::Array result = Napi::Array::New(env, results.size());
+            
+            for (size_t i = 0; i < results.size(); ++i) {
+                const JobLookup& lookup = results[i];
+                Napi::Object entry = Napi::Object::New(env);
+                entry.Set("printer", lookup.ref.printer);
+                entry.Set("id", lookup.ref.id);
+                
+                if (lookup.found) {
+                    entry.Set("job", jobInfoToJS(lookup.info, env));
+                } else {
+                    Napi::Object error = Napi::Object::New(env);
+                    error.Set("message", lookup.error);
+                    error.Set("code", printerErrorCodeToString(lookup.errorCode));
+                    entry.Set("error", error);
+                }
+                
+                result[i] = entry;
+            }
+            
+            return result;
+        });
+}
+
+Napi::Value CancelJobs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsArray()) {
+        Napi::TypeError::New(env, "Missing arguments: printer and array of job IDs required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string printer = info[0].As<Napi::String>().Utf8Value();
+    Napi::Array jsIds = info[1].As<Napi::Array>();
+    std::vector<int> ids;
+    ids.reserve(jsIds.Length());
+    
+    for (uint32_t i = 0; i < jsIds.Length(); ++i) {
+        Napi::Value id = jsIds.Get(i);
+        if (!id.IsNumber()) {
+            Napi::TypeError::New(env, "Job IDs must be numbers").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        ids.push_back(id.As<Napi::Number>().Int32Value());
+    }
+    
+    return PromiseWorker<std::vector<JobCommandResult>>::Run(
+        env,
+        [printer, ids]() { return core().jobAPI->cancelJobs(printer, ids); },
+        [](Napi::Env env, std::vector<JobCommandResult>& results) -> Napi::Value {
+            return jobCommandResultsToJS(results, env);
+        });
+}
+
+Napi::Value PurgeJobs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Printer name required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    PurgeRequest request;
+    request.printer = info[0].As<Napi::String>().Utf8Value();
+    
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object optObj = info[1].As<Napi::Object>();
+        
+        if (optObj.Has("which") && optObj.Get("which").IsString()) {
+            std::string which = optObj.Get("which").As<Napi::String>().Utf8Value();
+            if (which == "all") request.scope = PurgeScope::ALL;
+            else if (which == "active") request.scope = PurgeScope::ACTIVE;
+            else {
+                Napi::TypeError::New(env, "Invalid 'which'. Use 'active' or 'all'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+        
+        if (optObj.Has("user") && optObj.Get("user").IsString()) {
+            request.user = optObj.Get("user").As<Napi::String>().Utf8Value();
+        }
+    }
+    
+    return PromiseWorker<std::vector<JobCommandResult>>::Run(
+        env,
+        [request]() { return core().jobAPI->purgeJobs(request); },
+        [](Napi::Env env, std::vector<JobCommandResult>& results) -> Napi::Value {
+            return jobCommandResultsToJS(results, env);
+        });
+}
+
+Napi::Value SetJob(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsNumber() || !info[2].IsString()) {
+        Napi::TypeError::New(env, "Missing arguments: printer, jobId, and command required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string printer = info[0].As<Napi::String>().Utf8Value();
+    int jobId = info[1].As<Napi::Number>().Int32Value();
+    std::string cmdStr = info[2].As<Napi::String>().Utf8Value();
+    
+    JobCommand command;
+    if (cmdStr == "pause") command = JobCommand::PAUSE;
+    else if (cmdStr == "resume") command = JobCommand::RESUME;
+    else if (cmdStr == "cancel") command = JobCommand::CANCEL;
+    else {
+        Napi::TypeError::New(env, "Invalid command. Use 'pause', 'resume', or 'cancel'").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    return PromiseWorker<bool>::Run(
+        env,
+        [printer, jobId, command]() {
+            core().jobAPI->setJob(printer, jobId, command);
+            return true;
+        },
+        [](Napi::Env env, bool&) -> Napi::Value {
+            return env.Undefined();
+        });
+}
+
+Napi::Value UpdateJob(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsNumber() || !info[2].IsObject()) {
+        Napi::TypeError::New(env, "Missing arguments: printer, jobId, and { priority, holdUntil } required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string printer = info[0].As<Napi::String>().Utf8Value();
+    int jobId = info[1].As<Napi::Number>().Int32Value();
+    Napi::Object updateObj = info[2].As<Napi::Object>();
+    
+    JobUpdate update;
+    if (updateObj.Has("priority") && updateObj.Get("priority").IsNumber()) {
+        update.priority = updateObj.Get("priority").As<Napi::Number>().Int32Value();
+    }
+    if (updateObj.Has("holdUntil") && updateObj.Get("holdUntil").IsString()) {
+        update.holdUntil = updateObj.Get("holdUntil").As<Napi::String>().Utf8Value();
+    }
+    
+    return PromiseWorker<bool>::Run(
+        env,
+        [printer, jobId, update]() {
+            core().jobAPI->updateJob(printer, jobId, update);
+            return true;
+        },
+        [](Napi::Env env, bool&) -> Napi::Value {
+            return env.Undefined();
+        });
+}
+
+/**
+ * Create the platform backends and prime the health cache from one printer listing
+ * Optional: everything is created on first use anyway. Resolves with the number of printers seen.
+ */
+Napi::Value Warmup(const Napi::CallbackInfo& info) {
+    return PromiseWorker<size_t>::Run(
+        info.Env(),
+        []() {
+            NativeCore& shared = core();
+            std::vector<PrinterInfo> printers = shared.printerAPI->getPrinters();
+            shared.jobAPI.get();
+            shared.printerHealth->prime(printers);
+            return printers.size();
+        },
+        [](Napi::Env env, size_t& count) -> Napi::Value {
+            return Napi::Number::New(env, static_cast<double>(count));
+        });
+}
+
+Napi::Value GetMetrics(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object metrics = Napi::Object::New(env);
+    
+#ifndef _WIN32
+    ConnectionPoolStats poolStats = CupsConnectionPool::instance().getStats();
+    Napi::Object pool = Napi::Object::New(env);
+    pool.Set("hits", static_cast<double>(poolStats.hits));
+    pool.Set("creates", static_cast<double>(poolStats.creates));
+    pool.Set("failures", static_cast<double>(poolStats.failures));
+    pool.Set("reconnects", static_cast<double>(poolStats.reconnects));
+    pool.Set("reaped", static_cast<double>(poolStats.reaped));
+    pool.Set("waits", static_cast<double>(poolStats.waits));
+    pool.Set("idle", static_cast<double>(poolStats.idle));
+    pool.Set("inUse", static_cast<double>(poolStats.inUse));
+    metrics.Set("connectionPool", pool);
+#endif
+    
+    std::vector<PrinterLoad> loads = core().poolScheduler->snapshot();
+    Napi::Array printerLoads = Napi::Array::New(env, loads.size());
+    for (size_t i = 0; i < loads.size(); ++i) {
+        Napi::Object load = Napi::Object::New(env);
+        load.Set("printer", loads[i].printer);
+        load.Set("queuedJobs", loads[i].queuedJobs);
+        load.Set("queuedBytes", static_cast<double>(loads[i].queuedBytes));
+        load.Set("inFlight", loads[i].inFlight);
+        printerLoads[i] = load;
+    }
+    metrics.Set("printerPool", printerLoads);
+    
+    std::vector<SubmissionQueueStats> queueStats = core().submissionQueue->getStats();
+    Napi::Array queues = Napi::Array::New(env, queueStats.size());
+    for (size_t i = 0; i < queueStats.size(); ++i) {
+        Napi::Object queue = Napi::Object::New(env);
+        queue.Set("printer", queueStats[i].printer);
+        queue.Set("queued", static_cast<double>(queueStats[i].queued));
+        queue.Set("inFlight", static_cast<double>(queueStats[i].inFlight));
+        queue.Set("queuedBytes", static_cast<double>(queueStats[i].queuedBytes));
+        queue.Set("submitted", static_cast<double>(queueStats[i].submitted));
+        queue.Set("failed", static_cast<double>(queueStats[i].failed));
+        queue.Set("rejected", static_cast<double>(queueStats[i].rejected));
+        queue.Set("limit", queueStats[i].limit);
+        queue.Set("latencyMs", queueStats[i].latencyMs);
+        queue.Set("baselineLatencyMs", queueStats[i].baselineLatencyMs);
+        queue.Set("errorRate", queueStats[i].errorRate);
+        queue.Set("completionMs", queueStats[i].completionMs);
+        queue.Set("decreases", static_cast<double>(queueStats[i].decreases));
+        if (!queueStats[i].throttleReason.empty()) {
+            queue.Set("throttleReason", queueStats[i].throttleReason);
+        }
+        queues[i] = queue;
+    }
+    metrics.Set("submissionQueue", queues);
+    
+    std::vector<RateLimiterStats> rateStats = core().rateLimiter->getStats();
+    Napi::Array rateLimits = Napi::Array::New(env, rateStats.size());
+    for (size_t i = 0; i < rateStats.size(); ++i) {
+        Napi::Object limit = Napi::Object::New(env);
+        limit.Set(rateStats[i].server ? "server" : "printer", rateStats[i].name);
+        limit.Set("throttled", static_cast<double>(rateStats[i].throttled));
+        limit.Set("throttledMs", rateStats[i].throttledMs);
+        rateLimits[i] = limit;
+    }
+    metrics.Set("rateLimits", rateLimits);
+    
+    RetryStats retryStats = core().retry->getStats();
+    Napi::Object retry = Napi::Object::New(env);
+    retry.Set("operations", static_cast<double>(retryStats.operations));
+    retry.Set("attempts", static_cast<double>(retryStats.attempts));
+    retry.Set("retries", static_cast<double>(retryStats.retries));
+    retry.Set("recovered", static_cast<double>(retryStats.recovered));
+    retry.Set("exhausted", static_cast<double>(retryStats.exhausted));
+    retry.Set("backoffMs", retryStats.backoffMs);
+    Napi::Array succeededOnAttempt = Napi::Array::New(env, retryStats.succeededOnAttempt.size());
+    for (size_t i = 0; i < retryStats.succeededOnAttempt.size(); ++i) {
+        succeededOnAttempt[i] = static_cast<double>(retryStats.succeededOnAttempt[i]);
+    }
+    retry.Set("succeededOnAttempt", succeededOnAttempt);
+    Napi::Object retriedStatuses = Napi::Object::New(env);
+    for (const auto& entry : retryStats.retriedStatuses) {
+        retriedStatuses.Set(std::to_string(entry.first), static_cast<double>(entry.second));
+    }
+    retry.Set("retriedStatuses", retriedStatuses);
+    metrics.Set("retry", retry);
+    
+    // Which lazily created parts of the core exist yet
+    Napi::Object backends = Napi::Object::New(env);
+    backends.Set("printers", core().printerAPI.created());
+    backends.Set("jobs", core().jobAPI.created());
+    backends.Set("healthCache", core().printerHealth.created());
+    metrics.Set("backends", backends);
+    
+    PrinterStateTableStats tableStats;
+    if (core().stateTableStats(tableStats)) {
+        Napi::Object stateTable = Napi::Object::New(env);
+        stateTable.Set("polls", static_cast<double>(tableStats.polls));
+        stateTable.Set("pollErrors", static_cast<double>(tableStats.pollErrors));
+        stateTable.Set("changes", static_cast<double>(tableStats.changes));
+        stateTable.Set("printers", tableStats.printers);
+        stateTable.Set("dropped", tableStats.dropped);
+        metrics.Set("stateTable", stateTable);
+    }
+    
+    LedgerStats ledgerStats = core().ledger->getStats();
+    if (ledgerStats.open) {
+        Napi::Object ledger = Napi::Object::New(env);
+        ledger.Set("records", static_cast<double>(ledgerStats.records));
+        ledger.Set("usedBytes", static_cast<double>(ledgerStats.usedBytes));
+        ledger.Set("capacityBytes", static_cast<double>(ledgerStats.capacityBytes));
+        ledger.Set("writeErrors", static_cast<double>(ledgerStats.writeErrors));
+        metrics.Set("ledger", ledger);
+    }
+    
+    Napi::Object bufferPool = Napi::Object::New(env);
+    bufferPool.Set("hits", static_cast<double>(BufferPool::instance().hits()));
+    bufferPool.Set("misses", static_cast<double>(BufferPool::instance().misses()));
+    metrics.Set("templateBuffers", bufferPool);
+    
+    return metrics;
+}
+
+Napi::Value ConfigureConnectionPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Connection pool options object required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+#ifndef _WIN32
+    Napi::Object optObj = info[0].As<Napi::Object>();
+    CupsConnectionPool::Config config = CupsConnectionPool::instance().getConfig();
+    
+    if (optObj.Has("maxPerServer") && optObj.Get("maxPerServer").IsNumber()) {
+        config.maxPerServer = optObj.Get("maxPerServer").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (optObj.Has("idleTimeoutMs") && optObj.Get("idleTimeoutMs").IsNumber()) {
+        config.idleTimeoutMs = optObj.Get("idleTimeoutMs").As<Napi::Number>().Int32Value();
+    }
+    
+    if (optObj.Has("connectTimeoutMs") && optObj.Get("connectTimeoutMs").IsNumber()) {
+        config.connectTimeoutMs = optObj.Get("connectTimeoutMs").As<Napi::Number>().Int32Value();
+    }
+    
+    if (optObj.Has("connectAttempts") && optObj.Get("connectAttempts").IsNumber()) {
+        config.connectAttempts = optObj.Get("connectAttempts").As<Napi::Number>().Int32Value();
+    }
+    
+    if (optObj.Has("maxBackoffMs") && optObj.Get("maxBackoffMs").IsNumber()) {
+        config.maxBackoffMs = optObj.Get("maxBackoffMs").As<Napi::Number>().Int32Value();
+    }
+    
+    CupsConnectionPool::instance().configure(config);
+    CupsConnectionPool::instance().reapIdle();
+#endif
+    
+    return env.Undefined();
+}
+
+Napi::Value ConfigureSubmissionQueue(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Submission queue options object required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Object optObj = info[0].As<Napi::Object>();
+    SubmissionQueueConfig config = core().submissionQueue->getConfig();
+    
+    if (optObj.Has("maxInFlight") && optObj.Get("maxInFlight").IsNumber()) {
+        config.maxInFlight = optObj.Get("maxInFlight").As<Napi::Number>().Uint32Value();
     }
+    
+    if (optObj.Has("maxQueuedBytes") && optObj.Get("maxQueuedBytes").IsNumber()) {
+        config.maxQueuedBytes = static_cast<uint64_t>(optObj.Get("maxQueuedBytes").As<Napi::Number>().Int64Value());
+    }
+    
+    if (optObj.Has("maxQueuedJobs") && optObj.Get("maxQueuedJobs").IsNumber()) {
+        config.maxQueuedJobs = optObj.Get("maxQueuedJobs").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (optObj.Has("workers") && optObj.Get("workers").IsNumber()) {
+        config.workers = optObj.Get("workers").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (optObj.Has("adaptive") && optObj.Get("adaptive").IsBoolean()) {
+        config.adaptive = optObj.Get("adaptive").As<Napi::Boolean>().Value();
+    }
+    
+    if (optObj.Has("initialInFlight") && optObj.Get("initialInFlight").IsNumber()) {
+        config.initialInFlight = optObj.Get("initialInFlight").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (optObj.Has("latencyTolerance") && optObj.Get("latencyTolerance").IsNumber()) {
+        config.latencyTolerance = optObj.Get("latencyTolerance").As<Napi::Number>().DoubleValue();
+    }
+    
+    core().submissionQueue->configure(config);
+    return env.Undefined();
+}
+
+/**
+ * Read { jobsPerSecond, bytesPerSecond, burstJobs, burstBytes }
+ */
+RateLimit jsToRateLimit(const Napi::Value& value) {
+    RateLimit limit;
+    if (!value.IsObject()) {
+        return limit;
+    }
+    
+    Napi::Object obj = value.As<Napi::Object>();
+    if (obj.Has("jobsPerSecond") && obj.Get("jobsPerSecond").IsNumber()) {
+        limit.jobsPerSecond = obj.Get("jobsPerSecond").As<Napi::Number>().DoubleValue();
+    }
+    if (obj.Has("bytesPerSecond") && obj.Get("bytesPerSecond").IsNumber()) {
+        limit.bytesPerSecond = obj.Get("bytesPerSecond").As<Napi::Number>().DoubleValue();
+    }
+    if (obj.Has("burstJobs") && obj.Get("burstJobs").IsNumber()) {
+        limit.burstJobs = obj.Get("burstJobs").As<Napi::Number>().DoubleValue();
+    }
+    if (obj.Has("burstBytes") && obj.Get("burstBytes").IsNumber()) {
+        limit.burstBytes = obj.Get("burstBytes").As<Napi::Number>().DoubleValue();
+    }
+    return limit;
+}
+
+/**
+ * Read { name: { jobsPerSecond, ... }, ... }
+ */
+std::map<std::string, RateLimit> jsToRateLimitMap(const Napi::Value& value) {
+    std::map<std::string, RateLimit> limits;
+    if (!value.IsObject()) {
+        return limits;
+    }
+    
+    Napi::Object obj = value.As<Napi::Object>();
+    Napi::Array names = obj.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); ++i) {
+        std::string name = names.Get(i).As<Napi::String>().Utf8Value();
+        limits[name] = jsToRateLimit(obj.Get(name));
+    }
+    return limits;
+}
+
+Napi::Value ConfigureRateLimits(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Rate limit options object required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // Replaces all limits; anything not given is unlimited
+    Napi::Object optObj = info[0].As<Napi::Object>();
+    RateLimiterConfig config;
+    config.printer = jsToRateLimit(optObj.Get("printer"));
+    config.server = jsToRateLimit(optObj.Get("server"));
+    config.printers = jsToRateLimitMap(optObj.Get("printers"));
+    config.servers = jsToRateLimitMap(optObj.Get("servers"));
+    
+    core().rateLimiter->configure(config);
+    return env.Undefined();
+}
+
+Napi::Value ConfigureRetry(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Retry options object required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Object optObj = info[0].As<Napi::Object>();
+    RetryPolicy policy = core().retry->getPolicy();
+    
+    if (optObj.Has("maxAttempts") && optObj.Get("maxAttempts").IsNumber()) {
+        policy.maxAttempts = optObj.Get("maxAttempts").As<Napi::Number>().Int32Value();
+    }
+    
+    if (optObj.Has("initialDelayMs") && optObj.Get("initialDelayMs").IsNumber()) {
+        policy.initialDelayMs = optObj.Get("initialDelayMs").As<Napi::Number>().DoubleValue();
+    }
+    
+    if (optObj.Has("maxDelayMs") && optObj.Get("maxDelayMs").IsNumber()) {
+        policy.maxDelayMs = optObj.Get("maxDelayMs").As<Napi::Number>().DoubleValue();
+    }
+    
+    if (optObj.Has("multiplier") && optObj.Get("multiplier").IsNumber()) {
+        policy.multiplier = optObj.Get("multiplier").As<Napi::Number>().DoubleValue();
+    }
+    
+    if (optObj.Has("jitter") && optObj.Get("jitter").IsNumber()) {
+        policy.jitter = optObj.Get("jitter").As<Napi::Number>().DoubleValue();
+    }
+    
+    // Replaces the platform defaults; an empty array restores them
+    if (optObj.Has("retryableStatuses") && optObj.Get("retryableStatuses").IsArray()) {
+        Napi::Array statuses = optObj.Get("retryableStatuses").As<Napi::Array>();
+        policy.retryableStatuses.clear();
+        for (uint32_t i = 0; i < statuses.Length(); ++i) {
+            if (statuses.Get(i).IsNumber()) {
+                policy.retryableStatuses.push_back(statuses.Get(i).As<Napi::Number>().Int32Value());
+            }
+        }
+    }
+    
+    core().retry->configure(policy);
+    return env.Undefined();
+}
+
+Napi::Value ConfigureLedger(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Ledger options object required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // A path opens (or switches) the ledger; no path closes it
+    Napi::Object optObj = info[0].As<Napi::Object>();
+    try {
+        if (optObj.Has("path") && optObj.Get("path").IsString()) {
+            core().ledger->open(optObj.Get("path").As<Napi::String>().Utf8Value());
+        } else {
+            core().ledger->close();
+        }
+    } catch (const PrinterException& e) {
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    
+    return env.Undefined();
+}
+
+/**
+ * Query the job ledger; runs on the main thread since it never leaves memory
+ */
+Napi::Value QueryLedger(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    LedgerQuery query;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object optObj = info[0].As<Napi::Object>();
+        
+        if (optObj.Has("printer") && optObj.Get("printer").IsString()) {
+            query.printer = optObj.Get("printer").As<Napi::String>().Utf8Value();
+        }
+        
+        if (optObj.Has("state") && optObj.Get("state").IsString()) {
+            query.state = optObj.Get("state").As<Napi::String>().Utf8Value();
+        }
+        
+        if (optObj.Has("since") && optObj.Get("since").IsNumber()) {
+            query.since = optObj.Get("since").As<Napi::Number>().Int64Value();
+        }
+        
+        if (optObj.Has("until") && optObj.Get("until").IsNumber()) {
+            query.until = optObj.Get("until").As<Napi::Number>().Int64Value();
+        }
+        
+        if (optObj.Has("limit") && optObj.Get("limit").IsNumber()) {
+            query.limit = static_cast<size_t>(std::max<int64_t>(0, optObj.Get("limit").As<Napi::Number>().Int64Value()));
+        }
+        
+        if (optObj.Has("tags") && optObj.Get("tags").IsObject()) {
+            Napi::Object tags = optObj.Get("tags").As<Napi::Object>();
+            Napi::Array keys = tags.GetPropertyNames();
+            for (uint32_t i = 0; i < keys.Length(); ++i) {
+                std::string key = keys.Get(i).As<Napi::String>().Utf8Value();
+                query.tags[key] = tags.Get(key).ToString().Utf8Value();
+            }
+        }
+    }
+    
+    std::vector<LedgerEntry> entries;
+    try {
+        entries = core().ledger->query(query);
+    } catch (const PrinterException& e) {
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    
+    Napi::Array result = Napi::Array::New(env, entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const LedgerEntry& entry = entries[i];
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("id", entry.jobId);
+        obj.Set("printer", entry.printer);
+        Napi::Object tags = Napi::Object::New(env);
+        for (const auto& tag : entry.tags) {
+            tags.Set(tag.first, tag.second);
+        }
+        obj.Set("tags", tags);
+        obj.Set("bytes", static_cast<double>(entry.bytes));
+        obj.Set("submittedAt", static_cast<double>(entry.submittedAt));
+        if (entry.finishedAt > 0) {
+            obj.Set("finishedAt", static_cast<double>(entry.finishedAt));
+        }
+        obj.Set("state", entry.state);
+        result[i] = obj;
+    }
+    return result;
+}
+
+void stopStateMonitor(AddonData& data) {
+    data.core->stopStateTable(&data);     // Joins the poller before the memory is released
+    if (!data.stateTableMemory.IsEmpty()) {
+        data.stateTableMemory.Reset();
+    }
+}
+
+/**
+ * Start publishing printer state into an Int32Array over a SharedArrayBuffer
+ * One poller per process: replaces one this environment started, and fails if
+ * another environment's is running. Returns the table's row capacity.
+ */
+Napi::Value StartStateMonitor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsTypedArray() ||
+        info[0].As<Napi::TypedArray>().TypedArrayType() != napi_int32_array) {
+        Napi::TypeError::New(env, "Int32Array over a SharedArrayBuffer required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Int32Array words = info[0].As<Napi::Int32Array>();
+    // A plain ArrayBuffer could be transferred or detached while the poller writes to it
+    if (words.ArrayBuffer().IsArrayBuffer()) {
+        Napi::TypeError::New(env, "Int32Array over a SharedArrayBuffer required").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (words.ElementLength() < StateTableLayout::wordsFor(1)) {
+        Napi::TypeError::New(env, "State table buffer is too small for one printer").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    uint32_t capacity = static_cast<uint32_t>((words.ElementLength() - StateTableLayout::HEADER_WORDS) /
+                                              StateTableLayout::ROW_WORDS);
+    
+    int intervalMs = 2000;
+    bool queueDepth = true;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object optObj = info[1].As<Napi::Object>();
+        
+        if (optObj.Has("intervalMs") && optObj.Get("intervalMs").IsNumber()) {
+            intervalMs = optObj.Get("intervalMs").As<Napi::Number>().Int32Value();
+        }
+        
+        if (optObj.Has("queueDepth") && optObj.Get("queueDepth").IsBoolean()) {
+            queueDepth = optObj.Get("queueDepth").As<Napi::Boolean>().Value();
+        }
+    }
+    
+    AddonData& data = AddonData::from(env);
+    try {
+        core().startStateTable(&data, words.Data(), capacity, queueDepth, intervalMs);
+    } catch (const PrinterException& e) {
+        handlePrinterException(env, e);
+        return env.Null();
+    }
+    // Any previous table of this environment was stopped by the replacement
+    data.stateTableMemory = Napi::Persistent(words.As<Napi::Object>());
+    
+    return Napi::Number::New(env, capacity);
+}
+
+Napi::Value StopStateMonitor(const Napi::CallbackInfo& info) {
+    stopStateMonitor(AddonData::from(info.Env()));
+    return info.Env().Undefined();
 }
 
 // Export initialization
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
-    // Initialize platform-specific APIs
+    // Each environment (main thread or worker) gets its own instance data; the
+    // platform APIs and everything built on them are shared through one core
+    AddonData* data = new AddonData();
     try {
-        g_printerAPI = createPrinterAPI();
-        g_jobAPI = createJobAPI();
+        data->core = NativeCore::acquire();
     } catch (const std::exception& e) {
+        delete data;
         Napi::Error::New(env, std::string("Failed to initialize printer APIs: ") + e.what()).ThrowAsJavaScriptException();
         return exports;
     }
+    env.SetInstanceData(data);
+    data->jobSnapshot = Napi::Persistent(JobSnapshot::Init(env));
     
     // Export functions - Complete Native Abstraction Layer
     exports.Set("getPrinters", Napi::Function::New(env, GetPrinters));
     exports.Set("getPrinter", Napi::Function::New(env, GetPrinter));
+    exports.Set("discoverPrinters", Napi::Function::New(env, DiscoverPrinters));
     exports.Set("getDefaultPrinterName", Napi::Function::New(env, GetDefaultPrinterName));
     exports.Set("getSupportedPrintFormats", Napi::Function::New(env, GetSupportedPrintFormats));
     exports.Set("getPrinterDriverOptions", Napi::Function::New(env, GetPrinterDriverOptions));
     exports.Set("printDirect", Napi::Function::New(env, PrintDirect));
     exports.Set("printFile", Napi::Function::New(env, PrintFile));
+    exports.Set("detectFormat", Napi::Function::New(env, DetectFormat));
+    exports.Set("transcode", Napi::Function::New(env, Transcode));
+    exports.Set("submitToPool", Napi::Function::New(env, SubmitToPool));
+    exports.Set("printWithFailover", Napi::Function::New(env, PrintWithFailover));
+    exports.Set("printRaster", Napi::Function::New(env, PrintRaster));
+    exports.Set("printDocuments", Napi::Function::New(env, PrintDocuments));
+    exports.Set("printTemplate", Napi::Function::New(env, PrintTemplateJob));
+    exports.Set("compileTemplate", Napi::Function::New(env, CompileTemplate));
+    exports.Set("renderTemplate", Napi::Function::New(env, RenderTemplate));
+    exports.Set("releaseTemplate", Napi::Function::New(env, ReleaseTemplate));
+    exports.Set("enqueueJob", Napi::Function::New(env, EnqueueJob));
+    exports.Set("queueReady", Napi::Function::New(env, QueueReady));
     exports.Set("getJob", Napi::Function::New(env, GetJob));
     exports.Set("getJobs", Napi::Function::New(env, GetJobs));
+    exports.Set("getJobsSnapshot", Napi::Function::New(env, GetJobsSnapshot));
+    exports.Set("getJobsPage", Napi::Function::New(env, GetJobsPage));
+    exports.Set("getAllJobs", Napi::Function::New(env, GetAllJobs));
+    exports.Set("getJobsBatch", Napi::Function::New(env, GetJobsBatch));
+    exports.Set("cancelJobs", Napi::Function::New(env, CancelJobs));
+    exports.Set("purgeJobs", Napi::Function::New(env, PurgeJobs));
     exports.Set("setJob", Napi::Function::New(env, SetJob));
+    exports.Set("updateJob", Napi::Function::New(env, UpdateJob));
+    exports.Set("warmup", Napi::Function::New(env, Warmup));
+    exports.Set("getMetrics", Napi::Function::New(env, GetMetrics));
+    exports.Set("configureConnectionPool", Napi::Function::New(env, ConfigureConnectionPool));
+    exports.Set("configureSubmissionQueue", Napi::Function::New(env, ConfigureSubmissionQueue));
+    exports.Set("configureRateLimits", Napi::Function::New(env, ConfigureRateLimits));
+    exports.Set("configureRetry", Napi::Function::New(env, ConfigureRetry));
+    exports.Set("configureLedger", Napi::Function::New(env, ConfigureLedger));
+    exports.Set("queryLedger", Napi::Function::New(env, QueryLedger));
+    exports.Set("startStateMonitor", Napi::Function::New(env, StartStateMonitor));
+    exports.Set("stopStateMonitor", Napi::Function::New(env, StopStateMonitor));
     
     return exports;
 }
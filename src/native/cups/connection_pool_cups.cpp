@@ -0,0 +1,362 @@
+// CUPS connection pool
+// Keeps persistent keep-alive connections to CUPS servers so that every
+// operation borrows an already-negotiated connection instead of relying on
+// the implicit per-thread CUPS_HTTP_DEFAULT connection
+
+#include "../errors.h"
+#include <cups/cups.h>
+#include <poll.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Connection pool counters, exposed through getMetrics()
+ */
+struct ConnectionPoolStats {
+  uint64_t hits = 0;          // Borrowed an existing idle connection
+  uint64_t creates = 0;       // Opened a new connection
+  uint64_t failures = 0;      // Connect/reconnect attempts that failed
+  uint64_t reconnects = 0;    // Idle connections revived after a health check
+  uint64_t reaped = 0;        // Idle connections closed after idleTimeoutMs
+  uint64_t waits = 0;         // Borrowers that had to wait for a free slot
+  size_t idle = 0;
+  size_t inUse = 0;
+};
+
+class CupsConnectionPool {
+public:
+  struct Config {
+    size_t maxPerServer = 4;        // Upper bound of open connections per server
+    int idleTimeoutMs = 30000;      // Idle connections older than this are closed
+    int connectTimeoutMs = 30000;   // Connect timeout, also the max wait for a free slot
+    int connectAttempts = 3;        // Attempts per connect before giving up
+    int initialBackoffMs = 50;      // Backoff between attempts, doubled each time
+    int maxBackoffMs = 2000;
+  };
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct IdleConnection {
+    http_t* http;
+    Clock::time_point lastUsed;
+  };
+
+  struct ServerSlot {
+    std::string host;
+    int port = 0;
+    http_encryption_t encryption = HTTP_ENCRYPTION_IF_REQUESTED;
+    std::vector<IdleConnection> idle;
+    size_t inUse = 0;
+    std::condition_variable available;    // Borrowers of this server waiting for a free connection
+  };
+
+public:
+  /**
+   * RAII handle for a borrowed connection
+   * Returned to the pool on destruction unless marked broken
+   */
+  class Lease {
+  public:
+    Lease() : pool_(nullptr), slot_(nullptr), http_(nullptr), broken_(false) {}
+    Lease(CupsConnectionPool* pool, ServerSlot* slot, http_t* http)
+      : pool_(pool), slot_(slot), http_(http), broken_(false) {}
+
+    ~Lease() { reset(); }
+
+    // Non-copyable
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    Lease(Lease&& other) noexcept
+      : pool_(other.pool_), slot_(other.slot_), http_(other.http_), broken_(other.broken_) {
+      other.pool_ = nullptr;
+      other.slot_ = nullptr;
+      other.http_ = nullptr;
+    }
+
+    Lease& operator=(Lease&& other) noexcept {
+      if (this != &other) {
+        reset();
+        pool_ = other.pool_;
+        slot_ = other.slot_;
+        http_ = other.http_;
+        broken_ = other.broken_;
+        other.pool_ = nullptr;
+        other.slot_ = nullptr;
+        other.http_ = nullptr;
+      }
+      return *this;
+    }
+
+    http_t* get() const { return http_; }
+    operator http_t*() const { return http_; }
+
+    /**
+     * Mark the connection as unusable so it is closed instead of reused
+     */
+    void markBroken() { broken_ = true; }
+
+    /**
+     * Mark the connection broken if the last CUPS call failed at the transport level
+     */
+    void checkLastError() {
+      ipp_status_t status = cupsLastError();
+      if (status == IPP_STATUS_ERROR_SERVICE_UNAVAILABLE || status == IPP_STATUS_ERROR_INTERNAL) {
+        broken_ = true;
+      }
+    }
+
+    void reset() {
+      if (pool_ && http_) {
+        pool_->release(slot_, http_, broken_);
+      }
+      pool_ = nullptr;
+      slot_ = nullptr;
+      http_ = nullptr;
+    }
+
+  private:
+    CupsConnectionPool* pool_;
+    ServerSlot* slot_;
+    http_t* http_;
+    bool broken_;
+  };
+
+  CupsConnectionPool() = default;
+
+  ~CupsConnectionPool() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : slots_) {
+      for (auto& conn : entry.second.idle) {
+        httpClose(conn.http);
+      }
+      entry.second.idle.clear();
+    }
+  }
+
+  // Non-copyable
+  CupsConnectionPool(const CupsConnectionPool&) = delete;
+  CupsConnectionPool& operator=(const CupsConnectionPool&) = delete;
+
+  /**
+   * Process-wide pool instance
+   */
+  static CupsConnectionPool& instance() {
+    static CupsConnectionPool pool;
+    return pool;
+  }
+
+  void configure(const Config& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    if (config_.maxPerServer == 0) config_.maxPerServer = 1;
+
+    // A raised limit may let waiters through
+    for (auto& entry : slots_) {
+      entry.second.available.notify_all();
+    }
+  }
+
+  Config getConfig() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+  }
+
+  /**
+   * Borrow a connection to the default CUPS server (cupsServer()/ippPort())
+   */
+  Lease acquire() {
+    return acquire(cupsServer(), ippPort(), cupsEncryption());
+  }
+
+  /**
+   * Borrow a connection to a specific server
+   * @throws PrinterException if no connection could be established
+   */
+  Lease acquire(const std::string& host, int port, http_encryption_t encryption) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ServerSlot& slot = slotFor(host, port, encryption);
+    reapIdleLocked(slot);
+
+    auto deadline = Clock::now() + std::chrono::milliseconds(config_.connectTimeoutMs);
+    while (slot.idle.empty() && slot.inUse >= config_.maxPerServer) {
+      ++stats_.waits;
+      if (slot.available.wait_until(lock, deadline) == std::cv_status::timeout &&
+          slot.idle.empty() && slot.inUse >= config_.maxPerServer) {
+        ++stats_.failures;
+        throw PrinterException("Timed out waiting for a CUPS connection to " + host,
+                               PrinterErrorCode::PRINTER_OFFLINE);
+      }
+    }
+
+    // Reuse the most recently used idle connection (warmest socket)
+    http_t* stale = nullptr;
+    if (!slot.idle.empty()) {
+      http_t* http = slot.idle.back().http;
+      slot.idle.pop_back();
+
+      if (isHealthy(http)) {
+        ++slot.inUse;
+        ++stats_.hits;
+        return Lease(this, &slot, http);
+      }
+      stale = http;
+    }
+
+    // Reserve the slot before connecting so concurrent borrowers respect the limit
+    ++slot.inUse;
+    Config config = config_;
+    lock.unlock();
+
+    // Server closed the keep-alive socket - try to revive it in place. Done unlocked,
+    // like a new connection, so a half-open server never stalls other borrowers
+    if (stale) {
+      if (httpReconnect2(stale, config.connectTimeoutMs, nullptr) == 0) {
+        lock.lock();
+        ++stats_.reconnects;
+        return Lease(this, &slot, stale);
+      }
+
+      httpClose(stale);
+      lock.lock();
+      ++stats_.failures;
+      lock.unlock();
+    }
+
+    http_t* http = connectWithBackoff(slot, config);
+
+    lock.lock();
+    if (!http) {
+      --slot.inUse;
+      slot.available.notify_one();
+      throw ErrorMappers::createCupsError("Failed to connect to CUPS server " + host);
+    }
+
+    ++stats_.creates;
+    return Lease(this, &slot, http);
+  }
+
+  /**
+   * Close idle connections that have exceeded idleTimeoutMs
+   */
+  void reapIdle() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : slots_) {
+      reapIdleLocked(entry.second);
+    }
+  }
+
+  ConnectionPoolStats getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ConnectionPoolStats stats = stats_;
+    stats.idle = 0;
+    stats.inUse = 0;
+    for (const auto& entry : slots_) {
+      stats.idle += entry.second.idle.size();
+      stats.inUse += entry.second.inUse;
+    }
+    return stats;
+  }
+
+private:
+  std::mutex mutex_;
+  std::map<std::string, ServerSlot> slots_;
+  Config config_;
+  ConnectionPoolStats stats_;
+
+  ServerSlot& slotFor(const std::string& host, int port, http_encryption_t encryption) {
+    std::string key = host + ":" + std::to_string(port) + ":" + std::to_string(static_cast<int>(encryption));
+    ServerSlot& slot = slots_[key];
+    if (slot.host.empty()) {
+      slot.host = host;
+      slot.port = port;
+      slot.encryption = encryption;
+    }
+    return slot;
+  }
+
+  void release(ServerSlot* slot, http_t* http, bool broken) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot->inUse > 0) --slot->inUse;
+
+    if (broken) {
+      httpClose(http);
+    } else {
+      slot->idle.push_back({http, Clock::now()});
+    }
+
+    reapIdleLocked(*slot);
+    slot->available.notify_one();
+  }
+
+  void reapIdleLocked(ServerSlot& slot) {
+    auto cutoff = Clock::now() - std::chrono::milliseconds(config_.idleTimeoutMs);
+    auto stale = std::remove_if(slot.idle.begin(), slot.idle.end(), [&](const IdleConnection& conn) {
+      if (conn.lastUsed < cutoff) {
+        httpClose(conn.http);
+        ++stats_.reaped;
+        return true;
+      }
+      return false;
+    });
+    slot.idle.erase(stale, slot.idle.end());
+  }
+
+  /**
+   * An idle keep-alive socket should never be readable; if it is, the server
+   * has closed it (EOF) or sent something unexpected, so it must not be reused
+   */
+  static bool isHealthy(http_t* http) {
+    int fd = httpGetFd(http);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ready = poll(&pfd, 1, 0);
+    if (ready < 0) {
+      return false;
+    }
+    return ready == 0;
+  }
+
+  http_t* connectWithBackoff(const ServerSlot& slot, const Config& config) {
+    int backoffMs = config.initialBackoffMs;
+
+    for (int attempt = 0; attempt < config.connectAttempts; ++attempt) {
+      if (attempt > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+        backoffMs = std::min(backoffMs * 2, config.maxBackoffMs);
+      }
+
+      http_t* http = httpConnect2(slot.host.c_str(), slot.port, nullptr, AF_UNSPEC, slot.encryption,
+                                  1, config.connectTimeoutMs, nullptr);
+      if (http) {
+#if CUPS_VERSION_MAJOR > 1
+        httpSetKeepAlive(http, HTTP_KEEPALIVE_ON);
+#endif
+        return http;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.failures;
+    }
+
+    return nullptr;
+  }
+};
+
+} // namespace NodePrinter
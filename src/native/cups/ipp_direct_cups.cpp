@@ -0,0 +1,345 @@
+// Direct IPP submission to network printers
+// Printers addressed by ipp:// or ipps:// URI are driven directly with the
+// CUPS destination API, bypassing the local cupsd spool and filter chain
+
+#include "../job_api.h"
+#include "../errors.h"
+#include <cups/cups.h>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+namespace IppDirect {
+
+/**
+ * True for printer names that are device URIs rather than CUPS queue names
+ */
+inline bool isDeviceUri(const std::string& printer) {
+  return printer.compare(0, 6, "ipp://") == 0 || printer.compare(0, 7, "ipps://") == 0;
+}
+
+/**
+ * Map a normalized format name to a MIME type a device understands
+ * Devices have no cups-raw filter, so RAW/AUTO go out as octet-stream
+ */
+inline std::string formatToMime(const std::string& format) {
+  static const std::map<std::string, std::string> formatMap = {
+    {"TEXT", "text/plain"},
+    {"PDF", "application/pdf"},
+    {"JPEG", "image/jpeg"},
+    {"IMAGE", "image/jpeg"},
+    {"POSTSCRIPT", "application/postscript"},
+  };
+
+  // Already a MIME type
+  if (format.find('/') != std::string::npos) {
+    return format;
+  }
+
+  auto it = formatMap.find(format);
+  return (it != formatMap.end()) ? it->second : "application/octet-stream";
+}
+
+/**
+ * Resolved device destination: cups_dest_t plus its cached capabilities
+ */
+class DeviceDestination {
+public:
+  explicit DeviceDestination(const std::string& uri) : uri_(uri), dest_(nullptr), info_(nullptr), port_(0) {
+    char scheme[32], userpass[256], host[256], resource[1024];
+    if (httpSeparateURI(HTTP_URI_CODING_ALL, uri.c_str(), scheme, sizeof(scheme), userpass, sizeof(userpass),
+                        host, sizeof(host), &port_, resource, sizeof(resource)) < HTTP_URI_STATUS_OK) {
+      throw createInvalidArgumentsError("Bad printer URI: " + uri);
+    }
+
+    host_ = host;
+    resource_ = resource;
+    encryption_ = std::string(scheme) == "ipps" ? HTTP_ENCRYPTION_ALWAYS : HTTP_ENCRYPTION_IF_REQUESTED;
+
+    dest_ = cupsGetDestWithURI(NULL, uri.c_str());
+    if (!dest_) {
+      throw ErrorMappers::createCupsError("Failed to resolve printer URI " + uri);
+    }
+  }
+
+  ~DeviceDestination() {
+    if (info_) cupsFreeDestInfo(info_);
+    if (dest_) cupsFreeDests(1, dest_);
+  }
+
+  // Non-copyable
+  DeviceDestination(const DeviceDestination&) = delete;
+  DeviceDestination& operator=(const DeviceDestination&) = delete;
+
+  /**
+   * Borrow a keep-alive connection to the device from the shared pool
+   */
+  CupsConnectionPool::Lease connect() {
+    return CupsConnectionPool::instance().acquire(host_, port_, encryption_);
+  }
+
+  /**
+   * Printer capabilities, fetched once per destination (Get-Printer-Attributes)
+   */
+  cups_dinfo_t* info(http_t* http) {
+    std::lock_guard<std::mutex> lock(infoMutex_);
+    if (!info_) {
+      info_ = cupsCopyDestInfo(http, dest_);
+      if (!info_) {
+        throw ErrorMappers::createCupsError("Failed to query printer " + uri_);
+      }
+    }
+    return info_;
+  }
+
+  cups_dest_t* dest() const { return dest_; }
+  const std::string& uri() const { return uri_; }
+  const std::string& resource() const { return resource_; }
+
+private:
+  std::string uri_;
+  cups_dest_t* dest_;
+  cups_dinfo_t* info_;
+  std::mutex infoMutex_;
+  std::string host_;
+  std::string resource_;
+  int port_;
+  http_encryption_t encryption_;
+};
+
+/**
+ * Cache of resolved destinations, so repeated submissions to the same device
+ * skip URI resolution and the capabilities round-trip
+ */
+class DeviceRegistry {
+public:
+  static DeviceRegistry& instance() {
+    static DeviceRegistry registry;
+    return registry;
+  }
+
+  std::shared_ptr<DeviceDestination> get(const std::string& uri) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = devices_.find(uri);
+    if (it != devices_.end() && now - it->second.resolved < kTtl) {
+      return it->second.device;
+    }
+
+    auto device = std::make_shared<DeviceDestination>(uri);
+    devices_[uri] = {device, now};
+    return device;
+  }
+
+  void invalidate(const std::string& uri) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_.erase(uri);
+  }
+
+private:
+  struct Entry {
+    std::shared_ptr<DeviceDestination> device;
+    std::chrono::steady_clock::time_point resolved;
+  };
+
+  static constexpr std::chrono::seconds kTtl{300};
+
+  std::mutex mutex_;
+  std::map<std::string, Entry> devices_;
+};
+
+/**
+ * Send a buffer as (part of) the current document
+ */
+inline bool writeData(http_t* http, const uint8_t* data, size_t length) {
+  return cupsWriteRequestData(http, reinterpret_cast<const char*>(data), length) == HTTP_STATUS_CONTINUE;
+}
+
+/**
+ * Stream a file as the current document in 64 KiB chunks
+ * @returns false if the file cannot be read or a write fails
+ */
+inline bool writeFile(http_t* http, const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::vector<char> buffer(64 * 1024);
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    std::streamsize count = file.gcount();
+    if (count > 0 && cupsWriteRequestData(http, buffer.data(), static_cast<size_t>(count)) != HTTP_STATUS_CONTINUE) {
+      return false;
+    }
+  }
+  return !file.bad();
+}
+
+/**
+ * Cancel a device job whose documents could not all be sent, so a partial job never prints
+ * Uses a fresh connection: the one that failed may be mid-request
+ */
+inline void abandonJob(DeviceDestination& device, int jobId) {
+  try {
+    auto conn = device.connect();
+    cupsCancelDestJob(conn, device.dest(), jobId);
+  } catch (const PrinterException&) {
+    // Best effort: the submission error is the one the caller needs
+  }
+}
+
+/**
+ * Create a job on the device and stream documents into it, one Send-Document each
+ * Devices that do not support multiple-document-jobs reject the second document.
+ * @param formats Format of each document, in order
+ * @param write Called with the document index and the connection to write that document's body
+ * @returns Job ID assigned by the device
+ */
+template <typename Writer>
+int submitDocuments(const std::string& uri, const std::string& title, const std::vector<std::string>& formats,
+                    int numOptions, cups_option_t* options, Writer write) {
+  auto device = DeviceRegistry::instance().get(uri);
+  auto conn = device->connect();
+  cups_dinfo_t* info = device->info(conn);
+
+  int jobId = 0;
+  if (cupsCreateDestJob(conn, device->dest(), info, &jobId, title.c_str(), numOptions, options) > IPP_STATUS_OK_CONFLICTING) {
+    conn.checkLastError();
+    DeviceRegistry::instance().invalidate(uri);
+    throw ErrorMappers::createCupsError("Failed to create job on " + uri);
+  }
+
+  for (size_t i = 0; i < formats.size(); ++i) {
+    std::string mime = formatToMime(formats[i]);
+    int last = i + 1 == formats.size() ? 1 : 0;
+    // Errors past this point are marked job-created, so they are never resubmitted, and
+    // built before the cancel, which would overwrite cupsLastError()
+    if (cupsStartDestDocument(conn, device->dest(), info, jobId, title.c_str(), mime.c_str(),
+                              numOptions, options, last) != HTTP_STATUS_CONTINUE) {
+      conn.markBroken();
+      PrinterException error = ErrorMappers::createCupsError("Failed to start document on " + uri).setJobCreated();
+      abandonJob(*device, jobId);
+      throw error;
+    }
+
+    if (!write(i, conn.get())) {
+      conn.markBroken();
+      cupsFinishDestDocument(conn, device->dest(), info);
+      PrinterException error = ErrorMappers::createCupsError("Failed to send document to " + uri).setJobCreated();
+      abandonJob(*device, jobId);
+      throw error;
+    }
+
+    if (cupsFinishDestDocument(conn, device->dest(), info) > IPP_STATUS_OK_CONFLICTING) {
+      conn.checkLastError();
+      PrinterException error = ErrorMappers::createCupsError("Printer rejected document on " + uri).setJobCreated();
+      abandonJob(*device, jobId);
+      throw error;
+    }
+  }
+
+  return jobId;
+}
+
+/**
+ * Create a job on the device and stream a single document into it
+ * @param write Called with the connection to write the document body
+ * @returns Job ID assigned by the device
+ */
+template <typename Writer>
+int submit(const std::string& uri, const std::string& title, const std::string& format,
+           int numOptions, cups_option_t* options, Writer write) {
+  return submitDocuments(uri, title, {format}, numOptions, options, [&](size_t, http_t* http) {
+    return write(http);
+  });
+}
+
+inline int printData(const std::string& uri, const std::string& title, const std::string& format,
+                     int numOptions, cups_option_t* options, const uint8_t* data, size_t length) {
+  return submit(uri, title, format, numOptions, options, [&](http_t* http) {
+    return writeData(http, data, length);
+  });
+}
+
+inline int printFile(const std::string& uri, const std::string& title, const std::string& format,
+                     int numOptions, cups_option_t* options, const std::string& filename) {
+  if (!std::ifstream(filename).is_open()) {
+    throw createFileNotFoundError(filename);
+  }
+
+  return submit(uri, title, format, numOptions, options, [&](http_t* http) {
+    return writeFile(http, filename);
+  });
+}
+
+/**
+ * Job status straight from the device (Get-Job-Attributes)
+ */
+inline JobInfo getJob(const std::string& uri, int jobId) {
+  auto device = DeviceRegistry::instance().get(uri);
+  auto conn = device->connect();
+
+  ipp_t* request = CupsIpp::newRequest(IPP_OP_GET_JOB_ATTRIBUTES, uri);
+  ippAddInteger(request, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "job-id", jobId);
+  CupsIpp::addJobAttributeList(request);
+
+  CupsIpp::IppPtr response = CupsIpp::send(conn, request, device->resource());
+  if (!CupsIpp::succeeded(response)) {
+    conn.checkLastError();
+    if (cupsLastError() == IPP_STATUS_ERROR_NOT_FOUND) {
+      throw createJobNotFoundError(jobId);
+    }
+    throw ErrorMappers::createCupsError("Failed to get job from " + uri);
+  }
+
+  std::vector<JobInfo> jobs = CupsIpp::parseJobs(response.get(), uri);
+  if (jobs.empty()) {
+    throw createJobNotFoundError(jobId);
+  }
+  jobs[0].printer = uri;
+  return jobs[0];
+}
+
+/**
+ * Jobs known to the device (Get-Jobs)
+ */
+inline std::vector<JobInfo> getJobs(const std::string& uri) {
+  auto device = DeviceRegistry::instance().get(uri);
+  auto conn = device->connect();
+
+  ipp_t* request = CupsIpp::newRequest(IPP_OP_GET_JOBS, uri);
+  ippAddString(request, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "which-jobs", NULL, "all");
+  CupsIpp::addJobAttributeList(request);
+
+  CupsIpp::IppPtr response = CupsIpp::send(conn, request, device->resource());
+  if (!CupsIpp::succeeded(response)) {
+    conn.checkLastError();
+    return {};
+  }
+
+  std::vector<JobInfo> jobs = CupsIpp::parseJobs(response.get(), uri);
+  for (auto& job : jobs) {
+    job.printer = uri;
+  }
+  return jobs;
+}
+
+inline void cancelJob(const std::string& uri, int jobId) {
+  auto device = DeviceRegistry::instance().get(uri);
+  auto conn = device->connect();
+
+  if (cupsCancelDestJob(conn, device->dest(), jobId) > IPP_STATUS_OK_CONFLICTING) {
+    conn.checkLastError();
+    throw ErrorMappers::createCupsError("Failed to cancel job on " + uri);
+  }
+}
+
+} // namespace IppDirect
+} // namespace NodePrinter
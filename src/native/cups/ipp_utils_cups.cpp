@@ -0,0 +1,172 @@
+// IPP request helpers shared by the CUPS backends
+// Builds requests and converts IPP job attribute groups to JobInfo
+
+#include "../job_api.h"
+#include "../errors.h"
+#include "../../mapping/job_state.h"
+#include <cups/cups.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+namespace CupsIpp {
+
+// Owning pointer for IPP messages
+using IppPtr = std::unique_ptr<ipp_t, void (*)(ipp_t*)>;
+
+inline IppPtr wrap(ipp_t* ipp) {
+  return IppPtr(ipp, ippDelete);
+}
+
+// Job attributes needed to fill JobInfo
+static const char* const kJobAttributes[] = {
+  "job-id",
+  "job-state",
+  "job-name",
+  "job-originating-user-name",
+  "job-printer-uri",
+  "time-at-creation",
+  "time-at-processing",
+  "time-at-completed",
+  "date-time-at-creation",
+  "date-time-at-processing",
+  "date-time-at-completed",
+  "job-k-octets",
+  "job-impressions-completed"
+};
+
+/**
+ * printer-uri for a queue on the connected CUPS server
+ */
+inline std::string queueUri(const std::string& printer) {
+  char uri[1024];
+  httpAssembleURIf(HTTP_URI_CODING_ALL, uri, sizeof(uri), "ipp", NULL, "localhost", ippPort(),
+                   "/printers/%s", printer.c_str());
+  return uri;
+}
+
+/**
+ * Queue name from a CUPS printer/class URI ("ipp://host/printers/NAME")
+ */
+inline std::string queueNameFromUri(const char* uri) {
+  if (!uri) return std::string();
+  const char* slash = strrchr(uri, '/');
+  return slash ? std::string(slash + 1) : std::string(uri);
+}
+
+/**
+ * New request with the standard operation attributes and printer-uri
+ */
+inline ipp_t* newRequest(ipp_op_t op, const std::string& printerUri) {
+  ipp_t* request = ippNewRequest(op);
+  ippAddString(request, IPP_TAG_OPERATION, IPP_TAG_URI, "printer-uri", NULL, printerUri.c_str());
+  ippAddString(request, IPP_TAG_OPERATION, IPP_TAG_NAME, "requesting-user-name", NULL, cupsUser());
+  return request;
+}
+
+inline void addJobAttributeList(ipp_t* request) {
+  ippAddStrings(request, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "requested-attributes",
+                static_cast<int>(sizeof(kJobAttributes) / sizeof(kJobAttributes[0])), NULL, kJobAttributes);
+}
+
+/**
+ * Send a request and return the response
+ * Takes ownership of the request; returns a null response on transport failure
+ */
+inline IppPtr send(http_t* http, ipp_t* request, const std::string& resource) {
+  return wrap(cupsDoRequest(http, request, resource.c_str()));
+}
+
+/**
+ * True when the response exists and carries a successful status
+ */
+inline bool succeeded(const IppPtr& response) {
+  return response && ippGetStatusCode(response.get()) <= IPP_STATUS_OK_CONFLICTING;
+}
+
+inline int64_t timeAttribute(ipp_attribute_t* dateAttr, ipp_attribute_t* timeAttr) {
+  // Devices report time-at-* as printer up-time, so prefer the dateTime variant
+  if (dateAttr) {
+    return static_cast<int64_t>(ippDateToTime(ippGetDate(dateAttr, 0)));
+  }
+  if (timeAttr) {
+    return static_cast<int64_t>(ippGetInteger(timeAttr, 0));
+  }
+  return 0;
+}
+
+/**
+ * Convert every job attribute group in a response to JobInfo
+ * @param printer Printer name used when the response has no job-printer-uri
+ */
+inline std::vector<JobInfo> parseJobs(ipp_t* response, const std::string& printer) {
+  std::vector<JobInfo> jobs;
+  ipp_attribute_t* attr = ippFirstAttribute(response);
+
+  while (attr) {
+    // Skip to the next job group
+    while (attr && ippGetGroupTag(attr) != IPP_TAG_JOB) {
+      attr = ippNextAttribute(response);
+    }
+    if (!attr) break;
+
+    JobInfo info;
+    info.id = 0;
+    ipp_attribute_t* dates[3] = {nullptr, nullptr, nullptr};
+    ipp_attribute_t* times[3] = {nullptr, nullptr, nullptr};
+    int state = 0;
+
+    for (; attr && ippGetGroupTag(attr) == IPP_TAG_JOB; attr = ippNextAttribute(response)) {
+      const char* name = ippGetName(attr);
+      if (!name) break; // Group separator
+
+      std::string key(name);
+      if (key == "job-id") {
+        info.id = ippGetInteger(attr, 0);
+      } else if (key == "job-state") {
+        state = ippGetInteger(attr, 0);
+      } else if (key == "job-name") {
+        const char* value = ippGetString(attr, 0, NULL);
+        if (value) info.title = value;
+      } else if (key == "job-originating-user-name") {
+        const char* value = ippGetString(attr, 0, NULL);
+        if (value) info.user = value;
+      } else if (key == "job-printer-uri") {
+        info.printer = queueNameFromUri(ippGetString(attr, 0, NULL));
+      } else if (key == "job-k-octets") {
+        info.size = static_cast<int64_t>(ippGetInteger(attr, 0)) * 1024;
+      } else if (key == "job-impressions-completed") {
+        info.pages = ippGetInteger(attr, 0);
+      } else if (key == "date-time-at-creation") {
+        dates[0] = attr;
+      } else if (key == "date-time-at-processing") {
+        dates[1] = attr;
+      } else if (key == "date-time-at-completed") {
+        dates[2] = attr;
+      } else if (key == "time-at-creation") {
+        times[0] = attr;
+      } else if (key == "time-at-processing") {
+        times[1] = attr;
+      } else if (key == "time-at-completed") {
+        times[2] = attr;
+      }
+    }
+
+    if (info.id > 0) {
+      info.state = JobMapping::mapCupsJobState(state);
+      if (info.printer.empty()) info.printer = printer;
+      info.creationTime = timeAttribute(dates[0], times[0]);
+      info.processingTime = timeAttribute(dates[1], times[1]);
+      info.completedTime = timeAttribute(dates[2], times[2]);
+      jobs.push_back(std::move(info));
+    }
+
+    if (attr) attr = ippNextAttribute(response);
+  }
+
+  return jobs;
+}
+
+} // namespace CupsIpp
+} // namespace NodePrinter
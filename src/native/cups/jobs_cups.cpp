@@ -3,20 +3,24 @@
 
 #include "../job_api.h"
 #include "../errors.h"
+#include "../format_sniffer.h"
 #include "../../mapping/job_state.h"
 #include <cups/cups.h>
 #include <vector>
 #include <string>
 #include <map>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 #include <fstream>
 #include <unistd.h>
 #include <fcntl.h>
 
 namespace NodePrinter {
 
-// CUPS is not thread-safe, so we need a global mutex
-extern std::mutex g_cupsMutex;
+// No g_cupsMutex here: every job operation runs on its own pooled or device
+// connection, never the shared CUPS_HTTP_DEFAULT one that mutex protects
 
 // Options management class (from original implementation)
 class CupsOptionsManager {
@@ -56,6 +60,15 @@ public:
     } else if (printOptions.orientation == "portrait") {
       num_options = cupsAddOption("orientation-requested", "3", num_options, &options);
     }
+    
+    if (printOptions.priority > 0) {
+      int priority = std::min(printOptions.priority, 100);
+      num_options = cupsAddOption("job-priority", std::to_string(priority).c_str(), num_options, &options);
+    }
+    
+    if (!printOptions.holdUntil.empty()) {
+      num_options = cupsAddOption("job-hold-until", printOptions.holdUntil.c_str(), num_options, &options);
+    }
   }
   
   ~CupsOptionsManager() {
@@ -92,8 +105,235 @@ public:
 
 class CupsJobAPI : public IJobAPI {
 private:
-  // Threshold for using temporary files
-  static const size_t STREAM_THRESHOLD = 4 * 1024 * 1024; // 4 MiB
+  // Job IDs per Cancel-Jobs request; keeps requests well below cupsd's size limits
+  static const size_t CANCEL_BATCH_SIZE = 1000;
+  
+  static void recordFailure(JobCommandResult& result, const PrinterException& e) {
+    result.ok = false;
+    result.error = e.what();
+    result.errorCode = e.getCode();
+  }
+  
+  // Cancel-Job for each ID individually, used to isolate failures in a batch
+  static void cancelEach(CupsConnectionPool::Lease& conn, const std::string& printer,
+                         std::vector<JobCommandResult>& results, size_t begin, size_t end, bool purge) {
+    for (size_t i = begin; i < end; ++i) {
+      if (cupsCancelJob2(conn, printer.c_str(), results[i].id, purge ? 1 : 0) <= IPP_STATUS_OK_CONFLICTING) {
+        results[i].ok = true;
+      } else {
+        conn.checkLastError();
+        recordFailure(results[i], cupsLastError() == IPP_STATUS_ERROR_NOT_FOUND
+          ? createJobNotFoundError(results[i].id)
+          : ErrorMappers::createCupsError("CUPS job control failed"));
+      }
+    }
+  }
+  
+  // Cancel-Jobs in batches on a connection the caller already holds, so callers
+  // with a lease (purgeJobs) never wait on the pool for a second one
+  static std::vector<JobCommandResult> cancelJobs(CupsConnectionPool::Lease& conn, const std::string& printer,
+                                                  const std::vector<int>& ids) {
+    std::vector<JobCommandResult> results(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      results[i].id = ids[i];
+    }
+    
+    std::string printerUri = CupsIpp::queueUri(printer);
+    
+    for (size_t begin = 0; begin < ids.size(); begin += CANCEL_BATCH_SIZE) {
+      size_t end = std::min(ids.size(), begin + CANCEL_BATCH_SIZE);
+      
+      // Cancel-Jobs is all-or-nothing: on success every listed job is canceled
+      ipp_t* request = CupsIpp::newRequest(IPP_OP_CANCEL_JOBS, printerUri);
+      ippAddIntegers(request, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "job-ids",
+                     static_cast<int>(end - begin), ids.data() + begin);
+      
+      CupsIpp::IppPtr response = CupsIpp::send(conn, request, "/jobs/");
+      if (CupsIpp::succeeded(response)) {
+        for (size_t i = begin; i < end; ++i) {
+          results[i].ok = true;
+        }
+        continue;
+      }
+      
+      // Some job in the batch was missing or finished (or the server lacks
+      // Cancel-Jobs) - fall back to per-job requests to report each outcome
+      conn.checkLastError();
+      cancelEach(conn, printer, results, begin, end, false);
+    }
+    
+    return results;
+  }
+  
+  // Simple request on a queue (Purge-Jobs and friends); returns the IPP status
+  static ipp_status_t queueRequest(CupsConnectionPool::Lease& conn, ipp_op_t op, const std::string& printer) {
+    ipp_t* request = CupsIpp::newRequest(op, CupsIpp::queueUri(printer));
+    CupsIpp::IppPtr response = CupsIpp::send(conn, request, "/admin/");
+    if (!response) {
+      conn.checkLastError();
+      return cupsLastError();
+    }
+    return ippGetStatusCode(response.get());
+  }
+  
+  // job-hold-until is a keyword ("indefinite", "night", ...) or a name for "HH:MM[:SS]" times
+  static void addHoldUntil(ipp_t* request, ipp_tag_t group, const std::string& holdUntil) {
+    ipp_tag_t valueTag = holdUntil.find(':') != std::string::npos ? IPP_TAG_NAME : IPP_TAG_KEYWORD;
+    ippAddString(request, group, valueTag, "job-hold-until", NULL, holdUntil.c_str());
+  }
+  
+  // Send a job operation (Hold-Job, Release-Job, Set-Job-Attributes) and check the result
+  static void sendJobRequest(CupsConnectionPool::Lease& conn, ipp_t* request, const std::string& resource,
+                             int jobId, const std::string& action) {
+    CupsIpp::IppPtr response = CupsIpp::send(conn, request, resource);
+    if (CupsIpp::succeeded(response)) {
+      return;
+    }
+    
+    conn.checkLastError();
+    ipp_status_t status = response ? ippGetStatusCode(response.get()) : cupsLastError();
+    if (status == IPP_STATUS_ERROR_NOT_FOUND) {
+      throw createJobNotFoundError(jobId);
+    }
+    if (status == IPP_STATUS_ERROR_NOT_POSSIBLE) {
+      throw PrinterException("Cannot " + action + " job " + std::to_string(jobId) + " in its current state",
+                             PrinterErrorCode::INVALID_ARGUMENTS);
+    }
+    throw ErrorMappers::createCupsError("Failed to " + action + " job");
+  }
+  
+  // Job operation on a CUPS queue or directly on a device
+  static void jobOperation(const std::string& printer, int jobId, ipp_op_t op, const std::string& action,
+                           const JobUpdate* update = nullptr) {
+    auto build = [&](const std::string& printerUri) {
+      ipp_t* request = CupsIpp::newRequest(op, printerUri);
+      ippAddInteger(request, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "job-id", jobId);
+      if (update) {
+        if (update->priority > 0) {
+          ippAddInteger(request, IPP_TAG_JOB, IPP_TAG_INTEGER, "job-priority", std::min(update->priority, 100));
+        }
+        if (!update->holdUntil.empty()) {
+          addHoldUntil(request, IPP_TAG_JOB, update->holdUntil);
+        }
+      }
+      return request;
+    };
+    
+    if (IppDirect::isDeviceUri(printer)) {
+      auto device = IppDirect::DeviceRegistry::instance().get(printer);
+      auto conn = device->connect();
+      sendJobRequest(conn, build(printer), device->resource(), jobId, action);
+      return;
+    }
+    
+    auto conn = CupsConnectionPool::instance().acquire();
+    sendJobRequest(conn, build(CupsIpp::queueUri(printer)), "/jobs/", jobId, action);
+  }
+  
+  // Get-Job-Attributes for one job on a borrowed connection
+  static JobInfo fetchJob(CupsConnectionPool::Lease& conn, const std::string& printer, int jobId) {
+    ipp_t* request = CupsIpp::newRequest(IPP_OP_GET_JOB_ATTRIBUTES, CupsIpp::queueUri(printer));
+    ippAddInteger(request, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "job-id", jobId);
+    CupsIpp::addJobAttributeList(request);
+    
+    CupsIpp::IppPtr response = CupsIpp::send(conn, request, "/");
+    if (!CupsIpp::succeeded(response)) {
+      conn.checkLastError();
+      if (cupsLastError() == IPP_STATUS_ERROR_NOT_FOUND) {
+        throw createJobNotFoundError(jobId);
+      }
+      throw ErrorMappers::createCupsError("Failed to get job attributes from CUPS");
+    }
+    
+    std::vector<JobInfo> jobs = CupsIpp::parseJobs(response.get(), printer);
+    if (jobs.empty()) {
+      throw createJobNotFoundError(jobId);
+    }
+    return jobs[0];
+  }
+  
+  // Create a job and stream typed documents into it, the last one closing the job
+  // write is called with the document index and the connection and returns false on a write failure
+  template <typename Writer>
+  static int printDocuments(CupsConnectionPool::Lease& conn, const std::string& printer, const std::string& jobName,
+                            const std::vector<std::string>& mimeTypes, CupsOptionsManager& options, Writer write) {
+    int jobId = cupsCreateJob(conn, printer.c_str(), jobName.c_str(), options.getNumOptions(), options.get());
+    if (jobId == 0) {
+      conn.checkLastError();
+      throw ErrorMappers::createCupsError("Failed to create job on " + printer);
+    }
+    
+    // Errors past this point are marked job-created, so they are never resubmitted, and
+    // built before the cancel, which would overwrite cupsLastError()
+    for (size_t i = 0; i < mimeTypes.size(); ++i) {
+      int last = i + 1 == mimeTypes.size() ? 1 : 0;
+      if (cupsStartDocument(conn, printer.c_str(), jobId, jobName.c_str(), mimeTypes[i].c_str(), last) != HTTP_STATUS_CONTINUE) {
+        conn.markBroken();
+        PrinterException error = ErrorMappers::createCupsError("Failed to start document on " + printer).setJobCreated();
+        abandonJob(printer, jobId);
+        throw error;
+      }
+      
+      if (!write(i, conn.get())) {
+        conn.markBroken();
+        cupsFinishDocument(conn, printer.c_str());
+        PrinterException error = ErrorMappers::createCupsError("Failed to send document to " + printer).setJobCreated();
+        abandonJob(printer, jobId);
+        throw error;
+      }
+      
+      if (cupsFinishDocument(conn, printer.c_str()) > IPP_STATUS_OK_CONFLICTING) {
+        conn.checkLastError();
+        PrinterException error = ErrorMappers::createCupsError("CUPS rejected document on " + printer).setJobCreated();
+        abandonJob(printer, jobId);
+        throw error;
+      }
+    }
+    
+    return jobId;
+  }
+  
+  template <typename Writer>
+  static int printDocument(CupsConnectionPool::Lease& conn, const std::string& printer, const std::string& jobName,
+                           const std::string& mimeType, CupsOptionsManager& options, Writer write) {
+    return printDocuments(conn, printer, jobName, {mimeType}, options, [&](size_t, http_t* http) {
+      return write(http);
+    });
+  }
+  
+  // Cancel a job whose documents could not all be sent, so a partial job never prints
+  // Uses a fresh connection: the one that failed may be mid-request
+  static void abandonJob(const std::string& printer, int jobId) {
+    try {
+      auto conn = CupsConnectionPool::instance().acquire();
+      cupsCancelJob2(conn, printer.c_str(), jobId, 0);
+    } catch (const PrinterException&) {
+      // Best effort: the submission error is the one the caller needs
+    }
+  }
+  
+  // document-format for a sniffed document: printer languages go through the
+  // queue's raw path (or as octet-stream to a device); everything else by its MIME type
+  static std::string detectedMimeType(const DocumentFormat& format, bool device) {
+    if (format.printerReady) {
+      return device ? format.mimeType : CUPS_FORMAT_RAW;
+    }
+    return format.mimeType;
+  }
+  
+  // document-format for a named format: MIME types are declared as-is, anything
+  // else ("RAW", "TEXT", ...) is typed by cupsd like cupsPrintFile2 would
+  static std::string queueMimeType(const std::string& format) {
+    return format.find('/') != std::string::npos ? format : CUPS_FORMAT_AUTO;
+  }
+  
+  static const char* whichJobsKeyword(WhichJobs which) {
+    switch (which) {
+      case WhichJobs::ACTIVE: return "not-completed";
+      case WhichJobs::COMPLETED: return "completed";
+      default: return "all";
+    }
+  }
   
   // Convert format string to CUPS format
   std::string formatToCups(const std::string& format) {
@@ -121,8 +361,6 @@ private:
   
 public:
   int printFile(const PrintFileRequest& request) override {
-    std::lock_guard<std::mutex> lock(g_cupsMutex);
-    
     // Validate file exists
     std::ifstream file(request.filename);
     if (!file.is_open()) {
@@ -134,135 +372,164 @@ public:
     
     std::string jobName = request.options.jobName.empty() ? "Node.js Print Job" : request.options.jobName;
     
-    int jobId = cupsPrintFile(request.printer.c_str(), request.filename.c_str(), 
-                              jobName.c_str(), options.getNumOptions(), options.get());
+    bool device = IppDirect::isDeviceUri(request.printer);
+    std::string mimeType = isDetectFormat(request.format)
+      ? detectedMimeType(sniffFileFormat(request.filename), device)
+      : std::string();
     
-    if (jobId == 0) {
-      throw ErrorMappers::createCupsError("CUPS print failed");
+    // Device URI - submit straight to the printer
+    if (device) {
+      return IppDirect::printFile(request.printer, jobName, mimeType.empty() ? "AUTO" : mimeType,
+                                  options.getNumOptions(), options.get(), request.filename);
     }
     
-    return jobId;
+    auto conn = CupsConnectionPool::instance().acquire();
+    
+    // A known document-format spares cupsd its own MIME typing of the file; otherwise
+    // it is typed like cupsPrintFile2 would, but a failure after Create-Job is told
+    // apart from one before it
+    return printDocument(conn, request.printer, jobName, mimeType.empty() ? CUPS_FORMAT_AUTO : mimeType, options,
+                         [&](http_t* http) {
+      return IppDirect::writeFile(http, request.filename);
+    });
   }
   
   int printRaw(const PrintRawRequest& request) override {
-    std::lock_guard<std::mutex> lock(g_cupsMutex);
-    
     CupsOptionsManager options(request.options);
     std::string jobName = request.options.jobName.empty() ? "Node.js Print Job" : request.options.jobName;
     
-    int jobId = 0;
+    bool device = IppDirect::isDeviceUri(request.printer);
+    std::string format = isDetectFormat(request.format)
+      ? detectedMimeType(sniffDocumentFormat(request.data.data(), request.data.size()), device)
+      : request.format;
     
-    if (request.data.size() > STREAM_THRESHOLD) {
-      // Use temporary file for large data
-      char tempPath[] = "/tmp/nodeprinter_XXXXXX";
-      int tempFd = mkstemp(tempPath);
-      if (tempFd == -1) {
-        throw ErrorMappers::createCupsError("Failed to create temporary file");
-      }
-      
-      // Write data to temp file
-      ssize_t written = write(tempFd, request.data.data(), request.data.size());
-      close(tempFd);
-      
-      if (written != static_cast<ssize_t>(request.data.size())) {
-        unlink(tempPath);
-        throw ErrorMappers::createCupsError("Failed to write data to temporary file");
-      }
-      
-      // Print using temp file
-      jobId = cupsPrintFile(request.printer.c_str(), tempPath, jobName.c_str(), 
-                            options.getNumOptions(), options.get());
-      
-      // Clean up temp file
-      unlink(tempPath);
-    } else {
-      // Use temporary file for small data too (simpler and more reliable)
-      char tempPath[] = "/tmp/nodeprinter_small_XXXXXX";
-      int tempFd = mkstemp(tempPath);
-      if (tempFd == -1) {
-        throw ErrorMappers::createCupsError("Failed to create temporary file for small data");
+    // Device URI - stream the buffer straight to the printer, no temp file
+    if (device) {
+      return IppDirect::printData(request.printer, jobName, format, options.getNumOptions(), options.get(),
+                                  request.data.data(), request.data.size());
+    }
+    
+    // Streamed into the job from memory, no temp file; a MIME type (e.g. image/pwg-raster)
+    // is declared as the document-format so printers that take it natively need no filters
+    auto conn = CupsConnectionPool::instance().acquire();
+    return printDocument(conn, request.printer, jobName, queueMimeType(format), options, [&](http_t* http) {
+      return IppDirect::writeData(http, request.data.data(), request.data.size());
+    });
+  }
+  
+  int printDocuments(const PrintDocumentsRequest& request) override {
+    if (request.documents.empty()) {
+      throw createInvalidArgumentsError("At least one document is required");
+    }
+    
+    CupsOptionsManager options(request.options);
+    std::string jobName = request.options.jobName.empty() ? "Node.js Print Job" : request.options.jobName;
+    bool device = IppDirect::isDeviceUri(request.printer);
+    bool detect = isDetectFormat(request.format);
+    
+    // Formats are settled and files checked before the job exists, so a bad
+    // document fails the call instead of leaving a half-sent job behind
+    std::vector<std::string> mimeTypes;
+    mimeTypes.reserve(request.documents.size());
+    for (const auto& document : request.documents) {
+      if (!document.filename.empty() && !std::ifstream(document.filename).is_open()) {
+        throw createFileNotFoundError(document.filename);
       }
       
-      // Write data to temp file
-      ssize_t written = write(tempFd, request.data.data(), request.data.size());
-      close(tempFd);
-      
-      if (written != static_cast<ssize_t>(request.data.size())) {
-        unlink(tempPath);
-        throw ErrorMappers::createCupsError("Failed to write small data to temporary file");
+      if (detect) {
+        DocumentFormat format = document.filename.empty()
+          ? sniffDocumentFormat(document.data.data(), document.data.size())
+          : sniffFileFormat(document.filename);
+        mimeTypes.push_back(detectedMimeType(format, device));
+      } else {
+        mimeTypes.push_back(device ? request.format : queueMimeType(request.format));
       }
-      
-      // Print using temp file
-      jobId = cupsPrintFile(request.printer.c_str(), tempPath, jobName.c_str(), 
-                            options.getNumOptions(), options.get());
-      
-      // Clean up temp file
-      unlink(tempPath);
     }
     
-    if (jobId == 0) {
-      throw ErrorMappers::createCupsError("CUPS print failed");
+    auto write = [&](size_t i, http_t* http) {
+      const PrintDocument& document = request.documents[i];
+      return document.filename.empty()
+        ? IppDirect::writeData(http, document.data.data(), document.data.size())
+        : IppDirect::writeFile(http, document.filename);
+    };
+    
+    if (device) {
+      return IppDirect::submitDocuments(request.printer, jobName, mimeTypes, options.getNumOptions(), options.get(),
+                                        write);
     }
     
-    return jobId;
+    auto conn = CupsConnectionPool::instance().acquire();
+    return printDocuments(conn, request.printer, jobName, mimeTypes, options, write);
   }
   
   JobInfo getJob(const std::string& printer, int jobId) override {
-    std::lock_guard<std::mutex> lock(g_cupsMutex);
-    
-    cups_job_t* jobs = nullptr;
-    int numJobs = cupsGetJobs(&jobs, printer.c_str(), 0, CUPS_WHICHJOBS_ALL);
+    if (IppDirect::isDeviceUri(printer)) {
+      return IppDirect::getJob(printer, jobId);
+    }
     
-    if (numJobs < 0) {
-      throw ErrorMappers::createCupsError("Failed to get jobs from CUPS");
+    // Get-Job-Attributes on a pooled connection: one small request instead of
+    // scanning the whole job history
+    auto conn = CupsConnectionPool::instance().acquire();
+    return fetchJob(conn, printer, jobId);
+  }
+  
+  std::vector<JobLookup> getJobsBatch(const std::vector<JobRef>& refs) override {
+    std::vector<JobLookup> results(refs.size());
+    if (refs.empty()) {
+      return results;
     }
     
-    JobInfo info;
-    bool found = false;
+    // Spread lookups over parallel lanes, each holding one pooled keep-alive
+    // connection, so total latency is roughly refs / lanes round-trips. libcups
+    // cannot pipeline: a connection takes one request at a time
+    // (cupsSendRequest flushes any response still unread)
+    size_t lanes = std::min(refs.size(), CupsConnectionPool::instance().getConfig().maxPerServer);
+    std::atomic<size_t> next{0};
     
-    for (int i = 0; i < numJobs; ++i) {
-      if (jobs[i].id == jobId) {
-        info.id = jobId;
-        info.state = JobMapping::mapCupsJobState(jobs[i].state);
-        info.printer = printer;
-        
-        if (jobs[i].title) {
-          info.title = jobs[i].title;
-        }
+    auto runLane = [&]() {
+      std::unique_ptr<CupsConnectionPool::Lease> conn;
+      
+      for (size_t i = next++; i < refs.size(); i = next++) {
+        JobLookup& result = results[i];
+        result.ref = refs[i];
         
-        if (jobs[i].user) {
-          info.user = jobs[i].user;
+        try {
+          if (IppDirect::isDeviceUri(refs[i].printer)) {
+            result.info = IppDirect::getJob(refs[i].printer, refs[i].id);
+          } else {
+            if (!conn) {
+              conn.reset(new CupsConnectionPool::Lease(CupsConnectionPool::instance().acquire()));
+            }
+            result.info = fetchJob(*conn, refs[i].printer, refs[i].id);
+          }
+          result.found = true;
+        } catch (const PrinterException& e) {
+          result.error = e.what();
+          result.errorCode = e.getCode();
+        } catch (const std::exception& e) {
+          result.error = e.what();
         }
-        
-        info.size = jobs[i].size;
-        info.creationTime = static_cast<int64_t>(jobs[i].creation_time);
-        info.processingTime = static_cast<int64_t>(jobs[i].processing_time);
-        info.completedTime = static_cast<int64_t>(jobs[i].completed_time);
-        
-        found = true;
-        break;
       }
-    }
-    
-    cupsFreeJobs(numJobs, jobs);
-    
-    if (!found) {
-      throw createJobNotFoundError(jobId);
-    }
+    };
     
-    return info;
+    runLanes(lanes, runLane);
+    return results;
   }
   
   std::vector<JobInfo> getJobs(const std::string& printer) override {
-    std::lock_guard<std::mutex> lock(g_cupsMutex);
+    if (IppDirect::isDeviceUri(printer)) {
+      return IppDirect::getJobs(printer);
+    }
     
+    auto conn = CupsConnectionPool::instance().acquire();
     cups_job_t* jobs = nullptr;
     const char* printerName = printer.empty() ? nullptr : printer.c_str();
-    int numJobs = cupsGetJobs(&jobs, printerName, 0, CUPS_WHICHJOBS_ALL);
+    int numJobs = cupsGetJobs2(conn, &jobs, printerName, 0, CUPS_WHICHJOBS_ALL);
     
     std::vector<JobInfo> result;
     
     if (numJobs < 0) {
+      conn.checkLastError();
       return result; // Return empty list on error
     }
     
@@ -297,27 +564,252 @@ public:
     return result;
   }
   
+  JobPage getJobsPage(const JobPageRequest& request) override {
+    bool device = IppDirect::isDeviceUri(request.printer);
+    std::string uri = "ipp://localhost/";
+    std::string resource = "/";
+    CupsConnectionPool::Lease conn;
+    
+    if (device) {
+      auto destination = IppDirect::DeviceRegistry::instance().get(request.printer);
+      uri = request.printer;
+      resource = destination->resource();
+      conn = destination->connect();
+    } else {
+      if (!request.printer.empty()) {
+        uri = CupsIpp::queueUri(request.printer);
+      }
+      conn = CupsConnectionPool::instance().acquire();
+    }
+    
+    // The cursor is one past the highest job ID returned so far, which only works if
+    // each page holds the lowest IDs at or past it. cupsd lists "all" in job-ID order,
+    // but "not-completed" by priority and "completed" by completion time, so queues
+    // are paged over "all" with first-job-id/limit (a CUPS extension) and which is
+    // applied here. Devices promise no order and keep short histories, so their
+    // whole listing is sorted and sliced instead.
+    ipp_t* ipp = CupsIpp::newRequest(IPP_OP_GET_JOBS, uri);
+    ippAddString(ipp, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "which-jobs", NULL,
+                 device ? whichJobsKeyword(request.which) : "all");
+    if (!device) {
+      if (request.cursor > 0) {
+        ippAddInteger(ipp, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "first-job-id", request.cursor);
+      }
+      ippAddInteger(ipp, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "limit", request.limit);
+    }
+    CupsIpp::addJobAttributeList(ipp);
+    
+    CupsIpp::IppPtr response = CupsIpp::send(conn, ipp, resource);
+    if (!CupsIpp::succeeded(response)) {
+      conn.checkLastError();
+      if (cupsLastError() == IPP_STATUS_ERROR_NOT_FOUND && !request.printer.empty()) {
+        throw createPrinterNotFoundError(request.printer);
+      }
+      throw ErrorMappers::createCupsError("Failed to list jobs" +
+                                         (request.printer.empty() ? std::string() : " for " + request.printer));
+    }
+    
+    std::vector<JobInfo> jobs = CupsIpp::parseJobs(response.get(), request.printer);
+    JobPage page;
+    
+    if (device) {
+      std::sort(jobs.begin(), jobs.end(), [](const JobInfo& a, const JobInfo& b) { return a.id < b.id; });
+      for (auto& job : jobs) {
+        if (job.id < request.cursor) continue;
+        if (page.jobs.size() >= static_cast<size_t>(request.limit)) {
+          page.nextCursor = page.jobs.back().id + 1;
+          break;
+        }
+        job.printer = request.printer;
+        page.jobs.push_back(std::move(job));
+      }
+      return page;
+    }
+    
+    // A full page of IDs means there may be more, even if few of them matched which
+    int highest = 0;
+    for (auto& job : jobs) {
+      highest = std::max(highest, job.id);
+      if (jobMatches(job, request.which)) {
+        page.jobs.push_back(std::move(job));
+      }
+    }
+    
+    if (jobs.size() >= static_cast<size_t>(request.limit)) {
+      page.nextCursor = highest + 1;
+    }
+    return page;
+  }
+  
+  std::vector<PrinterJobs> getAllJobs(const AllJobsRequest& request) override {
+    auto conn = CupsConnectionPool::instance().acquire();
+    
+    // One Get-Jobs on the server URI covers every queue; job-printer-uri says
+    // which queue each job belongs to
+    ipp_t* ipp = CupsIpp::newRequest(IPP_OP_GET_JOBS, "ipp://localhost/");
+    ippAddString(ipp, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "which-jobs", NULL, whichJobsKeyword(request.which));
+    if (request.limit > 0) {
+      ippAddInteger(ipp, IPP_TAG_OPERATION, IPP_TAG_INTEGER, "limit", request.limit);
+    }
+    CupsIpp::addJobAttributeList(ipp);
+    
+    CupsIpp::IppPtr response = CupsIpp::send(conn, ipp, "/");
+    if (!CupsIpp::succeeded(response)) {
+      conn.checkLastError();
+      throw ErrorMappers::createCupsError("Failed to list jobs");
+    }
+    
+    // cupsd has already applied which-jobs; filtering again would disagree with it about stopped jobs
+    AllJobsRequest grouping = request;
+    grouping.which = WhichJobs::ALL;
+    return groupJobsByPrinter(CupsIpp::parseJobs(response.get(), ""), grouping);
+  }
+  
+  std::vector<JobCommandResult> cancelJobs(const std::string& printer, const std::vector<int>& ids) override {
+    if (ids.empty()) {
+      return {};
+    }
+    
+    if (IppDirect::isDeviceUri(printer)) {
+      std::vector<JobCommandResult> results(ids.size());
+      for (size_t i = 0; i < ids.size(); ++i) {
+        results[i].id = ids[i];
+      }
+      for (auto& result : results) {
+        try {
+          IppDirect::cancelJob(printer, result.id);
+          result.ok = true;
+        } catch (const PrinterException& e) {
+          recordFailure(result, e);
+        }
+      }
+      return results;
+    }
+    
+    auto conn = CupsConnectionPool::instance().acquire();
+    return cancelJobs(conn, printer, ids);
+  }
+  
+  std::vector<JobCommandResult> purgeJobs(const PurgeRequest& request) override {
+    if (IppDirect::isDeviceUri(request.printer)) {
+      return IJobAPI::purgeJobs(request);
+    }
+    
+    auto conn = CupsConnectionPool::instance().acquire();
+    
+    // Find the affected jobs so each one gets a result
+    ipp_t* listRequest = CupsIpp::newRequest(IPP_OP_GET_JOBS, CupsIpp::queueUri(request.printer));
+    ippAddString(listRequest, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "which-jobs", NULL,
+                 request.scope == PurgeScope::ALL ? "all" : "not-completed");
+    static const char* const listAttributes[] = {"job-id", "job-state", "job-originating-user-name"};
+    ippAddStrings(listRequest, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "requested-attributes",
+                  3, NULL, listAttributes);
+    
+    CupsIpp::IppPtr listResponse = CupsIpp::send(conn, listRequest, "/");
+    if (!CupsIpp::succeeded(listResponse)) {
+      conn.checkLastError();
+      throw ErrorMappers::createCupsError("Failed to list jobs for purge");
+    }
+    
+    std::vector<int> activeIds;
+    std::vector<int> finishedIds;
+    for (const auto& job : CupsIpp::parseJobs(listResponse.get(), request.printer)) {
+      if (!request.user.empty() && job.user != request.user) continue;
+      (jobFinished(job.state) ? finishedIds : activeIds).push_back(job.id);
+    }
+    
+    std::vector<JobCommandResult> results = cancelJobs(conn, request.printer, activeIds);
+    
+    if (request.scope == PurgeScope::ALL && !finishedIds.empty()) {
+      size_t offset = results.size();
+      results.resize(offset + finishedIds.size());
+      for (size_t i = 0; i < finishedIds.size(); ++i) {
+        results[offset + i].id = finishedIds[i];
+      }
+      
+      // Purge-Jobs drops the whole history in one request; it cannot be scoped
+      // to a user, so per-user purges remove finished jobs one at a time
+      if (request.user.empty() && queueRequest(conn, IPP_OP_PURGE_JOBS, request.printer) <= IPP_STATUS_OK_CONFLICTING) {
+        for (size_t i = offset; i < results.size(); ++i) {
+          results[i].ok = true;
+        }
+      } else {
+        cancelEach(conn, request.printer, results, offset, results.size(), true);
+      }
+    }
+    
+    return results;
+  }
+  
+  int getQueuedJobCount(const std::string& printer) override {
+    bool device = IppDirect::isDeviceUri(printer);
+    std::string resource = "/";
+    CupsConnectionPool::Lease conn;
+    
+    if (device) {
+      auto destination = IppDirect::DeviceRegistry::instance().get(printer);
+      resource = destination->resource();
+      conn = destination->connect();
+    } else {
+      conn = CupsConnectionPool::instance().acquire();
+    }
+    
+    ipp_t* request = CupsIpp::newRequest(IPP_OP_GET_PRINTER_ATTRIBUTES, device ? printer : CupsIpp::queueUri(printer));
+    ippAddString(request, IPP_TAG_OPERATION, IPP_TAG_KEYWORD, "requested-attributes", NULL, "queued-job-count");
+    
+    CupsIpp::IppPtr response = CupsIpp::send(conn, request, resource);
+    if (!CupsIpp::succeeded(response)) {
+      conn.checkLastError();
+      if (cupsLastError() == IPP_STATUS_ERROR_NOT_FOUND) {
+        throw createPrinterNotFoundError(printer);
+      }
+      throw ErrorMappers::createCupsError("Failed to get queue length for " + printer);
+    }
+    
+    ipp_attribute_t* attr = ippFindAttribute(response.get(), "queued-job-count", IPP_TAG_INTEGER);
+    return attr ? ippGetInteger(attr, 0) : 0;
+  }
+  
   void setJob(const std::string& printer, int jobId, JobCommand command) override {
-    std::lock_guard<std::mutex> lock(g_cupsMutex);
+    // Held jobs keep their spooled data and are skipped by the scheduler until released
+    if (command == JobCommand::PAUSE) {
+      jobOperation(printer, jobId, IPP_OP_HOLD_JOB, "hold");
+      return;
+    }
+    if (command == JobCommand::RESUME) {
+      jobOperation(printer, jobId, IPP_OP_RELEASE_JOB, "release");
+      return;
+    }
     
+    if (IppDirect::isDeviceUri(printer) && command == JobCommand::CANCEL) {
+      IppDirect::cancelJob(printer, jobId);
+      return;
+    }
+    
+    auto conn = CupsConnectionPool::instance().acquire();
     int result = 0;
     
     switch (command) {
       case JobCommand::CANCEL:
-        result = cupsCancelJob(printer.c_str(), jobId);
+        result = cupsCancelJob2(conn, printer.c_str(), jobId, 0) == IPP_STATUS_OK ? 1 : 0;
         break;
-      case JobCommand::PAUSE:
-      case JobCommand::RESUME:
-        // CUPS doesn't have direct pause/resume - these would require IPP operations
-        throw PrinterException("Pause/Resume not supported in CUPS implementation", PrinterErrorCode::UNSUPPORTED_FORMAT);
       default:
         throw createInvalidArgumentsError("Unknown job command");
     }
     
     if (result != 1) {
+      conn.checkLastError();
       throw ErrorMappers::createCupsError("CUPS job control failed");
     }
   }
+  
+  void updateJob(const std::string& printer, int jobId, const JobUpdate& update) override {
+    if (update.priority <= 0 && update.holdUntil.empty()) {
+      throw createInvalidArgumentsError("Nothing to update: priority or holdUntil required");
+    }
+    
+    jobOperation(printer, jobId, IPP_OP_SET_JOB_ATTRIBUTES, "update", &update);
+  }
 };
 
 } // namespace NodePrinter
\ No newline at end of file
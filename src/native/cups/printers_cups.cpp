@@ -2,12 +2,15 @@
 // Implements IPrinterAPI using CUPS API
 
 #include "../printer_api.h"
+#include "../errors.h"
 #include "../../mapping/printer_state.h"
 #include <cups/cups.h>
 #include <cups/ppd.h>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 #include <mutex>
 
 namespace NodePrinter {
@@ -16,55 +19,85 @@ namespace NodePrinter {
 static std::mutex g_cupsMutex;
 
 class CupsPrinterAPI : public IPrinterAPI {
+private:
+  // Convert a CUPS destination to normalized PrinterInfo
+  static PrinterInfo destToPrinterInfo(const cups_dest_t& dest) {
+    PrinterInfo info;
+    info.name = dest.name;
+    info.isDefault = dest.is_default;
+    
+    // Get printer state
+    ipp_pstate_t state = static_cast<ipp_pstate_t>(
+      cupsGetIntegerOption("printer-state", dest.num_options, dest.options));
+    info.state = StateMapping::mapCupsPrinterState(state);
+    
+    // Comma-separated keywords; "none" when the printer has nothing to report
+    const char* reasons = cupsGetOption("printer-state-reasons", dest.num_options, dest.options);
+    if (reasons) {
+      std::string list(reasons);
+      size_t start = 0;
+      while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        std::string reason = list.substr(start, end - start);
+        if (!reason.empty() && reason != "none") {
+          info.stateReasons.push_back(reason);
+        }
+        start = end + 1;
+      }
+    }
+    
+    const char* accepting = cupsGetOption("printer-is-accepting-jobs", dest.num_options, dest.options);
+    if (accepting) {
+      info.acceptingJobs = strcmp(accepting, "false") != 0;
+    }
+    
+    // Get location and description from options
+    const char* location = cupsGetOption("printer-location", dest.num_options, dest.options);
+    if (location) {
+      info.location = location;
+    }
+    
+    const char* description = cupsGetOption("printer-info", dest.num_options, dest.options);
+    if (description) {
+      info.description = description;
+    }
+    
+    // Basic format support
+    info.formats.push_back("RAW");
+    info.formats.push_back("TEXT");
+    
+    // Check for additional formats
+    const char* acceptedTypes = cupsGetOption("document-format-supported", dest.num_options, dest.options);
+    if (acceptedTypes) {
+      std::string types(acceptedTypes);
+      if (types.find("application/pdf") != std::string::npos) {
+        info.formats.push_back("PDF");
+      }
+      if (types.find("image/") != std::string::npos) {
+        info.formats.push_back("IMAGE");
+      }
+    }
+    
+    return info;
+  }
+  
 public:
   std::vector<PrinterInfo> getPrinters() override {
     std::lock_guard<std::mutex> lock(g_cupsMutex);
     std::vector<PrinterInfo> printers;
     
+    auto conn = CupsConnectionPool::instance().acquire();
     cups_dest_t* dests = nullptr;
-    int num_dests = cupsGetDests(&dests);
+    int num_dests = cupsGetDests2(conn, &dests);
     
     if (num_dests < 0) {
+      conn.checkLastError();
       throw std::runtime_error("Failed to get printers from CUPS");
     }
     
     for (int i = 0; i < num_dests; ++i) {
-      PrinterInfo info;
-      info.name = dests[i].name;
-      info.isDefault = dests[i].is_default;
-      
-      // Get printer state
-      ipp_pstate_t state = static_cast<ipp_pstate_t>(
-        cupsGetIntegerOption("printer-state", dests[i].num_options, dests[i].options));
-      info.state = StateMapping::mapCupsPrinterState(state);
-      
-      // Get location and description from options
-      const char* location = cupsGetOption("printer-location", dests[i].num_options, dests[i].options);
-      if (location) {
-        info.location = location;
-      }
-      
-      const char* description = cupsGetOption("printer-info", dests[i].num_options, dests[i].options);
-      if (description) {
-        info.description = description;
-      }
-      
-      // Basic format support
-      info.formats.push_back("RAW");
-      info.formats.push_back("TEXT");
-      
-      // Check for additional formats
-      const char* acceptedTypes = cupsGetOption("document-format-supported", 
-                                                dests[i].num_options, dests[i].options);
-      if (acceptedTypes) {
-        std::string types(acceptedTypes);
-        if (types.find("application/pdf") != std::string::npos) {
-          info.formats.push_back("PDF");
-        }
-        if (types.find("image/") != std::string::npos) {
-          info.formats.push_back("IMAGE");
-        }
-      }
+      PrinterInfo info = destToPrinterInfo(dests[i]);
       
       printers.push_back(std::move(info));
     }
@@ -76,55 +109,65 @@ public:
   PrinterInfo getPrinter(const std::string& name) override {
     std::lock_guard<std::mutex> lock(g_cupsMutex);
     
-    cups_dest_t* dest = cupsGetNamedDest(CUPS_HTTP_DEFAULT, name.c_str(), NULL);
+    auto conn = CupsConnectionPool::instance().acquire();
+    cups_dest_t* dest = cupsGetNamedDest(conn, name.c_str(), NULL);
     if (!dest) {
+      conn.checkLastError();
       throw std::runtime_error("Printer not found: " + name);
     }
     
-    PrinterInfo info;
+    PrinterInfo info = destToPrinterInfo(*dest);
     info.name = name;
-    info.isDefault = dest->is_default;
     
-    // Get printer state
-    ipp_pstate_t state = static_cast<ipp_pstate_t>(
-      cupsGetIntegerOption("printer-state", dest->num_options, dest->options));
-    info.state = StateMapping::mapCupsPrinterState(state);
-    
-    // Get location and description
-    const char* location = cupsGetOption("printer-location", dest->num_options, dest->options);
-    if (location) {
-      info.location = location;
-    }
-    
-    const char* description = cupsGetOption("printer-info", dest->num_options, dest->options);
-    if (description) {
-      info.description = description;
-    }
-    
-    // Get supported formats
-    info.formats.push_back("RAW");
-    info.formats.push_back("TEXT");
+    cupsFreeDests(1, dest);
+    return info;
+  }
+  
+  void discoverPrinters(const DiscoveryOptions& options,
+                        const std::function<bool(const PrinterInfo&)>& onPrinter,
+                        std::atomic<int>& cancel) override {
+    // No g_cupsMutex here: cupsEnumDests runs on the caller's thread with its own
+    // per-thread connection and may block for the whole timeout
+    struct Context {
+      const std::function<bool(const PrinterInfo&)>& onPrinter;
+      std::set<std::string> seen;
+      bool stopped;
+    };
+    Context context{onPrinter, {}, false};
     
-    const char* acceptedTypes = cupsGetOption("document-format-supported", 
-                                              dest->num_options, dest->options);
-    if (acceptedTypes) {
-      std::string types(acceptedTypes);
-      if (types.find("application/pdf") != std::string::npos) {
-        info.formats.push_back("PDF");
+    cups_dest_cb_t callback = [](void* userData, unsigned flags, cups_dest_t* dest) -> int {
+      Context* ctx = static_cast<Context*>(userData);
+      if (flags & (CUPS_DEST_FLAGS_REMOVED | CUPS_DEST_FLAGS_ERROR)) {
+        return 1;
       }
-      if (types.find("image/") != std::string::npos) {
-        info.formats.push_back("IMAGE");
+      
+      // Network queues can be reported more than once while resolving
+      if (!dest || !ctx->seen.insert(dest->name).second) {
+        return 1;
       }
-    }
+      
+      if (!ctx->onPrinter(destToPrinterInfo(*dest))) {
+        ctx->stopped = true;
+        return 0;
+      }
+      return 1;
+    };
     
-    cupsFreeDests(1, dest);
-    return info;
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "cancel flag must be layout-compatible with int");
+    int ok = cupsEnumDests(CUPS_DEST_FLAGS_NONE, options.timeoutMs, reinterpret_cast<int*>(&cancel),
+                           static_cast<cups_ptype_t>(options.type), static_cast<cups_ptype_t>(options.mask),
+                           callback, &context);
+    
+    if (!ok && !context.stopped && cancel.load() == 0) {
+      throw ErrorMappers::createCupsError("Printer discovery failed");
+    }
   }
   
   std::string getDefaultPrinterName() override {
     std::lock_guard<std::mutex> lock(g_cupsMutex);
     
-    const char* defaultPrinter = cupsGetDefault();
+    auto conn = CupsConnectionPool::instance().acquire();
+    const char* defaultPrinter = cupsGetDefault2(conn);
     return defaultPrinter ? std::string(defaultPrinter) : std::string();
   }
   
@@ -145,8 +188,10 @@ public:
     PrinterCapabilities caps;
     caps.formats = {"RAW", "TEXT"};
     
-    cups_dest_t* dest = cupsGetNamedDest(CUPS_HTTP_DEFAULT, name.c_str(), NULL);
+    auto conn = CupsConnectionPool::instance().acquire();
+    cups_dest_t* dest = cupsGetNamedDest(conn, name.c_str(), NULL);
     if (!dest) {
+      conn.checkLastError();
       return caps;
     }
     
@@ -190,8 +235,10 @@ public:
     
     Napi::Object options = Napi::Object::New(env);
     
-    cups_dest_t* dest = cupsGetNamedDest(CUPS_HTTP_DEFAULT, name.c_str(), NULL);
+    auto conn = CupsConnectionPool::instance().acquire();
+    cups_dest_t* dest = cupsGetNamedDest(conn, name.c_str(), NULL);
     if (!dest) {
+      conn.checkLastError();
       return options;
     }
     
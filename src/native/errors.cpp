@@ -21,6 +21,8 @@ std::string printerErrorCodeToString(PrinterErrorCode code) {
         case PrinterErrorCode::INVALID_ARGUMENTS: return "INVALID_ARGUMENTS";
         case PrinterErrorCode::FILE_NOT_FOUND: return "FILE_NOT_FOUND";
         case PrinterErrorCode::UNSUPPORTED_FORMAT: return "UNSUPPORTED_FORMAT";
+        case PrinterErrorCode::QUEUE_FULL: return "QUEUE_FULL";
+        case PrinterErrorCode::UNSUPPORTED_OPERATION: return "UNSUPPORTED_OPERATION";
         case PrinterErrorCode::UNKNOWN: return "UNKNOWN";
         default: return "UNKNOWN";
     }
@@ -45,6 +47,15 @@ int PrinterException::getPlatformCode() const noexcept {
     return platformCode_;
 }
 
+bool PrinterException::isJobCreated() const noexcept {
+    return jobCreated_;
+}
+
+PrinterException& PrinterException::setJobCreated() noexcept {
+    jobCreated_ = true;
+    return *this;
+}
+
 std::string PrinterException::getFullMessage() const {
     std::ostringstream ss;
     ss << message_ << " [" << printerErrorCodeToString(code_);
@@ -140,6 +151,32 @@ PrinterException createWindowsError(const std::string& message, unsigned long dw
 
 #else // POSIX/CUPS
 
+PrinterErrorCode mapCupsStatus(int status) {
+    switch (status) {
+        case IPP_STATUS_ERROR_FORBIDDEN:
+        case IPP_STATUS_ERROR_NOT_AUTHENTICATED:
+        case IPP_STATUS_ERROR_NOT_AUTHORIZED:
+        case IPP_STATUS_ERROR_CUPS_AUTHENTICATION_CANCELED:
+            return PrinterErrorCode::ACCESS_DENIED;
+        
+        case IPP_STATUS_ERROR_BAD_REQUEST:
+        case IPP_STATUS_ERROR_ATTRIBUTES_OR_VALUES:
+            return PrinterErrorCode::INVALID_ARGUMENTS;
+        
+        case IPP_STATUS_ERROR_DOCUMENT_FORMAT_NOT_SUPPORTED:
+            return PrinterErrorCode::UNSUPPORTED_FORMAT;
+        
+        case IPP_STATUS_ERROR_SERVICE_UNAVAILABLE:
+        case IPP_STATUS_ERROR_NOT_ACCEPTING_JOBS:
+        case IPP_STATUS_ERROR_PRINTER_IS_DEACTIVATED:
+            return PrinterErrorCode::PRINTER_OFFLINE;
+        
+        // NOT_FOUND covers printers and jobs alike; the message tells which
+        default:
+            return PrinterErrorCode::UNKNOWN;
+    }
+}
+
 PrinterErrorCode mapCupsError(const std::string& cupsError) {
     if (cupsError.empty()) {
         return PrinterErrorCode::UNKNOWN;
@@ -195,7 +232,12 @@ PrinterErrorCode mapCupsError(const std::string& cupsError) {
 
 PrinterException createCupsError(const std::string& message, const std::string& cupsError) {
     std::string errorString = cupsError.empty() ? cupsLastErrorString() : cupsError;
-    PrinterErrorCode code = mapCupsError(errorString);
+    
+    // The IPP status is authoritative; the message only refines what it leaves open
+    PrinterErrorCode code = mapCupsStatus(cupsLastError());
+    if (code == PrinterErrorCode::UNKNOWN) {
+        code = mapCupsError(errorString);
+    }
     
     std::string fullMessage = message;
     if (!errorString.empty()) {
@@ -14,6 +14,8 @@ enum class PrinterErrorCode {
     INVALID_ARGUMENTS,
     FILE_NOT_FOUND,
     UNSUPPORTED_FORMAT,
+    QUEUE_FULL,
+    UNSUPPORTED_OPERATION,
     UNKNOWN
 };
 
@@ -26,6 +28,7 @@ private:
     std::string message_;
     PrinterErrorCode code_;
     int platformCode_;
+    bool jobCreated_ = false;
 
 public:
     explicit PrinterException(
@@ -38,6 +41,10 @@ public:
     PrinterErrorCode getCode() const noexcept;
     int getPlatformCode() const noexcept;
     std::string getFullMessage() const;
+
+    // Submissions: set when the spooler had already created the job the failed call was filling
+    bool isJobCreated() const noexcept;
+    PrinterException& setJobCreated() noexcept;
 };
 
 // Platform-specific error mappers
@@ -47,6 +54,7 @@ namespace ErrorMappers {
     PrinterException createWindowsError(const std::string& message, unsigned long dwError = 0);
 
     // CUPS error mapping  
+    PrinterErrorCode mapCupsStatus(int status);
     PrinterErrorCode mapCupsError(const std::string& cupsError);
     PrinterException createCupsError(const std::string& message, const std::string& cupsError = "");
 
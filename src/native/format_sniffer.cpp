@@ -0,0 +1,162 @@
+#include "format_sniffer.h"
+#include "errors.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace NodePrinter {
+
+static const uint8_t ESC = 0x1B;
+static const uint8_t GS = 0x1D;
+
+static bool startsWith(const uint8_t* data, size_t length, const char* magic, size_t magicLength) {
+    return length >= magicLength && std::memcmp(data, magic, magicLength) == 0;
+}
+
+static bool contains(const uint8_t* data, size_t length, const char* needle) {
+    size_t needleLength = std::strlen(needle);
+    for (size_t i = 0; i + needleLength <= length; ++i) {
+        if (std::memcmp(data + i, needle, needleLength) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static DocumentFormat format(const char* name, const char* mimeType, bool printerReady) {
+    DocumentFormat result;
+    result.name = name;
+    result.mimeType = mimeType;
+    result.printerReady = printerReady;
+    return result;
+}
+
+/**
+ * ESC/POS streams open with initialize (ESC @) or another short ESC/GS
+ * command; PCL uses ESC E (reset, no parameter) and parameterized ESC & / ESC * / ESC (
+ */
+static bool looksLikePcl(const uint8_t* data, size_t length) {
+    if (length < 2 || data[0] != ESC) {
+        return false;
+    }
+    switch (data[1]) {
+        case 'E':
+            // ESC/POS ESC E n takes a 0/1 parameter; PCL reset is followed by more commands or text
+            return length < 3 || (data[2] != 0 && data[2] != 1);
+        case '&':
+        case '*':
+        case '(':
+        case ')':
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool looksLikeEscPos(const uint8_t* data, size_t length) {
+    if (length < 2) {
+        return false;
+    }
+    if (data[0] == ESC) {
+        return std::strchr("@!-23aEGJMRSadptv", data[1]) != nullptr && data[1] != 0;
+    }
+    if (data[0] == GS) {
+        return std::strchr("!BHLVWhkvw(", data[1]) != nullptr && data[1] != 0;
+    }
+    return false;
+}
+
+static bool looksLikeZpl(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    while (i < length && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r' || data[i] == '\n')) {
+        ++i;
+    }
+    return i < length && (data[i] == '^' || data[i] == '~') && contains(data + i, length - i, "^XA");
+}
+
+static bool looksLikeText(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t c = data[i];
+        if (c < 0x20 && c != '\t' && c != '\n' && c != '\r' && c != '\f') {
+            return false;
+        }
+        if (c == 0x7F) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DocumentFormat sniffDocumentFormat(const uint8_t* data, size_t length) {
+    if (length > SNIFF_BYTES) {
+        length = SNIFF_BYTES;
+    }
+
+    // PJL job wrapper: the whole job, header included, is for the printer
+    if (startsWith(data, length, "\x1b%-12345X", 9)) {
+        return format("PJL", "application/octet-stream", true);
+    }
+
+    if (startsWith(data, length, "%PDF-", 5)) {
+        return format("PDF", "application/pdf", false);
+    }
+
+    if (startsWith(data, length, "%!", 2) || startsWith(data, length, "\x04%!", 3)) {
+        return format("POSTSCRIPT", "application/postscript", false);
+    }
+
+    if (startsWith(data, length, "RaS2", 4) && length >= 13 && std::memcmp(data + 4, "PwgRaster", 9) == 0) {
+        return format("PWG", "image/pwg-raster", false);
+    }
+
+    if (startsWith(data, length, "RaS2", 4) || startsWith(data, length, "RaS3", 4) ||
+        startsWith(data, length, "2SaR", 4) || startsWith(data, length, "3SaR", 4)) {
+        return format("CUPS_RASTER", "application/vnd.cups-raster", false);
+    }
+
+    if (startsWith(data, length, "UNIRAST\0", 8)) {
+        return format("URF", "image/urf", false);
+    }
+
+    if (startsWith(data, length, "\xFF\xD8\xFF", 3)) {
+        return format("JPEG", "image/jpeg", false);
+    }
+
+    if (startsWith(data, length, "\x89PNG\r\n\x1a\n", 8)) {
+        return format("PNG", "image/png", false);
+    }
+
+    if (looksLikePcl(data, length)) {
+        return format("PCL", "application/vnd.hp-pcl", true);
+    }
+
+    if (looksLikeEscPos(data, length)) {
+        return format("ESCPOS", "application/octet-stream", true);
+    }
+
+    if (looksLikeZpl(data, length)) {
+        return format("ZPL", "application/octet-stream", true);
+    }
+
+    if (looksLikeText(data, length)) {
+        return format("TEXT", "text/plain", false);
+    }
+
+    return DocumentFormat();
+}
+
+DocumentFormat sniffFileFormat(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw createFileNotFoundError(filename);
+    }
+
+    std::vector<uint8_t> head(SNIFF_BYTES);
+    file.read(reinterpret_cast<char*>(head.data()), static_cast<std::streamsize>(head.size()));
+    return sniffDocumentFormat(head.data(), static_cast<size_t>(file.gcount()));
+}
+
+} // namespace NodePrinter
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace NodePrinter {
+
+/**
+ * Document format recognized from the first bytes of a document
+ */
+struct DocumentFormat {
+    const char* name = "RAW";                        // "PDF", "POSTSCRIPT", "PCL", "ZPL", ...
+    const char* mimeType = "application/octet-stream";
+    bool printerReady = true;     // Device language that must reach the printer unfiltered
+};
+
+// Bytes of a document looked at when sniffing
+static const size_t SNIFF_BYTES = 4096;
+
+/**
+ * Recognize PDF, PostScript, PJL, PCL, PWG/CUPS raster, URF, JPEG, PNG, ZPL,
+ * ESC/POS and plain text from magic bytes and command heuristics
+ * Anything else is reported as printer-ready RAW.
+ */
+DocumentFormat sniffDocumentFormat(const uint8_t* data, size_t length);
+
+/**
+ * Sniff the first SNIFF_BYTES of a file
+ * @throws PrinterException (FILE_NOT_FOUND) if the file cannot be opened
+ */
+DocumentFormat sniffFileFormat(const std::string& filename);
+
+/**
+ * Whether a format name asks for sniffing ("DETECT")
+ */
+inline bool isDetectFormat(const std::string& format) {
+    return format == "DETECT";
+}
+
+} // namespace NodePrinter
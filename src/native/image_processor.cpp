@@ -0,0 +1,299 @@
+#include "image_processor.h"
+#include "errors.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NODE_PRINTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace NodePrinter {
+
+// 8x8 Bayer index matrix, 0..63
+static const uint8_t BAYER[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+/**
+ * Bits of a byte in reverse order: movemask puts the leftmost pixel in bit 0,
+ * raster lines want it in the most significant bit
+ */
+static const uint8_t* reversedBits() {
+    static uint8_t table[256];
+    static bool ready = [] {
+        for (int i = 0; i < 256; ++i) {
+            uint8_t r = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                if (i & (1 << bit)) {
+                    r |= static_cast<uint8_t>(0x80 >> bit);
+                }
+            }
+            table[i] = r;
+        }
+        return true;
+    }();
+    (void)ready;
+    return table;
+}
+
+/**
+ * 8-bit gray copy of a page (0 = black)
+ */
+static std::vector<uint8_t> toGray(const RasterPage& page) {
+    size_t pixels = static_cast<size_t>(page.width) * page.height;
+    size_t bytesPerLine = (static_cast<size_t>(page.width) * page.bitsPerPixel + 7) / 8;
+    if (page.data.size() < bytesPerLine * page.height) {
+        throw createInvalidArgumentsError("Page data is " + std::to_string(page.data.size()) +
+                                          " bytes, expected " + std::to_string(bytesPerLine * page.height));
+    }
+
+    std::vector<uint8_t> gray(pixels);
+    const uint8_t* src = page.data.data();
+
+    switch (page.bitsPerPixel) {
+        case 8:
+            std::memcpy(gray.data(), src, pixels);
+            break;
+        case 24:
+            // Rec. 601 luma in 8-bit fixed point
+            for (size_t i = 0; i < pixels; ++i, src += 3) {
+                gray[i] = static_cast<uint8_t>((77u * src[0] + 150u * src[1] + 29u * src[2]) >> 8);
+            }
+            break;
+        case 1:
+            for (uint32_t y = 0; y < page.height; ++y) {
+                const uint8_t* line = src + y * bytesPerLine;
+                uint8_t* out = gray.data() + static_cast<size_t>(y) * page.width;
+                for (uint32_t x = 0; x < page.width; ++x) {
+                    out[x] = (line[x >> 3] & (0x80 >> (x & 7))) ? 0 : 255;
+                }
+            }
+            break;
+        default:
+            throw createInvalidArgumentsError("Unsupported bpp " + std::to_string(page.bitsPerPixel) +
+                                              " (pages take 1, 8 or 24)");
+    }
+    return gray;
+}
+
+/**
+ * Area-average downscale: every source pixel contributes to exactly one output pixel
+ * Source rows are summed column-wise first, so each source byte is read once.
+ */
+static std::vector<uint8_t> downscale(const std::vector<uint8_t>& gray, uint32_t width, uint32_t height,
+                                      uint32_t outWidth, uint32_t outHeight) {
+    std::vector<uint8_t> out(static_cast<size_t>(outWidth) * outHeight);
+    std::vector<uint32_t> columns(width);
+
+    for (uint32_t oy = 0; oy < outHeight; ++oy) {
+        uint32_t y0 = static_cast<uint32_t>(static_cast<uint64_t>(oy) * height / outHeight);
+        uint32_t y1 = static_cast<uint32_t>(static_cast<uint64_t>(oy + 1) * height / outHeight);
+
+        std::fill(columns.begin(), columns.end(), 0);
+        for (uint32_t y = y0; y < y1; ++y) {
+            const uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+            for (uint32_t x = 0; x < width; ++x) {
+                columns[x] += row[x];
+            }
+        }
+
+        uint8_t* outRow = out.data() + static_cast<size_t>(oy) * outWidth;
+        for (uint32_t ox = 0; ox < outWidth; ++ox) {
+            uint32_t x0 = static_cast<uint32_t>(static_cast<uint64_t>(ox) * width / outWidth);
+            uint32_t x1 = static_cast<uint32_t>(static_cast<uint64_t>(ox + 1) * width / outWidth);
+            uint64_t sum = 0;
+            for (uint32_t x = x0; x < x1; ++x) {
+                sum += columns[x];
+            }
+            uint64_t count = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+            outRow[ox] = static_cast<uint8_t>((sum + count / 2) / count);
+        }
+    }
+    return out;
+}
+
+/**
+ * Pack one line to 1 bpp: a pixel is black (1) when darker than its threshold
+ * The SSE2 path compares 16 pixels at once and packs them with movemask.
+ */
+static void thresholdLine(const uint8_t* gray, const uint8_t* thresholds, uint32_t width, uint8_t* out) {
+    uint32_t x = 0;
+#ifdef NODE_PRINTER_SSE2
+    const uint8_t* reverse = reversedBits();
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+    for (; x + 16 <= width; x += 16) {
+        // Unsigned compare via the signed one: flip the sign bits first
+        __m128i g = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(gray + x)), bias);
+        __m128i t = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(thresholds + x)), bias);
+        unsigned black = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(g, t)));
+        out[x >> 3] = reverse[black & 0xFF];
+        out[(x >> 3) + 1] = reverse[black >> 8];
+    }
+#endif
+    for (; x < width; ++x) {
+        if (gray[x] < thresholds[x]) {
+            out[x >> 3] |= static_cast<uint8_t>(0x80 >> (x & 7));
+        }
+    }
+}
+
+static void ditherOrdered(const std::vector<uint8_t>& gray, uint32_t width, uint32_t height, bool bayer,
+                          std::vector<uint8_t>& out, size_t bytesPerLine) {
+    // One threshold line per matrix row, repeated across the page
+    std::vector<uint8_t> thresholds(static_cast<size_t>(width) * 8, 128);
+    if (bayer) {
+        for (uint32_t row = 0; row < 8; ++row) {
+            for (uint32_t x = 0; x < width; ++x) {
+                thresholds[row * width + x] = static_cast<uint8_t>(BAYER[row][x & 7] * 4 + 2);
+            }
+        }
+    }
+
+    for (uint32_t y = 0; y < height; ++y) {
+        thresholdLine(gray.data() + static_cast<size_t>(y) * width, thresholds.data() + (y & 7) * width, width,
+                      out.data() + y * bytesPerLine);
+    }
+}
+
+/**
+ * Serpentine Floyd-Steinberg; error rows carry one pixel of padding on each side
+ */
+static void ditherErrorDiffusion(const std::vector<uint8_t>& gray, uint32_t width, uint32_t height,
+                                 std::vector<uint8_t>& out, size_t bytesPerLine) {
+    std::vector<int> current(width + 2, 0);
+    std::vector<int> next(width + 2, 0);
+
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+        uint8_t* line = out.data() + y * bytesPerLine;
+        bool leftToRight = (y & 1) == 0;
+        int step = leftToRight ? 1 : -1;
+
+        for (uint32_t i = 0; i < width; ++i) {
+            uint32_t x = leftToRight ? i : width - 1 - i;
+            size_t at = x + 1;
+
+            int value = row[x] + current[at] / 16;
+            bool black = value < 128;
+            if (black) {
+                line[x >> 3] |= static_cast<uint8_t>(0x80 >> (x & 7));
+            }
+
+            int error = value - (black ? 0 : 255);
+            current[at + step] += error * 7;
+            next[at - step] += error * 3;
+            next[at] += error * 5;
+            next[at + step] += error;
+        }
+
+        current.swap(next);
+        std::fill(next.begin(), next.end(), 0);
+    }
+}
+
+RasterPage preparePage(const RasterPage& page, const ImageProcessing& processing) {
+    if (page.width == 0 || page.height == 0) {
+        throw createInvalidArgumentsError("Page has no pixels");
+    }
+
+    if (processing.bitsPerPixel != 1 && processing.bitsPerPixel != 8) {
+        throw createInvalidArgumentsError("Processed pages are 1 or 8 bpp, not " +
+                                          std::to_string(processing.bitsPerPixel));
+    }
+
+    std::vector<uint8_t> gray = toGray(page);
+    uint32_t width = page.width;
+    uint32_t height = page.height;
+
+    // Largest size that fits the box with the same aspect ratio
+    double scale = 1.0;
+    if (processing.maxWidth > 0 && width > processing.maxWidth) {
+        scale = static_cast<double>(processing.maxWidth) / width;
+    }
+    if (processing.maxHeight > 0 && height * scale > processing.maxHeight) {
+        scale = static_cast<double>(processing.maxHeight) / height;
+    }
+    if (scale < 1.0) {
+        uint32_t outWidth = static_cast<uint32_t>(width * scale);
+        uint32_t outHeight = static_cast<uint32_t>(height * scale);
+        outWidth = outWidth > 0 ? outWidth : 1;
+        outHeight = outHeight > 0 ? outHeight : 1;
+        gray = downscale(gray, width, height, outWidth, outHeight);
+        width = outWidth;
+        height = outHeight;
+    }
+
+    RasterPage result;
+    result.width = width;
+    result.height = height;
+    result.bitsPerPixel = processing.bitsPerPixel;
+
+    if (processing.bitsPerPixel == 8) {
+        result.data = std::move(gray);
+        return result;
+    }
+
+    size_t bytesPerLine = (static_cast<size_t>(width) + 7) / 8;
+    result.data.assign(bytesPerLine * height, 0);
+    if (processing.dither == DitherMethod::ERROR_DIFFUSION) {
+        ditherErrorDiffusion(gray, width, height, result.data, bytesPerLine);
+    } else {
+        ditherOrdered(gray, width, height, processing.dither == DitherMethod::ORDERED, result.data, bytesPerLine);
+    }
+    return result;
+}
+
+bool parseDitherMethod(const std::string& name, DitherMethod& method) {
+    if (name == "threshold") {
+        method = DitherMethod::THRESHOLD;
+    } else if (name == "ordered") {
+        method = DitherMethod::ORDERED;
+    } else if (name == "floyd-steinberg") {
+        method = DitherMethod::ERROR_DIFFUSION;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool mediaSizeInPixels(const std::string& mediaName, uint32_t xResolution, uint32_t yResolution,
+                       uint32_t& width, uint32_t& height) {
+    // class_name_WxHunit, e.g. iso_a4_210x297mm or na_letter_8.5x11in
+    size_t sizeStart = mediaName.rfind('_');
+    std::string size = sizeStart == std::string::npos ? mediaName : mediaName.substr(sizeStart + 1);
+    if (size.size() < 5) {
+        return false;
+    }
+
+    std::string unit = size.substr(size.size() - 2);
+    double perInch = unit == "in" ? 1.0 : unit == "mm" ? 25.4 : 0.0;
+    if (perInch == 0.0) {
+        return false;
+    }
+
+    const char* start = size.c_str();
+    char* end = nullptr;
+    double w = std::strtod(start, &end);
+    if (end == start || *end != 'x') {
+        return false;
+    }
+    double h = std::strtod(end + 1, &end);
+    if (w <= 0.0 || h <= 0.0 || end != start + size.size() - 2) {
+        return false;
+    }
+
+    width = static_cast<uint32_t>(w / perInch * xResolution + 0.5);
+    height = static_cast<uint32_t>(h / perInch * yResolution + 0.5);
+    return width > 0 && height > 0;
+}
+
+} // namespace NodePrinter
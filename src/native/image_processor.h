@@ -0,0 +1,48 @@
+#pragma once
+#include "raster_encoder.h"
+#include <cstdint>
+#include <string>
+
+namespace NodePrinter {
+
+/**
+ * How gray is reduced to black and white
+ */
+enum class DitherMethod {
+    THRESHOLD,          // Fixed 50% threshold; crisp text and barcodes
+    ORDERED,            // 8x8 Bayer matrix; fast, stable patterns
+    ERROR_DIFFUSION     // Floyd-Steinberg; best tonal detail for photos
+};
+
+/**
+ * Device-side preparation of a page before it is encoded
+ */
+struct ImageProcessing {
+    uint32_t maxWidth = 0;        // Fit box in device pixels, aspect ratio kept; 0 = unbounded
+    uint32_t maxHeight = 0;
+    uint32_t bitsPerPixel = 1;    // Output depth: 1 (bilevel) or 8 (sGray)
+    DitherMethod dither = DitherMethod::ERROR_DIFFUSION;
+};
+
+/**
+ * Convert a page to gray, shrink it into the fit box and reduce it to the output depth
+ * Pages are only ever scaled down (area averaging), never up.
+ * @throws PrinterException (INVALID_ARGUMENTS) for unsupported depths or short page data
+ */
+RasterPage preparePage(const RasterPage& page, const ImageProcessing& processing);
+
+/**
+ * Parse "threshold", "ordered" or "floyd-steinberg"
+ * @returns false for unknown names
+ */
+bool parseDitherMethod(const std::string& name, DitherMethod& method);
+
+/**
+ * Printable size in pixels of a PWG self-describing media name at a resolution
+ * e.g. "na_4x6_4x6in" at 203 dpi is 812 x 1218
+ * @returns false if the name carries no dimensions
+ */
+bool mediaSizeInPixels(const std::string& mediaName, uint32_t xResolution, uint32_t yResolution,
+                       uint32_t& width, uint32_t& height);
+
+} // namespace NodePrinter
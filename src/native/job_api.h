@@ -1,8 +1,13 @@
 #pragma once
 #include <napi.h>
+#include "errors.h"
 #include <vector>
+#include <map>
 #include <string>
 #include <memory>
+#include <functional>
+#include <system_error>
+#include <thread>
 
 namespace NodePrinter {
 
@@ -12,7 +17,7 @@ namespace NodePrinter {
  */
 struct JobInfo {
     int id;
-    std::string state;        // normalized: "pending", "printing", "completed", "canceled", "error"
+    std::string state;        // normalized: "pending", "printing", "paused", "completed", "canceled", "aborted", "error"
     std::string printer;
     std::string title;
     std::string user;
@@ -23,6 +28,172 @@ struct JobInfo {
     int64_t size = 0;             // Size in bytes
 };
 
+/**
+ * Whether a job in this normalized state has left the queue for good
+ * The one definition of "finished" used by every backend's listings, purges and probes.
+ * "error" is a stopped or blocked job that is still queued; "aborted" is final.
+ */
+inline bool jobFinished(const std::string& state) {
+    return state == "completed" || state == "canceled" || state == "aborted";
+}
+
+/**
+ * Reference to a job on a specific printer
+ */
+struct JobRef {
+    std::string printer;
+    int id = 0;
+};
+
+/**
+ * Outcome of one lookup in a batched status query
+ */
+struct JobLookup {
+    JobRef ref;
+    bool found = false;
+    JobInfo info;
+    std::string error;
+    PrinterErrorCode errorCode = PrinterErrorCode::UNKNOWN;
+};
+
+/**
+ * Outcome of a command applied to one job in a bulk operation
+ */
+struct JobCommandResult {
+    int id = 0;
+    bool ok = false;
+    std::string error;
+    PrinterErrorCode errorCode = PrinterErrorCode::UNKNOWN;
+};
+
+/**
+ * Which jobs a purge applies to
+ */
+enum class PurgeScope {
+    ACTIVE,     // Pending, held and processing jobs
+    ALL         // Active jobs plus retained job history
+};
+
+/**
+ * Queue purge parameters
+ */
+struct PurgeRequest {
+    std::string printer;
+    PurgeScope scope = PurgeScope::ACTIVE;
+    std::string user;             // Only jobs submitted by this user (empty for everyone)
+};
+
+/**
+ * Which jobs a listing covers
+ */
+enum class WhichJobs {
+    ALL,
+    ACTIVE,       // Pending, held and processing jobs
+    COMPLETED     // Completed, canceled and aborted jobs still in the history
+};
+
+inline bool jobMatches(const JobInfo& job, WhichJobs which) {
+    return which == WhichJobs::ALL || jobFinished(job.state) == (which == WhichJobs::COMPLETED);
+}
+
+/**
+ * One page of a job listing
+ */
+struct JobPageRequest {
+    std::string printer;          // Empty for all printers
+    WhichJobs which = WhichJobs::ALL;
+    int cursor = 0;               // nextCursor of the previous page (0 = first page)
+    int limit = 500;
+};
+
+struct JobPage {
+    std::vector<JobInfo> jobs;
+    int nextCursor = 0;           // 0 when this was the last page
+};
+
+/**
+ * Listing of every printer's jobs at once
+ */
+struct AllJobsRequest {
+    WhichJobs which = WhichJobs::ALL;
+    int limit = 0;                // Most jobs returned across all printers (0 = no limit)
+};
+
+/**
+ * One printer's jobs in an all-printers listing
+ */
+struct PrinterJobs {
+    std::string printer;
+    std::vector<JobInfo> jobs;
+    std::string error;            // Set when this printer's jobs could not be listed
+    PrinterErrorCode errorCode = PrinterErrorCode::UNKNOWN;
+};
+
+/**
+ * Keep at most limit jobs (0 = all) across groups, in group order
+ * Groups left with neither jobs nor an error are dropped.
+ */
+inline void limitJobs(std::vector<PrinterJobs>& groups, int limit) {
+    if (limit <= 0) return;
+    size_t remaining = static_cast<size_t>(limit);
+    std::vector<PrinterJobs> kept;
+    for (auto& group : groups) {
+        if (group.jobs.size() > remaining) {
+            group.jobs.resize(remaining);
+        }
+        remaining -= group.jobs.size();
+        if (!group.jobs.empty() || !group.error.empty()) {
+            kept.push_back(std::move(group));
+        }
+    }
+    groups = std::move(kept);
+}
+
+/**
+ * Group a flat listing by printer, in order of first appearance, applying which and limit
+ */
+inline std::vector<PrinterJobs> groupJobsByPrinter(std::vector<JobInfo> jobs, const AllJobsRequest& request) {
+    std::vector<PrinterJobs> groups;
+    std::map<std::string, size_t> index;
+    for (auto& job : jobs) {
+        if (!jobMatches(job, request.which)) continue;
+        auto it = index.find(job.printer);
+        if (it == index.end()) {
+            it = index.emplace(job.printer, groups.size()).first;
+            groups.emplace_back();
+            groups.back().printer = job.printer;
+        }
+        groups[it->second].jobs.push_back(std::move(job));
+    }
+    limitJobs(groups, request.limit);
+    return groups;
+}
+
+/**
+ * Run work on the calling thread and up to lanes - 1 helper threads, then join them all
+ * work pulls its own items, so if a helper cannot be started the others take its share.
+ */
+inline void runLanes(size_t lanes, const std::function<void()>& work) {
+    std::vector<std::thread> helpers;
+    struct JoinAll {
+        std::vector<std::thread>& threads;
+        ~JoinAll() {
+            for (auto& thread : threads) {
+                if (thread.joinable()) thread.join();
+            }
+        }
+    } joinAll{helpers};
+    
+    try {
+        for (size_t i = 1; i < lanes; ++i) {
+            helpers.emplace_back(work);
+        }
+    } catch (const std::system_error&) {
+        // Out of threads: carry on with the lanes that started
+    }
+    work();
+}
+
 /**
  * Print job options (normalized across platforms)
  */
@@ -33,6 +204,17 @@ struct PrintOptions {
     std::string paperSize;
     std::string orientation;      // "portrait" or "landscape"
     std::string jobName;
+    int priority = 0;             // job-priority 1-100, higher runs first (0 = queue default)
+    std::string holdUntil;        // job-hold-until keyword or "HH:MM[:SS]" UTC (empty = print now)
+    std::map<std::string, std::string> tags;      // Caller metadata for the job ledger; never sent to the spooler
+};
+
+/**
+ * Attribute changes for a queued job (0/empty fields are left unchanged)
+ */
+struct JobUpdate {
+    int priority = 0;
+    std::string holdUntil;
 };
 
 /**
@@ -41,6 +223,7 @@ struct PrintOptions {
 struct PrintFileRequest {
     std::string printer;
     std::string filename;
+    std::string format;           // "DETECT" sniffs the file; otherwise the spooler decides
     PrintOptions options;
 };
 
@@ -54,12 +237,30 @@ struct PrintRawRequest {
     PrintOptions options;
 };
 
+/**
+ * One document of a multi-document job: a file or an in-memory buffer
+ */
+struct PrintDocument {
+    std::string filename;         // Streamed from disk when set
+    std::vector<uint8_t> data;    // Otherwise streamed from memory
+};
+
+/**
+ * Print several documents as a single job
+ */
+struct PrintDocumentsRequest {
+    std::string printer;
+    std::vector<PrintDocument> documents;
+    std::string format;           // "DETECT" sniffs each document; a MIME type; otherwise the spooler decides
+    PrintOptions options;
+};
+
 /**
  * Job control commands
  */
 enum class JobCommand {
-    PAUSE,
-    RESUME, 
+    PAUSE,                        // Hold-Job on CUPS
+    RESUME,                       // Release-Job on CUPS
     CANCEL
 };
 
@@ -85,6 +286,14 @@ public:
      */
     virtual int printRaw(const PrintRawRequest& request) = 0;
     
+    /**
+     * Print documents as one job, in order
+     * Scheduling, banners and job setup happen once for the whole batch.
+     * @param request Documents and shared job options
+     * @returns Job ID
+     */
+    virtual int printDocuments(const PrintDocumentsRequest& request) = 0;
+    
     /**
      * Get information about a specific job
      * @param printer Printer name
@@ -98,6 +307,70 @@ public:
      */
     virtual std::vector<JobInfo> getJobs(const std::string& printer = "") = 0;
     
+    /**
+     * Get one page of a printer's jobs, oldest first
+     * Callers walk a listing by passing each page's nextCursor back in, so only
+     * one page is ever held. The default implementation slices getJobs().
+     */
+    virtual JobPage getJobsPage(const JobPageRequest& request) {
+        std::vector<JobInfo> jobs = getJobs(request.printer);
+        JobPage page;
+        size_t index = static_cast<size_t>(request.cursor);
+        for (; index < jobs.size() && page.jobs.size() < static_cast<size_t>(request.limit); ++index) {
+            if (jobMatches(jobs[index], request.which)) {
+                page.jobs.push_back(std::move(jobs[index]));
+            }
+        }
+        page.nextCursor = index < jobs.size() ? static_cast<int>(index) : 0;
+        return page;
+    }
+    
+    /**
+     * Get every printer's jobs, grouped by printer; printers without matching jobs are left out
+     * Backends answer with a single request where the spooler allows it. The
+     * default implementation groups getJobs("").
+     */
+    virtual std::vector<PrinterJobs> getAllJobs(const AllJobsRequest& request) {
+        return groupJobsByPrinter(getJobs(""), request);
+    }
+    
+    /**
+     * Get information about many jobs at once
+     * Results are returned in request order; failures are reported per job.
+     * The default implementation calls getJob() for each reference.
+     * @param refs Printer/job ID pairs
+     */
+    virtual std::vector<JobLookup> getJobsBatch(const std::vector<JobRef>& refs) {
+        std::vector<JobLookup> results(refs.size());
+        for (size_t i = 0; i < refs.size(); ++i) {
+            results[i].ref = refs[i];
+            try {
+                results[i].info = getJob(refs[i].printer, refs[i].id);
+                results[i].found = true;
+            } catch (const PrinterException& e) {
+                results[i].error = e.what();
+                results[i].errorCode = e.getCode();
+            } catch (const std::exception& e) {
+                results[i].error = e.what();
+            }
+        }
+        return results;
+    }
+    
+    /**
+     * Number of jobs waiting or printing on a printer
+     * The default implementation counts unfinished jobs from getJobs().
+     */
+    virtual int getQueuedJobCount(const std::string& printer) {
+        int count = 0;
+        for (const auto& job : getJobs(printer)) {
+            if (!jobFinished(job.state)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+    
     /**
      * Control a job (pause, resume, cancel)
      * @param printer Printer name
@@ -105,6 +378,57 @@ public:
      * @param command Command to execute
      */
     virtual void setJob(const std::string& printer, int jobId, JobCommand command) = 0;
+    
+    /**
+     * Change priority and/or hold time of a queued job without resubmitting it
+     * @param printer Printer name
+     * @param jobId Job ID
+     * @param update Attributes to change
+     */
+    virtual void updateJob(const std::string& printer, int jobId, const JobUpdate& update) {
+        (void)printer;
+        (void)jobId;
+        (void)update;
+        throw PrinterException("Job updates are not supported on this platform",
+                               PrinterErrorCode::UNSUPPORTED_OPERATION);
+    }
+    
+    /**
+     * Cancel many jobs on one printer
+     * The default implementation cancels one job at a time via setJob().
+     * @returns One result per job ID, in request order
+     */
+    virtual std::vector<JobCommandResult> cancelJobs(const std::string& printer, const std::vector<int>& ids) {
+        std::vector<JobCommandResult> results(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            results[i].id = ids[i];
+            try {
+                setJob(printer, ids[i], JobCommand::CANCEL);
+                results[i].ok = true;
+            } catch (const PrinterException& e) {
+                results[i].error = e.what();
+                results[i].errorCode = e.getCode();
+            } catch (const std::exception& e) {
+                results[i].error = e.what();
+            }
+        }
+        return results;
+    }
+    
+    /**
+     * Cancel every job on a printer that matches the request
+     * The default implementation lists jobs and cancels the matching active ones.
+     * @returns One result per affected job
+     */
+    virtual std::vector<JobCommandResult> purgeJobs(const PurgeRequest& request) {
+        std::vector<int> ids;
+        for (const auto& job : getJobs(request.printer)) {
+            if (!request.user.empty() && job.user != request.user) continue;
+            if (jobFinished(job.state) && request.scope == PurgeScope::ACTIVE) continue;
+            ids.push_back(job.id);
+        }
+        return cancelJobs(request.printer, ids);
+    }
 };
 
 /**
@@ -0,0 +1,775 @@
+#include "job_ledger.h"
+#include "errors.h"
+#include "printer_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NodePrinter {
+
+static const char MAGIC[8] = {'N', 'P', 'L', 'E', 'D', 'G', 'R', '1'};
+static const uint64_t FILE_HEADER = 16;               // Magic plus reserved space
+static const uint64_t INITIAL_CAPACITY = 1 << 20;     // 1 MiB, doubled as needed
+
+/**
+ * Record layout (little-endian, padded to 8 bytes):
+ *   u32 size, u32 checksum (FNV-1a of everything after it),
+ *   u8 type, u8 state, u16 printer length, i32 job ID, i64 time (ms), u64 bytes,
+ *   u16 tag count, u16 reserved, printer, then per tag u16 key length,
+ *   u16 value length, key, value
+ */
+static const size_t RECORD_HEADER = 36;
+
+enum RecordType : uint8_t {
+    SUBMISSION = 1,
+    FINAL_STATE = 2
+};
+
+enum LedgerState : uint8_t {
+    SUBMITTED = 0,
+    COMPLETED,
+    CANCELED,
+    ABORTED
+};
+
+static const char* const STATE_NAMES[] = {"submitted", "completed", "canceled", "aborted"};
+
+static bool parseState(const std::string& name, uint8_t& state) {
+    for (uint8_t i = 0; i < 4; ++i) {
+        if (name == STATE_NAMES[i]) {
+            state = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t checksum(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t jobKey(uint32_t printer, int jobId) {
+    return (static_cast<uint64_t>(printer) << 32) | static_cast<uint32_t>(jobId);
+}
+
+template <typename T>
+static void putValue(std::vector<uint8_t>& out, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void putString(std::vector<uint8_t>& out, const std::string& value, size_t length) {
+    out.insert(out.end(), value.begin(), value.begin() + static_cast<std::ptrdiff_t>(length));
+}
+
+template <typename T>
+static T getValue(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+static std::vector<uint8_t> encodeRecord(uint8_t type, uint8_t state, const std::string& printer, int jobId,
+                                         int64_t at, uint64_t bytes,
+                                         const std::map<std::string, std::string>& tags) {
+    size_t printerLength = std::min<size_t>(printer.size(), 0xFFFF);
+    size_t tagCount = std::min<size_t>(tags.size(), 0xFFFF);
+
+    std::vector<uint8_t> record(8, 0);    // Size and checksum, filled in last
+    putValue<uint8_t>(record, type);
+    putValue<uint8_t>(record, state);
+    putValue<uint16_t>(record, static_cast<uint16_t>(printerLength));
+    putValue<int32_t>(record, jobId);
+    putValue<int64_t>(record, at);
+    putValue<uint64_t>(record, bytes);
+    putValue<uint16_t>(record, static_cast<uint16_t>(tagCount));
+    putValue<uint16_t>(record, 0);
+    putString(record, printer, printerLength);
+
+    size_t written = 0;
+    for (auto it = tags.begin(); it != tags.end() && written < tagCount; ++it, ++written) {
+        size_t keyLength = std::min<size_t>(it->first.size(), 0xFFFF);
+        size_t valueLength = std::min<size_t>(it->second.size(), 0xFFFF);
+        putValue<uint16_t>(record, static_cast<uint16_t>(keyLength));
+        putValue<uint16_t>(record, static_cast<uint16_t>(valueLength));
+        putString(record, it->first, keyLength);
+        putString(record, it->second, valueLength);
+    }
+
+    record.resize((record.size() + 7) & ~static_cast<size_t>(7), 0);
+    uint32_t size = static_cast<uint32_t>(record.size());
+    uint32_t sum = checksum(record.data() + 8, record.size() - 8);
+    std::memcpy(record.data(), &size, sizeof(size));
+    std::memcpy(record.data() + 4, &sum, sizeof(sum));
+    return record;
+}
+
+/**
+ * Fields of a stored record; tags stay in place and are walked on demand
+ */
+struct RecordView {
+    uint8_t type = 0;
+    uint8_t state = 0;
+    std::string printer;
+    int jobId = 0;
+    int64_t at = 0;
+    uint64_t bytes = 0;
+    uint16_t tagCount = 0;
+    const uint8_t* tags = nullptr;
+    const uint8_t* end = nullptr;
+};
+
+/**
+ * Decode the record at data, checking its size, checksum and field bounds
+ * @returns 0 if there is no complete record here, otherwise its size
+ */
+static uint32_t decodeRecord(const uint8_t* data, uint64_t available, RecordView& view) {
+    if (available < RECORD_HEADER) {
+        return 0;
+    }
+    uint32_t size = getValue<uint32_t>(data);
+    if (size < RECORD_HEADER || size % 8 != 0 || size > available ||
+        checksum(data + 8, size - 8) != getValue<uint32_t>(data + 4)) {
+        return 0;
+    }
+
+    view.type = data[8];
+    view.state = data[9];
+    uint16_t printerLength = getValue<uint16_t>(data + 10);
+    view.jobId = getValue<int32_t>(data + 12);
+    view.at = getValue<int64_t>(data + 16);
+    view.bytes = getValue<uint64_t>(data + 24);
+    view.tagCount = getValue<uint16_t>(data + 32);
+    view.end = data + size;
+
+    if (RECORD_HEADER + printerLength > size || view.state > ABORTED) {
+        return 0;
+    }
+    view.printer.assign(reinterpret_cast<const char*>(data + RECORD_HEADER), printerLength);
+    view.tags = data + RECORD_HEADER + printerLength;
+    return size;
+}
+
+static bool readTag(const uint8_t*& cursor, const uint8_t* end, std::string& key, std::string& value) {
+    if (end - cursor < 4) {
+        return false;
+    }
+    uint16_t keyLength = getValue<uint16_t>(cursor);
+    uint16_t valueLength = getValue<uint16_t>(cursor + 2);
+    if (end - cursor < 4 + keyLength + valueLength) {
+        return false;
+    }
+    key.assign(reinterpret_cast<const char*>(cursor + 4), keyLength);
+    value.assign(reinterpret_cast<const char*>(cursor + 4 + keyLength), valueLength);
+    cursor += 4 + keyLength + valueLength;
+    return true;
+}
+
+/**
+ * A read-write shared mapping of the whole log file, held exclusively
+ */
+class JobLedger::MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : path_(path) {
+#ifdef _WIN32
+        int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+        std::wstring widePath(length > 0 ? length - 1 : 0, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+
+        // No write sharing: a second process opening the same ledger fails here
+        file_ = CreateFileW(widePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw ErrorMappers::createWindowsError("Failed to open job ledger " + path, GetLastError());
+        }
+
+        LARGE_INTEGER size;
+        uint64_t current = GetFileSizeEx(file_, &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw systemError("Failed to open job ledger " + path);
+        }
+
+        if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+            ::close(fd_);
+            throw PrinterException("Job ledger " + path + " is in use by another process",
+                                   PrinterErrorCode::ACCESS_DENIED);
+        }
+
+        struct stat st;
+        uint64_t current = fstat(fd_, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#endif
+        try {
+            map(std::max(current, INITIAL_CAPACITY));
+        } catch (...) {
+            closeHandles();
+            throw;
+        }
+    }
+
+    ~MappedFile() {
+        unmap(data_, capacity_);
+        closeHandles();
+    }
+
+    uint8_t* data() { return data_; }
+    uint64_t capacity() const { return capacity_; }
+
+    /**
+     * Extend the file and remap it; the old mapping stays valid if this fails
+     */
+    void grow(uint64_t minimum) {
+        uint64_t capacity = capacity_;
+        while (capacity < minimum) {
+            capacity *= 2;
+        }
+        uint8_t* old = data_;
+        uint64_t oldCapacity = capacity_;
+#ifdef _WIN32
+        HANDLE oldMapping = mapping_;
+        map(capacity);
+        unmap(old, oldCapacity);
+        CloseHandle(oldMapping);
+#else
+        map(capacity);
+        unmap(old, oldCapacity);
+#endif
+    }
+
+    void flush() {
+#ifdef _WIN32
+        FlushViewOfFile(data_, 0);
+#else
+        msync(data_, capacity_, MS_SYNC);
+#endif
+    }
+
+private:
+    std::string path_;
+    uint8_t* data_ = nullptr;
+    uint64_t capacity_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#else
+    int fd_ = -1;
+
+    static PrinterException systemError(const std::string& message) {
+        int error = errno;
+        PrinterErrorCode code = error == EACCES || error == EPERM ? PrinterErrorCode::ACCESS_DENIED
+                                                                  : PrinterErrorCode::UNKNOWN;
+        return PrinterException(message + ": " + std::strerror(error), code, error);
+    }
+#endif
+
+    void map(uint64_t capacity) {
+#ifdef _WIN32
+        // A mapping larger than the file extends it
+        HANDLE mapping = CreateFileMappingW(file_, NULL, PAGE_READWRITE, static_cast<DWORD>(capacity >> 32),
+                                            static_cast<DWORD>(capacity & 0xFFFFFFFF), NULL);
+        if (!mapping) {
+            throw ErrorMappers::createWindowsError("Failed to map job ledger " + path_, GetLastError());
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (!view) {
+            DWORD error = GetLastError();
+            CloseHandle(mapping);
+            throw ErrorMappers::createWindowsError("Failed to map job ledger " + path_, error);
+        }
+        mapping_ = mapping;
+#else
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || static_cast<uint64_t>(st.st_size) < capacity) {
+            if (ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+                throw systemError("Failed to extend job ledger " + path_);
+            }
+        }
+        void* view = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED) {
+            throw systemError("Failed to map job ledger " + path_);
+        }
+#endif
+        data_ = static_cast<uint8_t*>(view);
+        capacity_ = capacity;
+    }
+
+    static void unmap(uint8_t* data, uint64_t capacity) {
+        if (!data) {
+            return;
+        }
+#ifdef _WIN32
+        (void)capacity;
+        UnmapViewOfFile(data);
+#else
+        munmap(data, capacity);
+#endif
+    }
+
+    void closeHandles() {
+#ifdef _WIN32
+        if (mapping_) {
+            CloseHandle(mapping_);
+            mapping_ = NULL;
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (fd_ >= 0) {
+            ::close(fd_);     // Releases the flock
+            fd_ = -1;
+        }
+#endif
+    }
+};
+
+JobLedger::JobLedger() = default;
+
+JobLedger::~JobLedger() {
+    close();
+}
+
+void JobLedger::open(const std::string& path) {
+    std::unique_ptr<MappedFile> file(new MappedFile(path));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        file_->flush();
+    }
+    file_ = std::move(file);
+    reset();
+    try {
+        replay();
+    } catch (...) {
+        file_.reset();
+        reset();
+        throw;
+    }
+}
+
+void JobLedger::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        file_->flush();
+        file_.reset();
+    }
+    reset();
+}
+
+bool JobLedger::isOpen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+void JobLedger::reset() {
+    end_ = 0;
+    entries_.clear();
+    printers_.clear();
+    printerIds_.clear();
+    byPrinter_.clear();
+    byTag_.clear();
+    byJob_.clear();
+}
+
+void JobLedger::replay() {
+    uint8_t* data = file_->data();
+    uint64_t capacity = file_->capacity();
+
+    static const uint8_t EMPTY[8] = {0};
+    if (std::memcmp(data, EMPTY, sizeof(EMPTY)) == 0) {
+        std::memcpy(data, MAGIC, sizeof(MAGIC));
+        end_ = FILE_HEADER;
+        return;
+    }
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw createInvalidArgumentsError("Not a job ledger file");
+    }
+
+    uint64_t offset = FILE_HEADER;
+    RecordView view;
+    while (uint32_t size = decodeRecord(data + offset, capacity - offset, view)) {
+        if (view.type == SUBMISSION) {
+            std::map<std::string, std::string> tags;
+            const uint8_t* cursor = view.tags;
+            std::string key, value;
+            for (uint16_t i = 0; i < view.tagCount && readTag(cursor, view.end, key, value); ++i) {
+                tags[key] = value;
+            }
+            indexSubmission(view.printer, view.jobId, view.bytes, view.at, offset, tags);
+        } else if (view.type == FINAL_STATE) {
+            indexFinalState(view.printer, view.jobId, view.state, view.at);
+        }
+        offset += size;
+    }
+    end_ = offset;
+
+    // Anything past the last good record is a torn append; clear it so the
+    // records written over it are never followed by stale bytes
+    if (end_ + 4 <= capacity && getValue<uint32_t>(data + end_) != 0) {
+        std::memset(data + end_, 0, capacity - end_);
+    }
+}
+
+bool JobLedger::append(const std::vector<uint8_t>& record) {
+    try {
+        if (end_ + record.size() + 4 > file_->capacity()) {
+            file_->grow(end_ + record.size() + 4);
+        }
+    } catch (const std::exception&) {
+        ++writeErrors_;
+        return false;
+    }
+    std::memcpy(file_->data() + end_, record.data(), record.size());
+    end_ += record.size();
+    return true;
+}
+
+uint32_t JobLedger::internPrinter(const std::string& printer) {
+    auto it = printerIds_.find(printer);
+    if (it != printerIds_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(printers_.size());
+    printers_.push_back(printer);
+    byPrinter_.emplace_back();
+    printerIds_[printer] = id;
+    return id;
+}
+
+void JobLedger::indexSubmission(const std::string& printer, int jobId, uint64_t bytes, int64_t at, uint64_t offset,
+                                const std::map<std::string, std::string>& tags) {
+    uint32_t printerId = internPrinter(printer);
+    uint32_t index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(Entry{jobId, printerId, SUBMITTED, at, 0, bytes, offset});
+
+    byPrinter_[printerId].push_back(index);
+    for (const auto& tag : tags) {
+        byTag_[tag.first + '\0' + tag.second].push_back(index);
+    }
+    byJob_[jobKey(printerId, jobId)] = index;
+}
+
+void JobLedger::indexFinalState(const std::string& printer, int jobId, uint8_t state, int64_t at) {
+    auto printerIt = printerIds_.find(printer);
+    if (printerIt == printerIds_.end()) {
+        return;
+    }
+    auto jobIt = byJob_.find(jobKey(printerIt->second, jobId));
+    if (jobIt == byJob_.end()) {
+        return;
+    }
+    Entry& entry = entries_[jobIt->second];
+    entry.state = state;
+    entry.finishedAt = at;
+}
+
+void JobLedger::recordSubmission(const std::string& printer, int jobId, uint64_t bytes,
+                                 const std::map<std::string, std::string>& tags) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+
+    // Keep timestamps non-decreasing so posting lists stay sorted by time
+    int64_t at = std::max(nowMs(), entries_.empty() ? 0 : entries_.back().submittedAt);
+    uint64_t offset = end_;
+    if (append(encodeRecord(SUBMISSION, SUBMITTED, printer, jobId, at, bytes, tags))) {
+        indexSubmission(printer, jobId, bytes, at, offset, tags);
+    }
+}
+
+void JobLedger::recordFinalState(const std::string& printer, int jobId, const std::string& state) {
+    uint8_t code = SUBMITTED;
+    if (!parseState(state, code) || code == SUBMITTED) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+
+    // Only the first final state is written, so re-listing a history costs lookups, not appends
+    auto printerIt = printerIds_.find(printer);
+    if (printerIt == printerIds_.end()) {
+        return;
+    }
+    auto jobIt = byJob_.find(jobKey(printerIt->second, jobId));
+    if (jobIt == byJob_.end() || entries_[jobIt->second].state != SUBMITTED) {
+        return;
+    }
+
+    int64_t at = nowMs();
+    if (append(encodeRecord(FINAL_STATE, code, printer, jobId, at, 0, {}))) {
+        indexFinalState(printer, jobId, code, at);
+    }
+}
+
+std::map<std::string, std::string> JobLedger::readTags(uint64_t offset) {
+    std::map<std::string, std::string> tags;
+    RecordView view;
+    if (!decodeRecord(file_->data() + offset, file_->capacity() - offset, view)) {
+        return tags;
+    }
+    const uint8_t* cursor = view.tags;
+    std::string key, value;
+    for (uint16_t i = 0; i < view.tagCount && readTag(cursor, view.end, key, value); ++i) {
+        tags[key] = value;
+    }
+    return tags;
+}
+
+std::vector<LedgerEntry> JobLedger::query(const LedgerQuery& query) {
+    uint8_t stateFilter = SUBMITTED;
+    if (!query.state.empty() && !parseState(query.state, stateFilter)) {
+        throw createInvalidArgumentsError("Unknown ledger state '" + query.state +
+                                          "' (use submitted, completed, canceled or error)");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<LedgerEntry> results;
+    if (!file_) {
+        return results;
+    }
+
+    // Every match appears in all of these posting lists; the shortest drives the scan
+    std::vector<const std::vector<uint32_t>*> lists;
+    if (!query.printer.empty()) {
+        auto it = printerIds_.find(query.printer);
+        if (it == printerIds_.end()) {
+            return results;
+        }
+        lists.push_back(&byPrinter_[it->second]);
+    }
+    for (const auto& tag : query.tags) {
+        auto it = byTag_.find(tag.first + '\0' + tag.second);
+        if (it == byTag_.end()) {
+            return results;
+        }
+        lists.push_back(&it->second);
+    }
+
+    const std::vector<uint32_t>* driver = nullptr;
+    for (const auto* list : lists) {
+        if (!driver || list->size() < driver->size()) {
+            driver = list;
+        }
+    }
+    auto indexAt = [&](size_t i) { return driver ? (*driver)[i] : static_cast<uint32_t>(i); };
+
+    // Skip everything submitted after `until`, then walk back to `since`
+    size_t count = driver ? driver->size() : entries_.size();
+    if (query.until > 0) {
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (entries_[indexAt(mid)].submittedAt <= query.until) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        count = low;
+    }
+
+    for (size_t i = count; i > 0 && results.size() < query.limit; --i) {
+        uint32_t index = indexAt(i - 1);
+        const Entry& entry = entries_[index];
+        if (entry.submittedAt < query.since) {
+            break;
+        }
+        if (!query.state.empty() && entry.state != stateFilter) {
+            continue;
+        }
+
+        bool matches = true;
+        for (const auto* list : lists) {
+            if (list != driver && !std::binary_search(list->begin(), list->end(), index)) {
+                matches = false;
+                break;
+            }
+        }
+        if (!matches) {
+            continue;
+        }
+
+        LedgerEntry result;
+        result.jobId = entry.jobId;
+        result.printer = printers_[entry.printer];
+        result.tags = readTags(entry.offset);
+        result.bytes = entry.bytes;
+        result.submittedAt = entry.submittedAt;
+        result.finishedAt = entry.finishedAt;
+        result.state = STATE_NAMES[entry.state];
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+LedgerStats JobLedger::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LedgerStats stats;
+    stats.open = file_ != nullptr;
+    stats.records = entries_.size();
+    stats.usedBytes = end_;
+    stats.capacityBytes = file_ ? file_->capacity() : 0;
+    stats.writeErrors = writeErrors_;
+    return stats;
+}
+
+int LedgerJobAPI::printFile(const PrintFileRequest& request) {
+    int jobId = inner_->printFile(request);
+    if (ledger_.isOpen()) {
+        uint64_t bytes = 0;
+        try {
+            bytes = fileBytes(request.filename);
+        } catch (const PrinterException&) {
+            // Printed, but no longer readable; record it without a size
+        }
+        ledger_.recordSubmission(request.printer, jobId, bytes, request.options.tags);
+    }
+    return jobId;
+}
+
+int LedgerJobAPI::printRaw(const PrintRawRequest& request) {
+    int jobId = inner_->printRaw(request);
+    ledger_.recordSubmission(request.printer, jobId, request.data.size(), request.options.tags);
+    return jobId;
+}
+
+int LedgerJobAPI::printDocuments(const PrintDocumentsRequest& request) {
+    int jobId = inner_->printDocuments(request);
+    if (ledger_.isOpen()) {
+        uint64_t bytes = 0;
+        for (const auto& document : request.documents) {
+            try {
+                bytes += document.filename.empty() ? document.data.size() : fileBytes(document.filename);
+            } catch (const PrinterException&) {
+            }
+        }
+        ledger_.recordSubmission(request.printer, jobId, bytes, request.options.tags);
+    }
+    return jobId;
+}
+
+void LedgerJobAPI::observe(const JobInfo& job) {
+    // A stopped job ("error") is still queued; only an aborted one failed for good
+    if (jobFinished(job.state)) {
+        ledger_.recordFinalState(job.printer, job.id, job.state);
+    }
+}
+
+void LedgerJobAPI::observeCanceled(const std::string& printer, const std::vector<JobCommandResult>& results) {
+    for (const auto& result : results) {
+        if (result.ok) {
+            ledger_.recordFinalState(printer, result.id, "canceled");
+        }
+    }
+}
+
+JobInfo LedgerJobAPI::getJob(const std::string& printer, int jobId) {
+    JobInfo job = inner_->getJob(printer, jobId);
+    JobInfo observed = job;
+    observed.printer = printer;
+    observe(observed);
+    return job;
+}
+
+std::vector<JobInfo> LedgerJobAPI::getJobs(const std::string& printer) {
+    std::vector<JobInfo> jobs = inner_->getJobs(printer);
+    if (ledger_.isOpen()) {
+        for (const auto& job : jobs) {
+            observe(job);
+        }
+    }
+    return jobs;
+}
+
+JobPage LedgerJobAPI::getJobsPage(const JobPageRequest& request) {
+    JobPage page = inner_->getJobsPage(request);
+    if (ledger_.isOpen()) {
+        for (const auto& job : page.jobs) {
+            observe(job);
+        }
+    }
+    return page;
+}
+
+std::vector<PrinterJobs> LedgerJobAPI::getAllJobs(const AllJobsRequest& request) {
+    std::vector<PrinterJobs> groups = inner_->getAllJobs(request);
+    if (ledger_.isOpen()) {
+        for (const auto& group : groups) {
+            for (const auto& job : group.jobs) {
+                observe(job);
+            }
+        }
+    }
+    return groups;
+}
+
+std::vector<JobLookup> LedgerJobAPI::getJobsBatch(const std::vector<JobRef>& refs) {
+    std::vector<JobLookup> results = inner_->getJobsBatch(refs);
+    if (ledger_.isOpen()) {
+        for (const auto& result : results) {
+            if (result.found) {
+                JobInfo observed = result.info;
+                observed.printer = result.ref.printer;
+                observe(observed);
+            }
+        }
+    }
+    return results;
+}
+
+int LedgerJobAPI::getQueuedJobCount(const std::string& printer) {
+    return inner_->getQueuedJobCount(printer);
+}
+
+void LedgerJobAPI::setJob(const std::string& printer, int jobId, JobCommand command) {
+    inner_->setJob(printer, jobId, command);
+    if (command == JobCommand::CANCEL) {
+        ledger_.recordFinalState(printer, jobId, "canceled");
+    }
+}
+
+void LedgerJobAPI::updateJob(const std::string& printer, int jobId, const JobUpdate& update) {
+    inner_->updateJob(printer, jobId, update);
+}
+
+std::vector<JobCommandResult> LedgerJobAPI::cancelJobs(const std::string& printer, const std::vector<int>& ids) {
+    std::vector<JobCommandResult> results = inner_->cancelJobs(printer, ids);
+    observeCanceled(printer, results);
+    return results;
+}
+
+std::vector<JobCommandResult> LedgerJobAPI::purgeJobs(const PurgeRequest& request) {
+    std::vector<JobCommandResult> results = inner_->purgeJobs(request);
+    observeCanceled(request.printer, results);
+    return results;
+}
+
+} // namespace NodePrinter
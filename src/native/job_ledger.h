@@ -0,0 +1,156 @@
+#pragma once
+#include "job_api.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * One submission as recorded in the ledger
+ */
+struct LedgerEntry {
+    int jobId = 0;
+    std::string printer;
+    std::map<std::string, std::string> tags;
+    uint64_t bytes = 0;
+    int64_t submittedAt = 0;      // Unix time in milliseconds
+    int64_t finishedAt = 0;       // 0 until a final state is seen
+    std::string state;            // "submitted", "completed", "canceled" or "aborted"
+};
+
+/**
+ * Ledger filters; empty fields match everything
+ */
+struct LedgerQuery {
+    std::string printer;
+    std::map<std::string, std::string> tags;      // Every tag must match
+    std::string state;
+    int64_t since = 0;            // Submitted at or after (ms)
+    int64_t until = 0;            // Submitted at or before (ms; 0 = no bound)
+    size_t limit = 1000;
+};
+
+struct LedgerStats {
+    bool open = false;
+    uint64_t records = 0;         // Submissions indexed
+    uint64_t usedBytes = 0;       // Log bytes written
+    uint64_t capacityBytes = 0;   // Size of the mapped file
+    uint64_t writeErrors = 0;     // Records dropped because the log could not grow
+};
+
+/**
+ * Append-only, memory-mapped log of job submissions and their final states
+ *
+ * Each record carries its size and a checksum; on open the log is replayed up
+ * to the first incomplete record (a crash mid-append), which the next append
+ * overwrites. Indexes by printer, tag and job live in memory. Entries are kept
+ * in submission order with non-decreasing timestamps, so every posting list is
+ * also sorted by time and a time-bounded query is a binary search plus a scan
+ * of the matching range.
+ */
+class JobLedger {
+public:
+    JobLedger();
+    ~JobLedger();
+
+    // Non-copyable
+    JobLedger(const JobLedger&) = delete;
+    JobLedger& operator=(const JobLedger&) = delete;
+
+    /**
+     * Open (or create) the log at path, replacing any open one, and rebuild the indexes
+     * @throws PrinterException if the file cannot be created, locked or mapped, or is not a ledger
+     */
+    void open(const std::string& path);
+    void close();
+    bool isOpen();
+
+    // Recording never throws; failures are counted in LedgerStats::writeErrors
+    void recordSubmission(const std::string& printer, int jobId, uint64_t bytes,
+                          const std::map<std::string, std::string>& tags);
+
+    /**
+     * Record a job's final state ("completed", "canceled" or "aborted")
+     * Ignored for jobs the ledger does not know and jobs already finished.
+     */
+    void recordFinalState(const std::string& printer, int jobId, const std::string& state);
+
+    /**
+     * Matching entries, newest first
+     */
+    std::vector<LedgerEntry> query(const LedgerQuery& query);
+
+    LedgerStats getStats();
+
+private:
+    class MappedFile;
+
+    struct Entry {
+        int jobId;
+        uint32_t printer;         // Index into printers_
+        uint8_t state;
+        int64_t submittedAt;
+        int64_t finishedAt;
+        uint64_t bytes;
+        uint64_t offset;          // Submission record, for its tags
+    };
+
+    std::mutex mutex_;
+    std::unique_ptr<MappedFile> file_;
+    uint64_t end_ = 0;
+    uint64_t writeErrors_ = 0;
+
+    std::vector<Entry> entries_;
+    std::vector<std::string> printers_;
+    std::unordered_map<std::string, uint32_t> printerIds_;
+    std::vector<std::vector<uint32_t>> byPrinter_;
+    std::unordered_map<std::string, std::vector<uint32_t>> byTag_;
+    std::unordered_map<uint64_t, uint32_t> byJob_;
+
+    void reset();
+    void replay();
+    bool append(const std::vector<uint8_t>& record);
+    void indexSubmission(const std::string& printer, int jobId, uint64_t bytes, int64_t at, uint64_t offset,
+                         const std::map<std::string, std::string>& tags);
+    void indexFinalState(const std::string& printer, int jobId, uint8_t state, int64_t at);
+    uint32_t internPrinter(const std::string& printer);
+    std::map<std::string, std::string> readTags(uint64_t offset);
+};
+
+/**
+ * IJobAPI decorator that records submissions and observed final states in a JobLedger
+ * Does nothing while the ledger is closed.
+ */
+class LedgerJobAPI : public IJobAPI {
+public:
+    LedgerJobAPI(std::unique_ptr<IJobAPI> inner, JobLedger& ledger)
+        : inner_(std::move(inner)), ledger_(ledger) {}
+
+    int printFile(const PrintFileRequest& request) override;
+    int printRaw(const PrintRawRequest& request) override;
+    int printDocuments(const PrintDocumentsRequest& request) override;
+    JobInfo getJob(const std::string& printer, int jobId) override;
+    std::vector<JobInfo> getJobs(const std::string& printer = "") override;
+    JobPage getJobsPage(const JobPageRequest& request) override;
+    std::vector<PrinterJobs> getAllJobs(const AllJobsRequest& request) override;
+    std::vector<JobLookup> getJobsBatch(const std::vector<JobRef>& refs) override;
+    int getQueuedJobCount(const std::string& printer) override;
+    void setJob(const std::string& printer, int jobId, JobCommand command) override;
+    void updateJob(const std::string& printer, int jobId, const JobUpdate& update) override;
+    std::vector<JobCommandResult> cancelJobs(const std::string& printer, const std::vector<int>& ids) override;
+    std::vector<JobCommandResult> purgeJobs(const PurgeRequest& request) override;
+
+private:
+    std::unique_ptr<IJobAPI> inner_;
+    JobLedger& ledger_;
+
+    void observe(const JobInfo& job);
+    void observeCanceled(const std::string& printer, const std::vector<JobCommandResult>& results);
+};
+
+} // namespace NodePrinter
@@ -0,0 +1,108 @@
+#include "native_core.h"
+#include "errors.h"
+#include <atomic>
+#include <mutex>
+
+namespace NodePrinter {
+
+static std::mutex g_coreMutex;
+static std::weak_ptr<NativeCore> g_core;
+static std::atomic<NativeCore*> g_currentCore{nullptr};
+
+NativeCore::NativeCore()
+    : printerAPI([]() { return createPrinterAPI(); }),
+      jobAPI([this]() -> std::unique_ptr<IJobAPI> {
+          return std::make_unique<LedgerJobAPI>(std::make_unique<RetryingJobAPI>(createJobAPI(), *retry), *ledger);
+      }),
+      printerHealth([this]() {
+          return std::make_unique<PrinterHealthCache>([this](const std::string& printer) {
+              return printerAPI->getPrinter(printer);
+          });
+      }) {
+    retry = std::make_unique<RetryEngine>();
+    ledger = std::make_unique<JobLedger>();
+    poolScheduler = std::make_unique<PrinterPoolScheduler>([this](const std::string& printer) {
+        return jobAPI->getQueuedJobCount(printer);
+    });
+    rateLimiter = std::make_unique<RateLimiter>();
+    submissionQueue = std::make_unique<SubmissionQueue>();
+    submissionQueue->setThrottle([this](const std::string& printer, uint64_t bytes) {
+        return rateLimiter->acquire(printer, bytes);
+    });
+    submissionQueue->setCompletionProbe([this](const std::string& printer, int jobId) {
+        // A stopped or jammed job ("error") is still queued and may yet print
+        return jobFinished(jobAPI->getJob(printer, jobId).state);
+    });
+}
+
+NativeCore::~NativeCore() {
+    // A replacement core may already be current if an environment started while this one was released
+    NativeCore* self = this;
+    g_currentCore.compare_exchange_strong(self, nullptr);
+}
+
+std::shared_ptr<NativeCore> NativeCore::acquire() {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+
+    std::shared_ptr<NativeCore> core = g_core.lock();
+    if (!core) {
+        core.reset(new NativeCore());
+        g_core = core;
+        g_currentCore.store(core.get());
+    }
+    return core;
+}
+
+NativeCore& NativeCore::current() {
+    return *g_currentCore.load();
+}
+
+void NativeCore::startStateTable(const void* owner, int32_t* words, uint32_t capacity, bool queueDepth,
+                                 int intervalMs) {
+    std::lock_guard<std::mutex> lock(stateTableMutex_);
+
+    if (stateTable_ && stateTableOwner_ != owner) {
+        throw PrinterException("A printer state table is already published by another thread; "
+                               "open its buffer with printers.attachStateTable()",
+                               PrinterErrorCode::UNSUPPORTED_OPERATION);
+    }
+    stateTable_.reset();
+
+    PrinterStateTable::QueueFn queued;
+    if (queueDepth) {
+        queued = [this]() {
+            AllJobsRequest request;
+            request.which = WhichJobs::ACTIVE;
+
+            std::map<std::string, int> depths;
+            for (const auto& group : jobAPI->getAllJobs(request)) {
+                depths[group.printer] = group.error.empty() ? static_cast<int>(group.jobs.size()) : -1;
+            }
+            return depths;
+        };
+    }
+    stateTable_ = std::make_unique<PrinterStateTable>(
+        words, capacity, [this]() { return printerAPI->getPrinters(); }, queued, intervalMs);
+    stateTableOwner_ = owner;
+}
+
+void NativeCore::stopStateTable(const void* owner) {
+    std::lock_guard<std::mutex> lock(stateTableMutex_);
+
+    if (stateTableOwner_ == owner) {
+        stateTable_.reset();
+        stateTableOwner_ = nullptr;
+    }
+}
+
+bool NativeCore::stateTableStats(PrinterStateTableStats& stats) {
+    std::lock_guard<std::mutex> lock(stateTableMutex_);
+
+    if (!stateTable_) {
+        return false;
+    }
+    stats = stateTable_->getStats();
+    return true;
+}
+
+} // namespace NodePrinter
@@ -0,0 +1,131 @@
+#pragma once
+#include "printer_api.h"
+#include "job_api.h"
+#include "printer_pool.h"
+#include "printer_health.h"
+#include "submission_queue.h"
+#include "rate_limiter.h"
+#include "retry_policy.h"
+#include "job_ledger.h"
+#include "printer_state_table.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace NodePrinter {
+
+/**
+ * Owning pointer whose object is created on first dereference
+ * Creation is thread-safe; a factory that throws leaves it empty for the next use to retry.
+ */
+template <typename T>
+class LazyPtr {
+public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    LazyPtr() = default;
+    explicit LazyPtr(Factory factory) : factory_(std::move(factory)) {}
+
+    // Non-copyable
+    LazyPtr(const LazyPtr&) = delete;
+    LazyPtr& operator=(const LazyPtr&) = delete;
+
+    T* get() {
+        T* value = value_.load(std::memory_order_acquire);
+        if (!value) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!owned_) {
+                owned_ = factory_();
+                value_.store(owned_.get(), std::memory_order_release);
+            }
+            value = owned_.get();
+        }
+        return value;
+    }
+
+    T* operator->() { return get(); }
+    T& operator*() { return *get(); }
+
+    // Whether the object exists, without creating it
+    bool created() const { return value_.load(std::memory_order_acquire) != nullptr; }
+
+private:
+    Factory factory_;
+    std::mutex mutex_;
+    std::unique_ptr<T> owned_;
+    std::atomic<T*> value_{nullptr};
+};
+
+/**
+ * Native state shared by every environment that loads the addon
+ *
+ * The main thread and each worker_thread get their own exports and instance
+ * data, but all of them reference one core: a single spooler backend, health
+ * cache, pool scheduler, submission queue, rate limiter, retry engine and
+ * ledger per process. The first environment creates it; it is destroyed when
+ * the last reference (an environment or an in-flight async task) is released.
+ * Every member is safe to use from any thread.
+ *
+ * The printer-state table poller is per process too: one environment owns the
+ * shared memory it writes, and the others read that table.
+ *
+ * Loading the addon only creates the core. The platform backends and the
+ * health cache (with its refresher thread) are created on first use, so
+ * importing the package makes no spooler or CUPS calls.
+ */
+class NativeCore {
+public:
+    /**
+     * The process-wide core, created if no environment holds one
+     */
+    static std::shared_ptr<NativeCore> acquire();
+
+    /**
+     * The live core; only valid while the caller holds, or runs under, a reference
+     */
+    static NativeCore& current();
+
+    ~NativeCore();
+
+    // Non-copyable
+    NativeCore(const NativeCore&) = delete;
+    NativeCore& operator=(const NativeCore&) = delete;
+
+    // Declared in dependency order, so the queue is stopped before the APIs it calls go away
+    LazyPtr<IPrinterAPI> printerAPI;
+    std::unique_ptr<RetryEngine> retry;
+    std::unique_ptr<JobLedger> ledger;
+    LazyPtr<IJobAPI> jobAPI;
+    std::unique_ptr<PrinterPoolScheduler> poolScheduler;
+    LazyPtr<PrinterHealthCache> printerHealth;
+    std::unique_ptr<RateLimiter> rateLimiter;
+    std::unique_ptr<SubmissionQueue> submissionQueue;
+
+    /**
+     * Start the process's state-table poller over memory the owner keeps alive
+     * Replaces a poller the same owner started; throws if another owner's is running.
+     * Queue depths come from one job listing per round.
+     */
+    void startStateTable(const void* owner, int32_t* words, uint32_t capacity, bool queueDepth, int intervalMs);
+
+    /**
+     * Stop the poller if owner started it; joins it, so the memory can be released on return
+     */
+    void stopStateTable(const void* owner);
+
+    /**
+     * Statistics of the running poller; false if none is running
+     */
+    bool stateTableStats(PrinterStateTableStats& stats);
+
+private:
+    NativeCore();
+
+    // Declared last, so the poller stops before anything it calls
+    std::mutex stateTableMutex_;
+    std::unique_ptr<PrinterStateTable> stateTable_;
+    const void* stateTableOwner_ = nullptr;
+};
+
+} // namespace NodePrinter
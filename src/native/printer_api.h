@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include <atomic>
 
 namespace NodePrinter {
 
@@ -14,6 +16,8 @@ struct PrinterInfo {
     std::string name;
     bool isDefault = false;
     std::string state;        // normalized: "idle", "printing", "stopped", "offline", "error"  
+    std::vector<std::string> stateReasons;  // IPP printer-state-reasons keywords ("media-empty-error", ...)
+    bool acceptingJobs = true;
     std::string location;
     std::string description;
     
@@ -34,6 +38,15 @@ struct PrinterCapabilities {
     bool color;
 };
 
+/**
+ * Incremental printer discovery parameters
+ */
+struct DiscoveryOptions {
+    int timeoutMs = 5000;     // How long to keep looking for network printers
+    uint32_t type = 0;        // Printer type bits that must be set (CUPS cups_ptype_t)
+    uint32_t mask = 0;        // Printer type bits to compare against type
+};
+
 /**
  * Abstract printer API interface
  * Platform-specific implementations must inherit from this
@@ -47,6 +60,22 @@ public:
      */
     virtual std::vector<PrinterInfo> getPrinters() = 0;
     
+    /**
+     * Discover printers incrementally, reporting each one as soon as it is found
+     * Runs on a worker thread. The default implementation reports getPrinters() in one go.
+     * @param onPrinter Called per printer; return false to stop discovery
+     * @param cancel Set to non-zero from another thread to abort discovery
+     */
+    virtual void discoverPrinters(const DiscoveryOptions& /*options*/,
+                                  const std::function<bool(const PrinterInfo&)>& onPrinter,
+                                  std::atomic<int>& cancel) {
+        for (const auto& printer : getPrinters()) {
+            if (cancel.load() != 0 || !onPrinter(printer)) {
+                return;
+            }
+        }
+    }
+    
     /**
      * Get information about a specific printer
      * @param name Printer name
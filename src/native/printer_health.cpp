@@ -0,0 +1,200 @@
+#include "printer_health.h"
+#include "errors.h"
+#include <exception>
+
+namespace NodePrinter {
+
+// Reasons that stop a printer from producing output even while its state looks idle
+static bool isBlockingReason(const std::string& reason) {
+    static const std::set<std::string> blocking = {
+        "offline-report",
+        "paused",
+        "shutdown",
+        "stopped",
+        "moving-to-paused",
+        "offline",
+        "not-available",
+        "paper-jam",
+        "door-open",
+        "user-intervention"
+    };
+
+    const std::string suffix = "-error";
+    if (reason.size() > suffix.size() &&
+        reason.compare(reason.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return true;
+    }
+    return blocking.count(reason) > 0;
+}
+
+PrinterHealthCache::PrinterHealthCache(LookupFn lookup, int ttlMs)
+    : lookup_(std::move(lookup)), ttl_(ttlMs) {
+    refresher_ = std::thread(&PrinterHealthCache::refreshLoop, this);
+}
+
+PrinterHealthCache::~PrinterHealthCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (refresher_.joinable()) {
+        refresher_.join();
+    }
+}
+
+PrinterHealth PrinterHealthCache::check(const std::string& printer) {
+    // Device URIs have no local queue to inspect; the submission reports failures
+    if (printer.find("://") != std::string::npos) {
+        return PrinterHealth();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(printer);
+        if (it != entries_.end()) {
+            if (Clock::now() - it->second.updated >= ttl_ && pending_.insert(printer).second) {
+                wake_.notify_one();
+            }
+            return it->second.health;
+        }
+    }
+
+    // First sighting: nothing cached to fall back on
+    PrinterHealth health = fetch(printer);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[printer] = {health, Clock::now()};
+    return health;
+}
+
+void PrinterHealthCache::markUnhealthy(const std::string& printer, const std::string& detail) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[printer];
+    entry.health.healthy = false;
+    entry.health.detail = detail;
+    entry.updated = Clock::now();
+}
+
+void PrinterHealthCache::prime(const std::vector<PrinterInfo>& printers) {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& info : printers) {
+        entries_[info.name] = {evaluate(info), now};
+    }
+}
+
+PrinterHealth PrinterHealthCache::evaluate(const PrinterInfo& info) {
+    PrinterHealth health;
+    health.state = info.state;
+    health.reasons = info.stateReasons;
+
+    if (info.state == "stopped" || info.state == "offline" || info.state == "error") {
+        health.healthy = false;
+        health.detail = "printer is " + info.state;
+    } else if (!info.acceptingJobs) {
+        health.healthy = false;
+        health.detail = "printer is not accepting jobs";
+    } else {
+        for (const auto& reason : info.stateReasons) {
+            if (isBlockingReason(reason)) {
+                health.healthy = false;
+                health.detail = "printer reports " + reason;
+                break;
+            }
+        }
+    }
+
+    return health;
+}
+
+PrinterHealth PrinterHealthCache::fetch(const std::string& printer) {
+    try {
+        return evaluate(lookup_(printer));
+    } catch (const std::exception& e) {
+        PrinterHealth health;
+        health.healthy = false;
+        health.detail = e.what();
+        return health;
+    }
+}
+
+void PrinterHealthCache::refreshLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        wake_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+        if (stopping_) {
+            return;
+        }
+
+        std::string printer = *pending_.begin();
+        lock.unlock();
+        PrinterHealth health = fetch(printer);
+        lock.lock();
+
+        pending_.erase(printer);
+        entries_[printer] = {health, Clock::now()};
+    }
+}
+
+FailoverPlan::FailoverPlan(PrinterHealthCache& health, std::vector<std::string> candidates)
+    : health_(health), candidates_(std::move(candidates)) {
+    if (candidates_.empty()) {
+        throw createInvalidArgumentsError("No printer to submit to");
+    }
+}
+
+std::string FailoverPlan::next() {
+    while (index_ < candidates_.size()) {
+        size_t i = index_++;
+        const std::string& printer = candidates_[i];
+        last_ = index_ == candidates_.size();
+
+        PrinterHealth status = health_.check(printer);
+        if (!status.healthy && !last_) {
+            submission_.skipped.emplace_back(printer, status.detail);
+            continue;
+        }
+
+        target_ = printer;
+
+        // Nothing healthy left: fall back to the primary rather than the last resort,
+        // unless the primary was already tried and refused the job
+        if (!status.healthy && i > 0) {
+            if (primaryTried_) {
+                std::rethrow_exception(lastError_);
+            }
+            submission_.skipped.erase(submission_.skipped.begin());
+            submission_.skipped.emplace_back(printer, status.detail);
+            target_ = candidates_[0];
+        }
+
+        primaryTried_ = primaryTried_ || target_ == candidates_[0];
+        return target_;
+    }
+
+    // failed() gives up on the last candidate, so next() is never called past it
+    throw createInvalidArgumentsError("No printer to submit to");
+}
+
+bool FailoverPlan::failed(const PrinterException& error) {
+    bool unreachable = error.getCode() == PrinterErrorCode::PRINTER_OFFLINE ||
+                       error.getCode() == PrinterErrorCode::PRINTER_NOT_FOUND;
+    if (!unreachable || last_) {
+        return false;
+    }
+
+    lastError_ = std::current_exception();
+    health_.markUnhealthy(target_, error.what());
+    submission_.skipped.emplace_back(target_, error.what());
+    return true;
+}
+
+FailoverSubmission& FailoverPlan::accepted(int jobId) {
+    submission_.jobId = jobId;
+    submission_.printer = target_;
+    return submission_;
+}
+
+} // namespace NodePrinter
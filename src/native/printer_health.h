@@ -0,0 +1,140 @@
+#pragma once
+#include "printer_api.h"
+#include "errors.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Whether a printer can take jobs right now
+ */
+struct PrinterHealth {
+    bool healthy = true;
+    std::string state;
+    std::vector<std::string> reasons;
+    std::string detail;           // Why the printer is considered unhealthy
+};
+
+/**
+ * Cached printer health for submission routing
+ *
+ * Entries younger than the TTL are answered from memory. Stale entries are
+ * still answered from memory while a background thread refreshes them, so
+ * only the very first check of a printer costs a round-trip.
+ */
+class PrinterHealthCache {
+public:
+    using LookupFn = std::function<PrinterInfo(const std::string& printer)>;
+
+    explicit PrinterHealthCache(LookupFn lookup, int ttlMs = 5000);
+    ~PrinterHealthCache();
+
+    // Non-copyable
+    PrinterHealthCache(const PrinterHealthCache&) = delete;
+    PrinterHealthCache& operator=(const PrinterHealthCache&) = delete;
+
+    PrinterHealth check(const std::string& printer);
+
+    /**
+     * Record a failure seen while submitting, so the next check skips the printer
+     */
+    void markUnhealthy(const std::string& printer, const std::string& detail);
+
+    /**
+     * Seed entries from an already-fetched printer list (warmup), without per-printer lookups
+     */
+    void prime(const std::vector<PrinterInfo>& printers);
+
+    /**
+     * Derive health from printer state, state reasons and accepting-jobs
+     */
+    static PrinterHealth evaluate(const PrinterInfo& info);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        PrinterHealth health;
+        Clock::time_point updated;
+    };
+
+    LookupFn lookup_;
+    std::chrono::milliseconds ttl_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::map<std::string, Entry> entries_;
+    std::set<std::string> pending_;     // Stale printers waiting for the refresher
+    bool stopping_ = false;
+    std::thread refresher_;
+
+    PrinterHealth fetch(const std::string& printer);
+    void refreshLoop();
+};
+
+/**
+ * Result of a submission with failover
+ */
+struct FailoverSubmission {
+    std::string printer;          // Printer that accepted the job
+    int jobId = 0;
+    std::vector<std::pair<std::string, std::string>> skipped;   // (printer, reason) passed over
+    double throttledMs = 0;       // Time spent waiting on rate limits
+};
+
+/**
+ * Submission to the first healthy printer of an ordered candidate list
+ *
+ * If every remaining candidate looks unhealthy the primary is used anyway, as
+ * without failover, unless it was already tried; then the last error is
+ * rethrown. A candidate that fails with PRINTER_OFFLINE/PRINTER_NOT_FOUND is
+ * skipped as well. Choosing and submitting are separate steps, so the caller
+ * can wait (e.g. on rate limits) in between:
+ *
+ *     for (;;) {
+ *         std::string printer = plan.next();
+ *         try { return plan.accepted(submit(printer)); }
+ *         catch (const PrinterException& e) { if (!plan.failed(e)) throw; }
+ *     }
+ */
+class FailoverPlan {
+public:
+    FailoverPlan(PrinterHealthCache& health, std::vector<std::string> candidates);
+
+    /**
+     * Printer to submit to next; health checks may block on a printer lookup
+     * @throws The last submission error when only an already-failed primary is left
+     */
+    std::string next();
+
+    /**
+     * Record that next()'s printer refused the job; call from the catch block
+     * @returns true to try the next candidate, false if the error should be rethrown
+     */
+    bool failed(const PrinterException& error);
+
+    /**
+     * Record that next()'s printer accepted the job
+     */
+    FailoverSubmission& accepted(int jobId);
+
+private:
+    PrinterHealthCache& health_;
+    std::vector<std::string> candidates_;
+    size_t index_ = 0;            // Next candidate to check
+    std::string target_;
+    bool last_ = false;           // No candidate left after target_
+    bool primaryTried_ = false;
+    std::exception_ptr lastError_;
+    FailoverSubmission submission_;
+};
+
+} // namespace NodePrinter
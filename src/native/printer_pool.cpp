@@ -0,0 +1,244 @@
+#include "printer_pool.h"
+#include "errors.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace NodePrinter {
+
+// Our own job sizes kept per printer; older entries have long since printed
+static const size_t MAX_TRACKED_JOBS = 256;
+
+PrinterPoolScheduler::PrinterPoolScheduler(QueueDepthFn queueDepth, int refreshMs)
+    : queueDepth_(std::move(queueDepth)), refreshInterval_(refreshMs) {}
+
+std::string PrinterPoolScheduler::acquire(const std::vector<std::string>& printers, PoolStrategy strategy,
+                                          uint64_t bytes) {
+    if (printers.empty()) {
+        throw createInvalidArgumentsError("Printer pool is empty");
+    }
+
+    if (strategy != PoolStrategy::ROUND_ROBIN) {
+        refreshStale(printers);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Start scanning at the pool's cursor so ties rotate instead of piling onto the first printer
+    std::string poolKey;
+    for (const auto& printer : printers) {
+        poolKey += printer;
+        poolKey += '\n';
+    }
+    size_t& cursor = cursors_[poolKey];
+    size_t start = cursor % printers.size();
+    cursor = start + 1;
+
+    size_t best = start;
+    if (strategy != PoolStrategy::ROUND_ROBIN) {
+        // Compare (primary, secondary); byte estimates fall back to job counts on ties
+        std::pair<uint64_t, uint64_t> bestScore(std::numeric_limits<uint64_t>::max(),
+                                                std::numeric_limits<uint64_t>::max());
+        for (size_t n = 0; n < printers.size(); ++n) {
+            size_t i = (start + n) % printers.size();
+            const PrinterState& state = printers_[printers[i]];
+            uint64_t jobs = static_cast<uint64_t>(estimatedJobs(state));
+            std::pair<uint64_t, uint64_t> score = strategy == PoolStrategy::LEAST_BYTES
+                ? std::make_pair(estimatedBytes(state), jobs)
+                : std::make_pair(jobs, estimatedBytes(state));
+            if (score < bestScore) {
+                bestScore = score;
+                best = i;
+            }
+        }
+    }
+
+    PrinterState& chosen = printers_[printers[best]];
+    ++chosen.inFlight;
+    chosen.inFlightBytes += bytes;
+    return printers[best];
+}
+
+void PrinterPoolScheduler::complete(const std::string& printer, uint64_t bytes, bool accepted) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PrinterState& state = printers_[printer];
+
+    if (state.inFlight > 0) --state.inFlight;
+    state.inFlightBytes -= std::min(state.inFlightBytes, bytes);
+
+    if (accepted) {
+        ++state.submittedSinceRefresh;
+        state.jobBytes.push_back(bytes);
+        if (state.jobBytes.size() > MAX_TRACKED_JOBS) {
+            state.jobBytes.pop_front();
+        }
+    }
+}
+
+std::vector<PrinterLoad> PrinterPoolScheduler::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<PrinterLoad> loads;
+    loads.reserve(printers_.size());
+
+    for (const auto& entry : printers_) {
+        PrinterLoad load;
+        load.printer = entry.first;
+        load.queuedJobs = estimatedJobs(entry.second);
+        load.queuedBytes = estimatedBytes(entry.second);
+        load.inFlight = entry.second.inFlight;
+        loads.push_back(std::move(load));
+    }
+
+    return loads;
+}
+
+void PrinterPoolScheduler::refreshStale(const std::vector<std::string>& printers) {
+    struct Pending {
+        std::string printer;
+        int submittedBefore;
+    };
+    std::vector<Pending> stale;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        for (const auto& printer : printers) {
+            PrinterState& state = printers_[printer];
+            if (state.refreshing || now - state.refreshed < refreshInterval_) continue;
+            state.refreshing = true;
+            stale.push_back({printer, state.submittedSinceRefresh});
+        }
+    }
+
+    // Query outside the lock; other submissions keep scheduling on the old estimates
+    for (const auto& entry : stale) {
+        int queued = -1;
+        try {
+            queued = queueDepth_(entry.printer);
+        } catch (const std::exception&) {
+            // Keep the previous estimate; the submission itself will surface the error
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        PrinterState& state = printers_[entry.printer];
+        state.refreshing = false;
+        state.refreshed = Clock::now();
+
+        if (queued >= 0) {
+            state.serverQueued = queued;
+            // Submissions accepted while the query was running are not in its count yet
+            state.submittedSinceRefresh = std::max(0, state.submittedSinceRefresh - entry.submittedBefore);
+
+            // Jobs leave the queue roughly in order, so only the newest ones are still waiting
+            size_t keep = static_cast<size_t>(queued + state.submittedSinceRefresh);
+            while (state.jobBytes.size() > keep) {
+                state.jobBytes.pop_front();
+            }
+        }
+    }
+}
+
+int PrinterPoolScheduler::estimatedJobs(const PrinterState& state) const {
+    return state.serverQueued + state.submittedSinceRefresh + state.inFlight;
+}
+
+uint64_t PrinterPoolScheduler::estimatedBytes(const PrinterState& state) const {
+    uint64_t known = 0;
+    for (uint64_t size : state.jobBytes) {
+        known += size;
+    }
+
+    // Jobs from other clients count at the average size of ours
+    size_t queued = static_cast<size_t>(state.serverQueued + state.submittedSinceRefresh);
+    uint64_t unknown = 0;
+    if (queued > state.jobBytes.size() && !state.jobBytes.empty()) {
+        unknown = (queued - state.jobBytes.size()) * (known / state.jobBytes.size());
+    }
+
+    return known + unknown + state.inFlightBytes;
+}
+
+int submitTo(IJobAPI& jobAPI, const std::string& printer, const PoolSubmitRequest& request) {
+    if (request.raw) {
+        PrintRawRequest rawRequest;
+        rawRequest.printer = printer;
+        rawRequest.data = request.data;
+        rawRequest.format = request.format;
+        rawRequest.options = request.options;
+        return jobAPI.printRaw(rawRequest);
+    }
+
+    PrintFileRequest fileRequest;
+    fileRequest.printer = printer;
+    fileRequest.filename = request.filename;
+    fileRequest.format = request.format;
+    fileRequest.options = request.options;
+    return jobAPI.printFile(fileRequest);
+}
+
+uint64_t fileBytes(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw createFileNotFoundError(filename);
+    }
+    return static_cast<uint64_t>(file.tellg());
+}
+
+uint64_t requestBytes(const PoolSubmitRequest& request) {
+    return request.raw ? request.data.size() : fileBytes(request.filename);
+}
+
+std::string choosePoolPrinter(PrinterPoolScheduler& scheduler, const PoolSubmitRequest& request, uint64_t bytes,
+                              PrinterHealthCache* health) {
+    std::vector<std::string> candidates;
+    if (health) {
+        for (const auto& printer : request.printers) {
+            if (health->check(printer).healthy) {
+                candidates.push_back(printer);
+            }
+        }
+    }
+    // With no healthy printer left, spread over the whole pool as before
+    if (candidates.empty()) {
+        candidates = request.printers;
+    }
+
+    return scheduler.acquire(candidates, request.strategy, bytes);
+}
+
+int submitToChosen(IJobAPI& jobAPI, PrinterPoolScheduler& scheduler, const std::string& printer,
+                   const PoolSubmitRequest& request, uint64_t bytes, PrinterHealthCache* health) {
+    int jobId = 0;
+    try {
+        jobId = submitTo(jobAPI, printer, request);
+    } catch (const PrinterException& e) {
+        scheduler.complete(printer, bytes, false);
+        if (health && (e.getCode() == PrinterErrorCode::PRINTER_OFFLINE ||
+                       e.getCode() == PrinterErrorCode::PRINTER_NOT_FOUND)) {
+            health->markUnhealthy(printer, e.what());
+        }
+        throw;
+    } catch (...) {
+        scheduler.complete(printer, bytes, false);
+        throw;
+    }
+
+    scheduler.complete(printer, bytes, true);
+    return jobId;
+}
+
+bool parsePoolStrategy(const std::string& name, PoolStrategy& strategy) {
+    if (name == "least-queued") {
+        strategy = PoolStrategy::LEAST_QUEUED;
+    } else if (name == "least-bytes") {
+        strategy = PoolStrategy::LEAST_BYTES;
+    } else if (name == "round-robin") {
+        strategy = PoolStrategy::ROUND_ROBIN;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace NodePrinter
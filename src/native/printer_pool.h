@@ -0,0 +1,156 @@
+#pragma once
+#include "job_api.h"
+#include "printer_health.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * How a printer is chosen from a pool
+ */
+enum class PoolStrategy {
+    LEAST_QUEUED,   // Fewest jobs waiting or printing
+    LEAST_BYTES,    // Fewest bytes waiting or printing
+    ROUND_ROBIN
+};
+
+/**
+ * Estimated load of one printer, as seen by the scheduler
+ */
+struct PrinterLoad {
+    std::string printer;
+    int queuedJobs = 0;           // Jobs on the printer plus submissions in flight
+    uint64_t queuedBytes = 0;     // Estimated bytes behind those jobs
+    int inFlight = 0;             // Submissions currently uploading
+};
+
+/**
+ * Picks a target printer for pool submissions
+ *
+ * Load is tracked from our own submissions and corrected by periodically
+ * asking each printer for its queue length (queued-job-count on CUPS), so
+ * jobs submitted by other clients are accounted for as well.
+ */
+class PrinterPoolScheduler {
+public:
+    using QueueDepthFn = std::function<int(const std::string& printer)>;
+
+    explicit PrinterPoolScheduler(QueueDepthFn queueDepth, int refreshMs = 2000);
+
+    // Non-copyable
+    PrinterPoolScheduler(const PrinterPoolScheduler&) = delete;
+    PrinterPoolScheduler& operator=(const PrinterPoolScheduler&) = delete;
+
+    /**
+     * Choose a printer and reserve an in-flight slot for a submission of `bytes`
+     * Every call must be paired with complete().
+     */
+    std::string acquire(const std::vector<std::string>& printers, PoolStrategy strategy, uint64_t bytes);
+
+    /**
+     * Finish a submission started with acquire()
+     * @param accepted True when the printer accepted the job
+     */
+    void complete(const std::string& printer, uint64_t bytes, bool accepted);
+
+    /**
+     * Current load estimates for every printer seen so far
+     */
+    std::vector<PrinterLoad> snapshot();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PrinterState {
+        int serverQueued = 0;           // Queue length at the last refresh
+        int submittedSinceRefresh = 0;  // Accepted submissions not yet seen by a refresh
+        int inFlight = 0;
+        uint64_t inFlightBytes = 0;
+        std::deque<uint64_t> jobBytes;  // Sizes of our recent jobs, newest at the back
+        Clock::time_point refreshed;
+        bool refreshing = false;
+    };
+
+    QueueDepthFn queueDepth_;
+    std::chrono::milliseconds refreshInterval_;
+    std::mutex mutex_;
+    std::map<std::string, PrinterState> printers_;
+    std::map<std::string, size_t> cursors_;     // Round-robin position per pool
+
+    void refreshStale(const std::vector<std::string>& printers);
+    int estimatedJobs(const PrinterState& state) const;
+    uint64_t estimatedBytes(const PrinterState& state) const;
+};
+
+/**
+ * Submission to a pool of equivalent printers
+ * Exactly one of filename/data is used, selected by `raw`.
+ */
+struct PoolSubmitRequest {
+    std::vector<std::string> printers;
+    PoolStrategy strategy = PoolStrategy::LEAST_QUEUED;
+    bool raw = false;
+    std::string filename;
+    std::vector<uint8_t> data;
+    std::string format;           // Raw data format ("RAW", "TEXT", ...), or "DETECT"
+    PrintOptions options;
+};
+
+/**
+ * Where a pool submission ended up
+ */
+struct PoolSubmission {
+    std::string printer;
+    int jobId = 0;
+    double throttledMs = 0;       // Time spent waiting on rate limits
+};
+
+/**
+ * Choose a printer from the pool and reserve a slot on it for the job
+ * The slot counts as load on the printer until submitToChosen() releases it,
+ * including any rate-limit wait in between.
+ * @param health When given, printers that look unhealthy are left out of the choice
+ */
+std::string choosePoolPrinter(PrinterPoolScheduler& scheduler, const PoolSubmitRequest& request, uint64_t bytes,
+                              PrinterHealthCache* health = nullptr);
+
+/**
+ * Submit a job to the printer choosePoolPrinter() picked and release its slot
+ * @param health When given, a printer that turns out to be unreachable is marked unhealthy
+ * @throws PrinterException if the printer rejects the job
+ */
+int submitToChosen(IJobAPI& jobAPI, PrinterPoolScheduler& scheduler, const std::string& printer,
+                   const PoolSubmitRequest& request, uint64_t bytes, PrinterHealthCache* health = nullptr);
+
+/**
+ * Submit a file or raw data to one printer
+ * @returns Job ID
+ */
+int submitTo(IJobAPI& jobAPI, const std::string& printer, const PoolSubmitRequest& request);
+
+/**
+ * Size of a request's raw data or file
+ * @throws PrinterException (FILE_NOT_FOUND) if the file cannot be opened
+ */
+uint64_t requestBytes(const PoolSubmitRequest& request);
+
+/**
+ * Size of a file to be printed
+ * @throws PrinterException (FILE_NOT_FOUND) if the file cannot be opened
+ */
+uint64_t fileBytes(const std::string& filename);
+
+/**
+ * Parse a strategy name ("least-queued", "least-bytes", "round-robin")
+ * @returns false for unknown names
+ */
+bool parsePoolStrategy(const std::string& name, PoolStrategy& strategy);
+
+} // namespace NodePrinter
@@ -0,0 +1,206 @@
+#include "printer_state_table.h"
+#include "printer_health.h"
+#include <algorithm>
+#include <cstring>
+
+namespace NodePrinter {
+
+using namespace StateTableLayout;
+
+static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "shared words must be plain 32-bit integers");
+
+static int32_t stateCode(const std::string& state) {
+    if (state == "idle") return IDLE;
+    if (state == "printing") return PRINTING;
+    if (state == "stopped") return STOPPED;
+    if (state == "offline") return OFFLINE;
+    if (state == "error") return ERROR_STATE;
+    return UNKNOWN;
+}
+
+PrinterStateTable::PrinterStateTable(int32_t* words, uint32_t capacity, ListFn list, QueueFn queued, int intervalMs)
+    : words_(reinterpret_cast<std::atomic<int32_t>*>(words)),
+      capacity_(capacity),
+      list_(std::move(list)),
+      queued_(std::move(queued)),
+      interval_(std::max(intervalMs, 100)) {
+    // Start from an empty table; readers check the magic before trusting anything else
+    for (size_t i = 0; i < wordsFor(capacity_); ++i) {
+        store(i, 0);
+    }
+    store(H_VERSION, VERSION);
+    store(H_CAPACITY, static_cast<int32_t>(capacity_));
+    store(H_MAGIC, MAGIC);
+
+    poller_ = std::thread(&PrinterStateTable::pollLoop, this);
+}
+
+PrinterStateTable::~PrinterStateTable() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (poller_.joinable()) {
+        poller_.join();
+    }
+}
+
+PrinterStateTableStats PrinterStateTable::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void PrinterStateTable::store(size_t word, int32_t value) {
+    words_[word].store(value, std::memory_order_relaxed);
+}
+
+int32_t PrinterStateTable::load(size_t word) {
+    return words_[word].load(std::memory_order_relaxed);
+}
+
+void PrinterStateTable::pollLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopping_) {
+        lock.unlock();
+
+        std::vector<PrinterInfo> printers;
+        std::vector<int> queued;
+        bool failed = false;
+        try {
+            printers = list_();
+
+            // One job listing per round for every printer, not a spooler call per printer
+            std::map<std::string, int> depths;
+            bool depthsKnown = false;
+            if (queued_) {
+                try {
+                    depths = queued_();
+                    depthsKnown = true;
+                } catch (const std::exception&) {
+                }
+            }
+
+            queued.reserve(printers.size());
+            for (const auto& printer : printers) {
+                int depth = 0;
+                if (queued_) {
+                    auto it = depths.find(printer.name);
+                    if (!depthsKnown) {
+                        depth = -1;       // Unknown this round
+                    } else if (it != depths.end()) {
+                        depth = it->second;
+                    }
+                }
+                queued.push_back(depth);
+            }
+        } catch (const std::exception&) {
+            failed = true;
+        }
+        publish(printers, queued, failed);
+
+        lock.lock();
+        wake_.wait_for(lock, interval_, [this]() { return stopping_; });
+    }
+}
+
+void PrinterStateTable::publish(const std::vector<PrinterInfo>& printers, const std::vector<int>& queued,
+                                bool failed) {
+    int32_t sequence = load(H_SEQUENCE);
+    store(H_SEQUENCE, sequence + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Every write below carries the sequence readers will see once it is even again
+    int32_t published = sequence + 2;
+    uint64_t changes = 0;
+    uint32_t dropped = 0;
+
+    if (!failed) {
+        std::vector<bool> seen(rows_.size(), false);
+
+        for (size_t i = 0; i < printers.size(); ++i) {
+            const PrinterInfo& info = printers[i];
+            auto it = rowsByName_.find(info.name);
+            uint32_t index;
+
+            if (it != rowsByName_.end()) {
+                index = it->second;
+            } else if (rows_.size() < capacity_) {
+                index = static_cast<uint32_t>(rows_.size());
+                rowsByName_[info.name] = index;
+                rows_.emplace_back();
+                rows_[index].state = -1;      // Force the first write
+                seen.push_back(false);
+
+                // Names are written once, when the row is assigned
+                size_t base = HEADER_WORDS + index * ROW_WORDS;
+                size_t length = std::min(info.name.size(), NAME_BYTES);
+                uint8_t name[NAME_BYTES] = {0};
+                std::memcpy(name, info.name.data(), length);
+                for (size_t w = 0; w < NAME_BYTES / 4; ++w) {
+                    int32_t packed;
+                    std::memcpy(&packed, name + w * 4, sizeof(packed));
+                    store(base + R_NAME + w, packed);
+                }
+                store(base + R_NAME_LENGTH, static_cast<int32_t>(length));
+                store(H_COUNT, static_cast<int32_t>(rows_.size()));
+                store(H_LAYOUT, load(H_LAYOUT) + 1);
+            } else {
+                ++dropped;
+                continue;
+            }
+            seen[index] = true;
+
+            Row row;
+            row.state = stateCode(info.state);
+            row.flags = PRESENT;
+            if (info.acceptingJobs) row.flags |= ACCEPTING;
+            if (PrinterHealthCache::evaluate(info).healthy) row.flags |= HEALTHY;
+            row.queued = queued[i] >= 0 ? queued[i] : rows_[index].queued;
+
+            Row& current = rows_[index];
+            if (row.state != current.state || row.flags != current.flags || row.queued != current.queued) {
+                size_t base = HEADER_WORDS + index * ROW_WORDS;
+                store(base + R_STATE, row.state);
+                store(base + R_FLAGS, row.flags);
+                store(base + R_QUEUED, row.queued);
+                store(base + R_CHANGED, published);
+                current = row;
+                ++changes;
+            }
+        }
+
+        // Printers that disappeared keep their row (indexes never move) but lose PRESENT
+        for (uint32_t index = 0; index < rows_.size(); ++index) {
+            if (!seen[index] && (rows_[index].flags & PRESENT)) {
+                size_t base = HEADER_WORDS + index * ROW_WORDS;
+                rows_[index].flags = 0;
+                store(base + R_FLAGS, 0);
+                store(base + R_CHANGED, published);
+                ++changes;
+            }
+        }
+    }
+
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+    store(H_POLLED_HI, static_cast<int32_t>(now >> 32));
+    store(H_POLLED_LO, static_cast<int32_t>(now & 0xFFFFFFFF));
+    store(H_POLLS, load(H_POLLS) + 1);
+    if (failed) {
+        store(H_POLL_ERRORS, load(H_POLL_ERRORS) + 1);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    words_[H_SEQUENCE].store(published, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.polls;
+    if (failed) ++stats_.pollErrors;
+    stats_.changes += changes;
+    stats_.printers = static_cast<uint32_t>(rows_.size());
+    stats_.dropped = dropped;
+}
+
+} // namespace NodePrinter
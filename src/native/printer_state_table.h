@@ -0,0 +1,122 @@
+#pragma once
+#include "printer_api.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Fixed layout of the shared state table, in 32-bit words
+ *
+ * Header: magic, version, seqlock sequence, row capacity, rows in use, layout
+ * generation (bumped when a row is assigned a printer), last poll time in ms
+ * (high and low words), poll count and poll errors.
+ *
+ * Row: state code, flags, queue depth, sequence of the last change, name
+ * length in bytes, three reserved words, then the UTF-8 name.
+ *
+ * Writers bump the sequence to odd, write, and bump it back to even; readers
+ * retry while it is odd or changed underneath them.
+ */
+namespace StateTableLayout {
+    const int32_t MAGIC = 0x5453504E;     // "NPST"
+    const int32_t VERSION = 1;
+
+    const size_t HEADER_WORDS = 16;
+    const size_t H_MAGIC = 0, H_VERSION = 1, H_SEQUENCE = 2, H_CAPACITY = 3, H_COUNT = 4,
+                 H_LAYOUT = 5, H_POLLED_HI = 6, H_POLLED_LO = 7, H_POLLS = 8, H_POLL_ERRORS = 9;
+
+    const size_t NAME_BYTES = 128;
+    const size_t ROW_WORDS = 8 + NAME_BYTES / 4;
+    const size_t R_STATE = 0, R_FLAGS = 1, R_QUEUED = 2, R_CHANGED = 3, R_NAME_LENGTH = 4, R_NAME = 8;
+
+    enum StateCode : int32_t {
+        UNKNOWN = 0,
+        IDLE,
+        PRINTING,
+        STOPPED,
+        OFFLINE,
+        ERROR_STATE
+    };
+
+    enum Flags : int32_t {
+        PRESENT = 1,              // Listed by the last poll
+        ACCEPTING = 2,            // Accepting jobs
+        HEALTHY = 4               // Would be used by failover routing
+    };
+
+    inline size_t wordsFor(uint32_t capacity) {
+        return HEADER_WORDS + static_cast<size_t>(capacity) * ROW_WORDS;
+    }
+}
+
+struct PrinterStateTableStats {
+    uint64_t polls = 0;
+    uint64_t pollErrors = 0;
+    uint64_t changes = 0;         // Row updates published
+    uint32_t printers = 0;
+    uint32_t dropped = 0;         // Printers beyond the table's capacity
+};
+
+/**
+ * One poller publishing printer state into caller-owned shared memory
+ *
+ * The memory (a SharedArrayBuffer on the JavaScript side) must outlive the
+ * table; the destructor stops the poller before returning.
+ */
+class PrinterStateTable {
+public:
+    using ListFn = std::function<std::vector<PrinterInfo>()>;
+    using QueueFn = std::function<std::map<std::string, int>()>;
+
+    /**
+     * @param queued Queue depth of every printer from one listing (-1 where unknown,
+     *               absent for an empty queue); empty to leave depths at 0
+     */
+    PrinterStateTable(int32_t* words, uint32_t capacity, ListFn list, QueueFn queued, int intervalMs);
+    ~PrinterStateTable();
+
+    // Non-copyable
+    PrinterStateTable(const PrinterStateTable&) = delete;
+    PrinterStateTable& operator=(const PrinterStateTable&) = delete;
+
+    PrinterStateTableStats getStats();
+
+private:
+    struct Row {
+        int32_t state = 0;
+        int32_t flags = 0;
+        int32_t queued = 0;
+    };
+
+    std::atomic<int32_t>* words_;
+    uint32_t capacity_;
+    ListFn list_;
+    QueueFn queued_;
+    std::chrono::milliseconds interval_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread poller_;
+
+    // Only touched by the poller, except stats_ (under mutex_)
+    std::map<std::string, uint32_t> rowsByName_;
+    std::vector<Row> rows_;
+    PrinterStateTableStats stats_;
+
+    void pollLoop();
+    void publish(const std::vector<PrinterInfo>& printers, const std::vector<int>& queued, bool failed);
+    void store(size_t word, int32_t value);
+    int32_t load(size_t word);
+};
+
+} // namespace NodePrinter
@@ -0,0 +1,285 @@
+#include "raster_encoder.h"
+#include "errors.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NODE_PRINTER_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace NodePrinter {
+
+// PWG 5102.4 page header (the cups_page_header2_t layout, big-endian)
+static const size_t PWG_HEADER_SIZE = 1796;
+static const size_t URF_HEADER_SIZE = 32;
+
+// Color spaces as numbered by CUPS (cups_cspace_t)
+static const uint32_t CSPACE_K = 3;
+static const uint32_t CSPACE_SGRAY = 18;
+static const uint32_t CSPACE_SRGB = 19;
+
+// Longest run or literal group a control byte can describe
+static const size_t MAX_GROUP = 128;
+
+// Most lines a line-repeat byte can describe
+static const size_t MAX_LINE_REPEAT = 256;
+
+static void putUInt32(uint8_t* at, uint32_t value) {
+    at[0] = static_cast<uint8_t>(value >> 24);
+    at[1] = static_cast<uint8_t>(value >> 16);
+    at[2] = static_cast<uint8_t>(value >> 8);
+    at[3] = static_cast<uint8_t>(value);
+}
+
+static void putFloat(uint8_t* at, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putUInt32(at, bits);
+}
+
+static void putString(uint8_t* at, const std::string& value) {
+    // 64-byte fields, always NUL-terminated
+    std::memcpy(at, value.data(), value.size() < 63 ? value.size() : 63);
+}
+
+#ifdef NODE_PRINTER_SSE2
+static unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+/**
+ * Length of the common prefix of a and b, at most n bytes
+ */
+static size_t matchingBytes(const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+#ifdef NODE_PRINTER_SSE2
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned differ = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+        if (differ) {
+            return i + lowestBit(differ);
+        }
+    }
+#endif
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Compress one line of `pixels` pixels of `bytesPerPixel` bytes each
+ *
+ * A run of k equal pixels is the byte k-1 followed by the pixel; a group of
+ * k differing pixels is the byte 257-k followed by the pixels. Comparing the
+ * line against itself shifted by one pixel finds the end of a run with
+ * 16-byte compares regardless of pixel size.
+ */
+static void encodeLine(const uint8_t* line, size_t pixels, size_t bytesPerPixel, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < pixels) {
+        const uint8_t* p = line + i * bytesPerPixel;
+        size_t limit = pixels - i < MAX_GROUP ? pixels - i : MAX_GROUP;
+
+        size_t run = 1 + matchingBytes(p, p + bytesPerPixel, (limit - 1) * bytesPerPixel) / bytesPerPixel;
+        if (run > 1 || limit == 1) {
+            out.push_back(static_cast<uint8_t>(run - 1));
+            out.insert(out.end(), p, p + bytesPerPixel);
+            i += run;
+            continue;
+        }
+
+        // Literal group: stop where the next run begins
+        size_t count = 1;
+        while (count < limit) {
+            const uint8_t* next = p + count * bytesPerPixel;
+            if (count + 1 < pixels - i && std::memcmp(next, next + bytesPerPixel, bytesPerPixel) == 0) {
+                break;
+            }
+            ++count;
+        }
+
+        // A lone pixel before a run is sent as a run of one
+        out.push_back(static_cast<uint8_t>(count == 1 ? 0 : 257 - count));
+        out.insert(out.end(), p, p + count * bytesPerPixel);
+        i += count;
+    }
+}
+
+static void encodePage(const RasterPage& page, size_t bytesPerLine, size_t bytesPerPixel, std::vector<uint8_t>& out) {
+    const uint8_t* data = page.data.data();
+    size_t pixels = bytesPerLine / bytesPerPixel;
+
+    size_t y = 0;
+    while (y < page.height) {
+        const uint8_t* line = data + y * bytesPerLine;
+
+        // Identical following lines are sent once with a repeat count
+        size_t repeat = 1;
+        while (y + repeat < page.height && repeat < MAX_LINE_REPEAT &&
+               matchingBytes(line, line + repeat * bytesPerLine, bytesPerLine) == bytesPerLine) {
+            ++repeat;
+        }
+
+        out.push_back(static_cast<uint8_t>(repeat - 1));
+        encodeLine(line, pixels, bytesPerPixel, out);
+        y += repeat;
+    }
+}
+
+static void writePwgHeader(const RasterPage& page, const RasterOptions& options, uint32_t totalPages,
+                           uint32_t bytesPerLine, std::vector<uint8_t>& out) {
+    size_t start = out.size();
+    out.resize(start + PWG_HEADER_SIZE, 0);
+    uint8_t* h = out.data() + start;
+
+    bool bilevel = page.bitsPerPixel == 1;
+    bool color = page.bitsPerPixel == 24;
+
+    putString(h + 0, "PwgRaster");                                      // MediaClass
+    putUInt32(h + 276, options.xResolution);                            // HWResolution
+    putUInt32(h + 280, options.yResolution);
+    putUInt32(h + 340, 1);                                              // NumCopies
+    putUInt32(h + 352, page.width * 72 / options.xResolution);          // PageSize (points)
+    putUInt32(h + 356, page.height * 72 / options.yResolution);
+    putUInt32(h + 372, page.width);                                     // cupsWidth
+    putUInt32(h + 376, page.height);                                    // cupsHeight
+    putUInt32(h + 384, bilevel ? 1 : 8);                                // cupsBitsPerColor
+    putUInt32(h + 388, page.bitsPerPixel);                              // cupsBitsPerPixel
+    putUInt32(h + 392, bytesPerLine);                                   // cupsBytesPerLine
+    putUInt32(h + 400, bilevel ? CSPACE_K : color ? CSPACE_SRGB : CSPACE_SGRAY);
+    putUInt32(h + 420, color ? 3 : 1);                                  // cupsNumColors
+    putFloat(h + 428, page.width * 72.0f / options.xResolution);        // cupsPageSize
+    putFloat(h + 432, page.height * 72.0f / options.yResolution);
+
+    // cupsInteger[]: TotalPageCount, Cross/FeedTransform, ImageBox, AlternatePrimary
+    putUInt32(h + 452, totalPages);
+    putUInt32(h + 456, 1);
+    putUInt32(h + 460, 1);
+    putUInt32(h + 476, page.width);
+    putUInt32(h + 480, page.height);
+    putUInt32(h + 484, 0xFFFFFF);
+
+    putString(h + 1732, options.mediaName);                             // cupsPageSizeName
+}
+
+static void writeUrfHeader(const RasterPage& page, const RasterOptions& options, std::vector<uint8_t>& out) {
+    size_t start = out.size();
+    out.resize(start + URF_HEADER_SIZE, 0);
+    uint8_t* h = out.data() + start;
+
+    h[0] = static_cast<uint8_t>(page.bitsPerPixel);
+    h[1] = page.bitsPerPixel == 24 ? 1 : 0;     // sRGB : sGray
+    h[2] = 1;                                   // Simplex; sides comes from the job
+    putUInt32(h + 12, page.width);
+    putUInt32(h + 16, page.height);
+    putUInt32(h + 20, options.xResolution);
+}
+
+static uint32_t bytesPerLineOf(const RasterPage& page) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(page.width) * page.bitsPerPixel + 7) / 8);
+}
+
+static void validate(const std::vector<RasterPage>& pages, const RasterOptions& options) {
+    if (pages.empty()) {
+        throw createInvalidArgumentsError("At least one raster page is required");
+    }
+
+    if (options.xResolution == 0 || options.yResolution == 0) {
+        throw createInvalidArgumentsError("Raster resolution must be positive");
+    }
+
+    if (options.format == RasterFormat::URF && options.xResolution != options.yResolution) {
+        throw createInvalidArgumentsError("URF requires the same horizontal and vertical resolution");
+    }
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const RasterPage& page = pages[i];
+        std::string which = "Raster page " + std::to_string(i + 1);
+
+        bool supported = page.bitsPerPixel == 8 || page.bitsPerPixel == 24 ||
+                         (page.bitsPerPixel == 1 && options.format == RasterFormat::PWG);
+        if (!supported) {
+            throw createInvalidArgumentsError(which + ": unsupported bpp " + std::to_string(page.bitsPerPixel) +
+                                              (options.format == RasterFormat::URF ? " (URF takes 8 or 24)"
+                                                                                   : " (PWG takes 1, 8 or 24)"));
+        }
+
+        if (page.width == 0 || page.height == 0) {
+            throw createInvalidArgumentsError(which + " has no pixels");
+        }
+
+        uint64_t needed = static_cast<uint64_t>(bytesPerLineOf(page)) * page.height;
+        if (page.data.size() < needed) {
+            throw createInvalidArgumentsError(which + " data is " + std::to_string(page.data.size()) +
+                                              " bytes, expected " + std::to_string(needed));
+        }
+    }
+}
+
+std::vector<uint8_t> encodeRaster(const std::vector<RasterPage>& pages, const RasterOptions& options) {
+    validate(pages, options);
+
+    // Typical label and document bitmaps compress well; start at a quarter of the input
+    size_t input = 0;
+    for (const auto& page : pages) {
+        input += page.data.size();
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(input / 4 + pages.size() * PWG_HEADER_SIZE + 16);
+
+    if (options.format == RasterFormat::PWG) {
+        const char sync[] = {'R', 'a', 'S', '2'};
+        out.insert(out.end(), sync, sync + sizeof(sync));
+    } else {
+        const char sync[] = {'U', 'N', 'I', 'R', 'A', 'S', 'T', '\0'};
+        out.insert(out.end(), sync, sync + sizeof(sync));
+        out.resize(out.size() + 4);
+        putUInt32(out.data() + out.size() - 4, static_cast<uint32_t>(pages.size()));
+    }
+
+    for (const auto& page : pages) {
+        uint32_t bytesPerLine = bytesPerLineOf(page);
+
+        if (options.format == RasterFormat::PWG) {
+            writePwgHeader(page, options, static_cast<uint32_t>(pages.size()), bytesPerLine, out);
+        } else {
+            writeUrfHeader(page, options, out);
+        }
+
+        // Bilevel lines are compressed a byte (8 pixels) at a time
+        size_t bytesPerPixel = page.bitsPerPixel == 1 ? 1 : page.bitsPerPixel / 8;
+        encodePage(page, bytesPerLine, bytesPerPixel, out);
+    }
+
+    return out;
+}
+
+const char* rasterMimeType(RasterFormat format) {
+    return format == RasterFormat::URF ? "image/urf" : "image/pwg-raster";
+}
+
+bool parseRasterFormat(const std::string& name, RasterFormat& format) {
+    if (name == "pwg") {
+        format = RasterFormat::PWG;
+    } else if (name == "urf") {
+        format = RasterFormat::URF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace NodePrinter
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Raster stream flavour
+ */
+enum class RasterFormat {
+    PWG,        // PWG Raster (PWG 5102.4), image/pwg-raster
+    URF         // Apple raster, image/urf
+};
+
+/**
+ * One uncompressed page, rows top to bottom with no padding beyond whole bytes
+ *   1 bpp: bilevel, 1 = black (PWG only)
+ *   8 bpp: sGray, 0 = black
+ *  24 bpp: sRGB, R G B
+ */
+struct RasterPage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bitsPerPixel = 8;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Stream-wide settings
+ */
+struct RasterOptions {
+    RasterFormat format = RasterFormat::PWG;
+    uint32_t xResolution = 300;   // DPI
+    uint32_t yResolution = 300;   // DPI (URF requires both to match)
+    std::string mediaName;        // PWG self-describing media name, e.g. "na_letter_8.5x11in" (optional)
+};
+
+/**
+ * Encode pages into a complete PWG or URF raster stream
+ * Lines are compressed with the PackBits variant both formats share: a
+ * line-repeat count, then runs of repeated pixels and literal pixel groups.
+ * @throws PrinterException (INVALID_ARGUMENTS) for unsupported depths or short page data
+ */
+std::vector<uint8_t> encodeRaster(const std::vector<RasterPage>& pages, const RasterOptions& options);
+
+/**
+ * MIME type of a raster format ("image/pwg-raster" or "image/urf")
+ */
+const char* rasterMimeType(RasterFormat format);
+
+/**
+ * Parse "pwg" or "urf"
+ * @returns false for unknown names
+ */
+bool parseRasterFormat(const std::string& name, RasterFormat& format);
+
+} // namespace NodePrinter
@@ -0,0 +1,159 @@
+#include "rate_limiter.h"
+#include <algorithm>
+#include <thread>
+
+namespace NodePrinter {
+
+static const RateLimit& limitFor(const std::map<std::string, RateLimit>& limits, const RateLimit& fallback,
+                                 const std::string& name) {
+    auto it = limits.find(name);
+    return it != limits.end() ? it->second : fallback;
+}
+
+double RateLimiter::Bucket::take(double rate, double burst, double amount, Clock::time_point now) {
+    if (rate <= 0) {
+        return 0;
+    }
+
+    if (!primed) {
+        tokens = burst;
+        primed = true;
+    } else {
+        double elapsed = std::chrono::duration<double>(now - updated).count();
+        tokens = std::min(burst, tokens + rate * elapsed);
+    }
+    updated = now;
+
+    tokens -= amount;
+    return tokens < 0 ? -tokens / rate : 0;
+}
+
+void RateLimiter::configure(const RateLimiterConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    printers_.clear();
+    servers_.clear();
+
+    enabled_ = config_.printer.limited() || config_.server.limited();
+    for (const auto& entry : config_.printers) {
+        enabled_ = enabled_ || entry.second.limited();
+    }
+    for (const auto& entry : config_.servers) {
+        enabled_ = enabled_ || entry.second.limited();
+    }
+}
+
+RateLimiterConfig RateLimiter::getConfig() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+bool RateLimiter::enabled() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+double RateLimiter::reserve(const std::string& printer, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return 0;
+    }
+
+    auto now = Clock::now();
+    std::string server = serverOf(printer);
+    const RateLimit& printerLimit = limitFor(config_.printers, config_.printer, printer);
+    const RateLimit& serverLimit = limitFor(config_.servers, config_.server, server);
+
+    Limited* printerState = nullptr;
+    Limited* serverState = nullptr;
+    double printerWait = 0;
+    double serverWait = 0;
+
+    if (printerLimit.limited()) {
+        printerState = &printers_[printer];
+        printerWait = reserveLimited(*printerState, printerLimit, bytes, now);
+    }
+    if (serverLimit.limited()) {
+        serverState = &servers_[server];
+        serverWait = reserveLimited(*serverState, serverLimit, bytes, now);
+    }
+
+    double wait = std::max(printerWait, serverWait);
+    if (wait <= 0) {
+        return 0;
+    }
+
+    // Charge the wait to whichever limit caused it
+    if (printerWait > 0) {
+        ++printerState->throttled;
+        printerState->throttledMs += printerWait * 1000;
+    }
+    if (serverWait > 0) {
+        ++serverState->throttled;
+        serverState->throttledMs += serverWait * 1000;
+    }
+    return wait * 1000;
+}
+
+double RateLimiter::acquire(const std::string& printer, uint64_t bytes) {
+    double waitMs = reserve(printer, bytes);
+    if (waitMs <= 0) {
+        return 0;
+    }
+
+    auto started = Clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(waitMs));
+    return std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+}
+
+std::vector<RateLimiterStats> RateLimiter::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<RateLimiterStats> stats;
+    stats.reserve(printers_.size() + servers_.size());
+
+    for (const auto& entry : printers_) {
+        RateLimiterStats printerStats;
+        printerStats.name = entry.first;
+        printerStats.throttled = entry.second.throttled;
+        printerStats.throttledMs = entry.second.throttledMs;
+        stats.push_back(std::move(printerStats));
+    }
+
+    for (const auto& entry : servers_) {
+        RateLimiterStats serverStats;
+        serverStats.name = entry.first;
+        serverStats.server = true;
+        serverStats.throttled = entry.second.throttled;
+        serverStats.throttledMs = entry.second.throttledMs;
+        stats.push_back(std::move(serverStats));
+    }
+
+    return stats;
+}
+
+std::string RateLimiter::serverOf(const std::string& printer) {
+    size_t scheme = printer.find("://");
+    if (scheme != std::string::npos) {
+        size_t start = scheme + 3;
+        size_t end = printer.find('/', start);
+        return printer.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    }
+
+    if (printer.compare(0, 2, "\\\\") == 0) {
+        size_t end = printer.find('\\', 2);
+        return printer.substr(2, end == std::string::npos ? std::string::npos : end - 2);
+    }
+
+    return "default";
+}
+
+double RateLimiter::reserveLimited(Limited& state, const RateLimit& limit, uint64_t bytes, Clock::time_point now) {
+    double burstJobs = limit.burstJobs > 0 ? limit.burstJobs : std::max(1.0, limit.jobsPerSecond);
+    double burstBytes = limit.burstBytes > 0 ? limit.burstBytes : limit.bytesPerSecond;
+
+    double jobsWait = state.jobs.take(limit.jobsPerSecond, burstJobs, 1, now);
+    double bytesWait = state.bytes.take(limit.bytesPerSecond, burstBytes, static_cast<double>(bytes), now);
+    return std::max(jobsWait, bytesWait);
+}
+
+} // namespace NodePrinter
@@ -0,0 +1,123 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Token-bucket limits for one printer or server (0 = unlimited)
+ */
+struct RateLimit {
+    double jobsPerSecond = 0;
+    double bytesPerSecond = 0;
+    double burstJobs = 0;         // Bucket size; defaults to one second's worth (at least one job)
+    double burstBytes = 0;
+
+    bool limited() const { return jobsPerSecond > 0 || bytesPerSecond > 0; }
+};
+
+/**
+ * Rate limits by printer and by the server that spools for it
+ */
+struct RateLimiterConfig {
+    RateLimit printer;                          // Applies to every printer without its own entry
+    RateLimit server;                           // Applies to every server without its own entry
+    std::map<std::string, RateLimit> printers;
+    std::map<std::string, RateLimit> servers;   // Keyed by RateLimiter::serverOf()
+};
+
+/**
+ * Throttling counters for one printer or server, exposed through getMetrics()
+ */
+struct RateLimiterStats {
+    std::string name;
+    bool server = false;
+    uint64_t throttled = 0;       // Submissions that had to wait
+    double throttledMs = 0;       // Total time spent waiting
+};
+
+/**
+ * Token-bucket rate limiting for job submission
+ *
+ * reserve() takes tokens from the printer's and the server's buckets and
+ * returns how long until the reservation is covered, so bursts are delayed and
+ * never rejected. Reservations are taken in call order, which keeps waiting
+ * submissions first come, first served. acquire() also sleeps out the wait.
+ */
+class RateLimiter {
+public:
+    RateLimiter() = default;
+
+    // Non-copyable
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * Replace the limits; buckets start again full
+     */
+    void configure(const RateLimiterConfig& config);
+    RateLimiterConfig getConfig();
+
+    /**
+     * Whether any limit is configured; when not, reserve() always returns 0
+     */
+    bool enabled();
+
+    /**
+     * Reserve room for a job of `bytes` on the printer without waiting
+     * @returns Milliseconds until the job may be submitted
+     */
+    double reserve(const std::string& printer, uint64_t bytes);
+
+    /**
+     * Wait until a job of `bytes` may be submitted to the printer
+     * Blocks the calling thread; only for threads the library owns.
+     * @returns Milliseconds spent waiting
+     */
+    double acquire(const std::string& printer, uint64_t bytes);
+
+    std::vector<RateLimiterStats> getStats();
+
+    /**
+     * Server a printer's jobs are spooled by: host[:port] of a device URI, the
+     * server of a \\server\printer share, or "default" for local queues
+     */
+    static std::string serverOf(const std::string& printer);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Bucket {
+        double tokens = 0;
+        Clock::time_point updated;
+        bool primed = false;
+
+        /**
+         * Refill for the time since the last call, then take `amount` tokens,
+         * letting the bucket go into debt
+         * @returns Seconds until the debt is paid off
+         */
+        double take(double rate, double burst, double amount, Clock::time_point now);
+    };
+
+    struct Limited {
+        Bucket jobs;
+        Bucket bytes;
+        uint64_t throttled = 0;
+        double throttledMs = 0;
+    };
+
+    std::mutex mutex_;
+    RateLimiterConfig config_;
+    bool enabled_ = false;
+    std::map<std::string, Limited> printers_;
+    std::map<std::string, Limited> servers_;
+
+    double reserveLimited(Limited& state, const RateLimit& limit, uint64_t bytes, Clock::time_point now);
+};
+
+} // namespace NodePrinter
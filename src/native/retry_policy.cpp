@@ -0,0 +1,105 @@
+#include "retry_policy.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+
+namespace NodePrinter {
+
+std::vector<int> defaultRetryableStatuses() {
+#ifdef _WIN32
+    return {
+        21,     // ERROR_NOT_READY
+        59,     // ERROR_UNEXP_NET_ERR
+        64,     // ERROR_NETNAME_DELETED
+        121,    // ERROR_SEM_TIMEOUT
+        170,    // ERROR_BUSY
+        1722,   // RPC_S_SERVER_UNAVAILABLE (spooler restarting)
+        1723,   // RPC_S_SERVER_TOO_BUSY
+        1726,   // RPC_S_CALL_FAILED
+    };
+#else
+    return {
+        0x0405, // client-error-timeout
+        0x0500, // server-error-internal-error
+        0x0502, // server-error-service-unavailable
+        0x0505, // server-error-temporary-error
+        0x0507, // server-error-busy
+    };
+#endif
+}
+
+bool isResubmittable(const PrinterException& e) {
+    if (e.isJobCreated()) {
+        return false;
+    }
+
+#ifdef _WIN32
+    static const int refused[] = {
+        170,    // ERROR_BUSY
+        1722,   // RPC_S_SERVER_UNAVAILABLE
+        1723,   // RPC_S_SERVER_TOO_BUSY
+    };
+#else
+    static const int refused[] = {
+        0x0502, // server-error-service-unavailable
+        0x0507, // server-error-busy
+    };
+#endif
+    return std::find(std::begin(refused), std::end(refused), e.getPlatformCode()) != std::end(refused);
+}
+
+RetryEngine::RetryEngine() {
+    policy_.retryableStatuses = defaultRetryableStatuses();
+}
+
+void RetryEngine::configure(const RetryPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+    policy_.maxAttempts = std::max(policy_.maxAttempts, 1);
+    policy_.jitter = std::min(std::max(policy_.jitter, 0.0), 1.0);
+    if (policy_.retryableStatuses.empty()) {
+        policy_.retryableStatuses = defaultRetryableStatuses();
+    }
+}
+
+RetryPolicy RetryEngine::getPolicy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return policy_;
+}
+
+RetryStats RetryEngine::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool RetryEngine::isRetryable(const RetryPolicy& policy, int status) {
+    return status != 0 &&
+           std::find(policy.retryableStatuses.begin(), policy.retryableStatuses.end(), status) !=
+               policy.retryableStatuses.end();
+}
+
+double RetryEngine::backoffMs(const RetryPolicy& policy, int attempt) {
+    double delay = policy.initialDelayMs * std::pow(policy.multiplier, attempt - 1);
+    delay = std::min(delay, policy.maxDelayMs);
+
+    // Jitter only shortens the delay, so maxDelayMs stays a hard cap and
+    // workers that failed together spread out instead of retrying in lockstep
+    thread_local std::mt19937 random{std::random_device{}()};
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    return std::max(0.0, delay * (1.0 - policy.jitter * unit(random)));
+}
+
+void RetryEngine::recordSuccess(int attempt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = static_cast<size_t>(attempt - 1);
+    if (stats_.succeededOnAttempt.size() <= index) {
+        stats_.succeededOnAttempt.resize(index + 1, 0);
+    }
+    ++stats_.succeededOnAttempt[index];
+    if (attempt > 1) {
+        ++stats_.recovered;
+    }
+}
+
+} // namespace NodePrinter
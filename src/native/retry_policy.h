@@ -0,0 +1,203 @@
+#pragma once
+#include "job_api.h"
+#include "errors.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * When and how often a failed spooler call is tried again
+ */
+struct RetryPolicy {
+    int maxAttempts = 3;              // Including the first; 1 disables retries
+    double initialDelayMs = 100;
+    double maxDelayMs = 2000;
+    double multiplier = 2.0;          // Backoff growth per attempt
+    double jitter = 0.5;              // Fraction of each delay that is randomized (0-1)
+    std::vector<int> retryableStatuses;   // Platform codes; empty = defaultRetryableStatuses()
+};
+
+/**
+ * Retry counters, exposed through getMetrics()
+ */
+struct RetryStats {
+    uint64_t operations = 0;          // Calls made through the engine
+    uint64_t attempts = 0;
+    uint64_t retries = 0;
+    uint64_t recovered = 0;           // Succeeded after at least one retry
+    uint64_t exhausted = 0;           // Still failing with a retryable status after maxAttempts
+    double backoffMs = 0;             // Total time slept between attempts
+    std::vector<uint64_t> succeededOnAttempt;     // [0] = first attempt, [1] = second, ...
+    std::map<int, uint64_t> retriedStatuses;      // Retryable failures by platform code
+};
+
+/**
+ * Transient failures, keyed on the platform status (cupsLastError() / GetLastError())
+ * CUPS: server-error-busy, -service-unavailable (also connection failures and
+ * resets), -temporary-error, -internal-error and client-error-timeout.
+ */
+std::vector<int> defaultRetryableStatuses();
+
+/**
+ * Whether a failed submission can be sent again without printing the job twice
+ * Only when the spooler refused it as busy or unavailable before creating a job;
+ * after that the same statuses also report a connection dropped mid-document.
+ */
+bool isResubmittable(const PrinterException& e);
+
+/**
+ * Runs spooler calls with retries, exponential backoff and jitter
+ *
+ * Only PrinterExceptions whose platform code is in the retryable set are
+ * retried; everything else fails on the first attempt. Backoff sleeps the
+ * calling thread, so calls must come from worker threads.
+ */
+class RetryEngine {
+public:
+    RetryEngine();
+
+    // Non-copyable
+    RetryEngine(const RetryEngine&) = delete;
+    RetryEngine& operator=(const RetryEngine&) = delete;
+
+    void configure(const RetryPolicy& policy);
+    RetryPolicy getPolicy();
+    RetryStats getStats();
+
+    template <typename Fn>
+    auto run(Fn fn) -> decltype(fn()) {
+        return run(fn, [](const PrinterException&) { return true; });
+    }
+
+    /**
+     * Like run(), but only failures that canRetry accepts are retried
+     */
+    template <typename Fn, typename Filter>
+    auto run(Fn fn, Filter canRetry) -> decltype(fn()) {
+        RetryPolicy policy = getPolicy();
+        record([](RetryStats& stats) { ++stats.operations; });
+
+        for (int attempt = 1;; ++attempt) {
+            try {
+                record([](RetryStats& stats) { ++stats.attempts; });
+                auto result = fn();
+                recordSuccess(attempt);
+                return result;
+            } catch (const PrinterException& e) {
+                bool retryable = isRetryable(policy, e.getPlatformCode()) && canRetry(e);
+                if (!retryable || attempt >= policy.maxAttempts) {
+                    if (retryable) {
+                        record([](RetryStats& stats) { ++stats.exhausted; });
+                    }
+                    throw;
+                }
+
+                double delayMs = backoffMs(policy, attempt);
+                int status = e.getPlatformCode();
+                record([&](RetryStats& stats) {
+                    ++stats.retries;
+                    ++stats.retriedStatuses[status];
+                    stats.backoffMs += delayMs;
+                });
+                std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delayMs));
+            }
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    RetryPolicy policy_;
+    RetryStats stats_;
+
+    static bool isRetryable(const RetryPolicy& policy, int status);
+    static double backoffMs(const RetryPolicy& policy, int attempt);
+    void recordSuccess(int attempt);
+
+    template <typename Update>
+    void record(Update update) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        update(stats_);
+    }
+};
+
+/**
+ * IJobAPI decorator that routes every call through a RetryEngine
+ * Submissions are only retried when isResubmittable(): a failure after the job
+ * was created is surfaced as-is, since its cancellation may not have reached
+ * the spooler either.
+ */
+class RetryingJobAPI : public IJobAPI {
+public:
+    RetryingJobAPI(std::unique_ptr<IJobAPI> inner, RetryEngine& engine)
+        : inner_(std::move(inner)), engine_(engine) {}
+
+    int printFile(const PrintFileRequest& request) override {
+        return engine_.run([&] { return inner_->printFile(request); }, isResubmittable);
+    }
+
+    int printRaw(const PrintRawRequest& request) override {
+        return engine_.run([&] { return inner_->printRaw(request); }, isResubmittable);
+    }
+
+    int printDocuments(const PrintDocumentsRequest& request) override {
+        return engine_.run([&] { return inner_->printDocuments(request); }, isResubmittable);
+    }
+
+    JobInfo getJob(const std::string& printer, int jobId) override {
+        return engine_.run([&] { return inner_->getJob(printer, jobId); });
+    }
+
+    std::vector<JobInfo> getJobs(const std::string& printer = "") override {
+        return engine_.run([&] { return inner_->getJobs(printer); });
+    }
+
+    JobPage getJobsPage(const JobPageRequest& request) override {
+        return engine_.run([&] { return inner_->getJobsPage(request); });
+    }
+
+    std::vector<PrinterJobs> getAllJobs(const AllJobsRequest& request) override {
+        return engine_.run([&] { return inner_->getAllJobs(request); });
+    }
+
+    std::vector<JobLookup> getJobsBatch(const std::vector<JobRef>& refs) override {
+        return engine_.run([&] { return inner_->getJobsBatch(refs); });
+    }
+
+    int getQueuedJobCount(const std::string& printer) override {
+        return engine_.run([&] { return inner_->getQueuedJobCount(printer); });
+    }
+
+    void setJob(const std::string& printer, int jobId, JobCommand command) override {
+        engine_.run([&] {
+            inner_->setJob(printer, jobId, command);
+            return true;
+        });
+    }
+
+    void updateJob(const std::string& printer, int jobId, const JobUpdate& update) override {
+        engine_.run([&] {
+            inner_->updateJob(printer, jobId, update);
+            return true;
+        });
+    }
+
+    std::vector<JobCommandResult> cancelJobs(const std::string& printer, const std::vector<int>& ids) override {
+        return engine_.run([&] { return inner_->cancelJobs(printer, ids); });
+    }
+
+    std::vector<JobCommandResult> purgeJobs(const PurgeRequest& request) override {
+        return engine_.run([&] { return inner_->purgeJobs(request); });
+    }
+
+private:
+    std::unique_ptr<IJobAPI> inner_;
+    RetryEngine& engine_;
+};
+
+} // namespace NodePrinter
@@ -0,0 +1,399 @@
+#include "submission_queue.h"
+#include <algorithm>
+
+namespace NodePrinter {
+
+// Weight of the newest sample in the smoothed measurements
+static const double EWMA_WEIGHT = 0.2;
+
+// Minimum age of a sampled job before it is probed, and between probes
+static const std::chrono::milliseconds PROBE_INTERVAL(500);
+
+static double smooth(double average, double sample) {
+    return average == 0 ? sample : average + (sample - average) * EWMA_WEIGHT;
+}
+
+void ConcurrencyController::onSubmitted(double latencyMs, bool ok, size_t inFlight,
+                                        const SubmissionQueueConfig& config) {
+    errorRate_ += ((ok ? 0.0 : 1.0) - errorRate_) * EWMA_WEIGHT;
+    if (!ok) {
+        decrease(0.5, "errors", config);
+        return;
+    }
+
+    latencyMs_ = smooth(latencyMs_, latencyMs);
+    // Let the baseline creep towards the average so a lasting change of path is relearned
+    baselineMs_ = baselineMs_ == 0 ? latencyMs : std::min(latencyMs, baselineMs_ + (latencyMs_ - baselineMs_) * 0.01);
+
+    if (latencyMs_ > baselineMs_ * config.latencyTolerance) {
+        decrease(0.7, "latency", config);
+        return;
+    }
+
+    if (completionBaselineMs_ > 0 && completionMs_ > completionBaselineMs_ * config.latencyTolerance) {
+        reason_ = "backlog";
+        return;
+    }
+
+    // Only grow while the current window is actually used
+    if (inFlight + 1 >= static_cast<size_t>(limit_)) {
+        limit_ += 1.0 / limit_;
+        reason_.clear();
+    }
+    clamp(config);
+}
+
+void ConcurrencyController::onCompleted(double completionMs, const SubmissionQueueConfig& /*config*/) {
+    completionMs_ = smooth(completionMs_, completionMs);
+    completionBaselineMs_ = completionBaselineMs_ == 0
+        ? completionMs
+        : std::min(completionMs, completionBaselineMs_ + (completionMs_ - completionBaselineMs_) * 0.01);
+}
+
+void ConcurrencyController::clamp(const SubmissionQueueConfig& config) {
+    limit_ = std::max(1.0, std::min(limit_, static_cast<double>(config.maxInFlight)));
+}
+
+void ConcurrencyController::decrease(double factor, const char* reason, const SubmissionQueueConfig& config) {
+    reason_ = reason;
+
+    // One cut per round trip; the submissions already in flight saw the same conditions
+    auto now = Clock::now();
+    if (decreases_ > 0 && now - lastDecrease_ < std::chrono::milliseconds(static_cast<int64_t>(latencyMs_))) {
+        return;
+    }
+
+    limit_ *= factor;
+    lastDecrease_ = now;
+    ++decreases_;
+    clamp(config);
+}
+
+SubmissionQueue::~SubmissionQueue() {
+    std::vector<Entry> abandoned;
+    std::vector<ReadyFn> ready;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& entry : queues_) {
+            for (auto& pending : entry.second.pending) {
+                abandoned.push_back(std::move(pending));
+            }
+            entry.second.pending.clear();
+            ready.insert(ready.end(), entry.second.waiters.begin(), entry.second.waiters.end());
+            entry.second.waiters.clear();
+        }
+    }
+    work_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Settle what never ran, so no caller is left waiting on it
+    for (auto& entry : abandoned) {
+        if (entry.abandon) {
+            entry.abandon();
+        }
+    }
+    for (auto& onReady : ready) {
+        onReady();
+    }
+}
+
+void SubmissionQueue::configure(const SubmissionQueueConfig& config) {
+    std::vector<ReadyFn> ready;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        if (config_.maxInFlight == 0) config_.maxInFlight = 1;
+        if (config_.maxQueuedJobs == 0) config_.maxQueuedJobs = 1;
+        if (config_.workers == 0) config_.workers = 1;
+        if (config_.initialInFlight == 0) config_.initialInFlight = 1;
+        if (config_.latencyTolerance < 1.0) config_.latencyTolerance = 1.0;
+
+        // Raised limits may free room for waiting callers
+        for (auto& entry : queues_) {
+            entry.second.controller.clamp(config_);
+            if (hasRoom(entry.second)) {
+                ready.insert(ready.end(), entry.second.waiters.begin(), entry.second.waiters.end());
+                entry.second.waiters.clear();
+            }
+        }
+
+        if (!workers_.empty()) {
+            startWorkersLocked();
+        }
+    }
+
+    work_.notify_all();
+    for (auto& onReady : ready) {
+        onReady();
+    }
+}
+
+void SubmissionQueue::setCompletionProbe(CompletionProbe probe) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_ = std::move(probe);
+}
+
+void SubmissionQueue::setThrottle(Throttle throttle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    throttle_ = std::move(throttle);
+}
+
+SubmissionQueueConfig SubmissionQueue::getConfig() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+bool SubmissionQueue::enqueue(const std::string& printer, uint64_t bytes, Job job, Abandon abandon) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PrinterQueue& queue = queueFor(printer);
+
+        bool empty = queue.pending.empty() && queue.inFlight == 0;
+        bool full = queue.pending.size() + queue.inFlight >= config_.maxQueuedJobs ||
+                    (!empty && queue.queuedBytes + bytes > config_.maxQueuedBytes);
+        if (full) {
+            ++queue.rejected;
+            return false;
+        }
+
+        queue.pending.push_back({bytes, std::move(job), std::move(abandon)});
+        queue.queuedBytes += bytes;
+        startWorkersLocked();
+    }
+
+    work_.notify_one();
+    return true;
+}
+
+bool SubmissionQueue::whenReady(const std::string& printer, ReadyFn onReady) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PrinterQueue& queue = queueFor(printer);
+    if (hasRoom(queue)) {
+        return true;
+    }
+
+    queue.waiters.push_back(std::move(onReady));
+    return false;
+}
+
+std::vector<SubmissionQueueStats> SubmissionQueue::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SubmissionQueueStats> stats;
+    stats.reserve(queues_.size());
+
+    for (const auto& entry : queues_) {
+        SubmissionQueueStats printerStats;
+        printerStats.printer = entry.first;
+        printerStats.queued = entry.second.pending.size();
+        printerStats.inFlight = entry.second.inFlight;
+        printerStats.queuedBytes = entry.second.queuedBytes;
+        printerStats.submitted = entry.second.submitted;
+        printerStats.failed = entry.second.failed;
+        printerStats.rejected = entry.second.rejected;
+
+        const ConcurrencyController& controller = entry.second.controller;
+        printerStats.limit = static_cast<double>(inFlightLimit(entry.second));
+        printerStats.latencyMs = controller.latencyMs();
+        printerStats.baselineLatencyMs = controller.baselineLatencyMs();
+        printerStats.errorRate = controller.errorRate();
+        printerStats.completionMs = controller.completionMs();
+        printerStats.decreases = controller.decreases();
+        printerStats.throttleReason = controller.reason();
+        stats.push_back(std::move(printerStats));
+    }
+
+    return stats;
+}
+
+SubmissionQueue::PrinterQueue& SubmissionQueue::queueFor(const std::string& printer) {
+    auto it = queues_.find(printer);
+    if (it == queues_.end()) {
+        it = queues_.emplace(printer, PrinterQueue()).first;
+        it->second.controller = ConcurrencyController(static_cast<double>(config_.initialInFlight));
+        it->second.controller.clamp(config_);
+    }
+    return it->second;
+}
+
+size_t SubmissionQueue::inFlightLimit(const PrinterQueue& queue) const {
+    return config_.adaptive ? static_cast<size_t>(queue.controller.limit()) : config_.maxInFlight;
+}
+
+bool SubmissionQueue::hasRoom(const PrinterQueue& queue) const {
+    return queue.pending.size() + queue.inFlight < config_.maxQueuedJobs &&
+           queue.queuedBytes < config_.maxQueuedBytes;
+}
+
+bool SubmissionQueue::nextJob(std::string& printer, Entry& entry) {
+    if (queues_.empty()) {
+        return false;
+    }
+
+    // Continue after the printer served last so one busy printer cannot starve the rest
+    auto it = queues_.upper_bound(lastServed_);
+    for (size_t n = 0; n < queues_.size(); ++n, ++it) {
+        if (it == queues_.end()) {
+            it = queues_.begin();
+        }
+
+        PrinterQueue& queue = it->second;
+        if (!queue.pending.empty() && queue.inFlight < inFlightLimit(queue)) {
+            printer = it->first;
+            entry = std::move(queue.pending.front());
+            queue.pending.pop_front();
+            ++queue.inFlight;
+            lastServed_ = printer;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SubmissionQueue::startWorkersLocked() {
+    while (workers_.size() < config_.workers) {
+        workers_.emplace_back(&SubmissionQueue::workerLoop, this);
+    }
+}
+
+void SubmissionQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        if (stopping_) {
+            return;
+        }
+
+        // Sampled jobs are probed on their own schedule, so a printer that gets no
+        // further submissions still has its time-to-completed measured
+        std::string printer;
+        auto wake = ConcurrencyController::Clock::time_point::max();
+        if (nextProbe(printer, wake)) {
+            probeSample(printer, lock);
+            continue;
+        }
+
+        Entry entry;
+        if (!nextJob(printer, entry)) {
+            if (wake == ConcurrencyController::Clock::time_point::max()) {
+                work_.wait(lock);
+            } else {
+                work_.wait_until(lock, wake);
+            }
+            continue;
+        }
+
+        Throttle throttle = throttle_;
+        lock.unlock();
+
+        // The job keeps its in-flight slot while throttled, so the queue still applies backpressure
+        double throttledMs = throttle ? throttle(printer, entry.bytes) : 0;
+
+        auto started = ConcurrencyController::Clock::now();
+        int jobId = 0;
+        try {
+            jobId = entry.job(throttledMs);
+        } catch (...) {
+            // Jobs report their own errors; a throw only counts as a failure here
+        }
+        auto finished = ConcurrencyController::Clock::now();
+        lock.lock();
+
+        PrinterQueue& queue = queues_[printer];
+        --queue.inFlight;
+        queue.queuedBytes -= std::min(queue.queuedBytes, entry.bytes);
+        if (jobId > 0) {
+            ++queue.submitted;
+        } else {
+            ++queue.failed;
+        }
+
+        double latencyMs = std::chrono::duration<double, std::milli>(finished - started).count();
+        queue.controller.onSubmitted(latencyMs, jobId > 0, queue.inFlight, config_);
+
+        if (jobId > 0 && queue.sample.jobId == 0 && probe_) {
+            queue.sample.jobId = jobId;
+            queue.sample.submitted = finished;
+            queue.sample.lastProbe = finished;
+        }
+
+        std::vector<ReadyFn> ready;
+        PrinterQueue& current = queues_[printer];
+        if (hasRoom(current)) {
+            ready.swap(current.waiters);
+        }
+
+        // A slot opened up; another worker may be able to use it
+        work_.notify_one();
+
+        if (!ready.empty()) {
+            lock.unlock();
+            for (auto& onReady : ready) {
+                onReady();
+            }
+            lock.lock();
+        }
+    }
+}
+
+bool SubmissionQueue::nextProbe(std::string& printer, ConcurrencyController::Clock::time_point& wake) {
+    if (!probe_) {
+        return false;
+    }
+
+    auto now = ConcurrencyController::Clock::now();
+    for (const auto& entry : queues_) {
+        const PrinterQueue& queue = entry.second;
+        if (queue.sample.jobId == 0 || queue.probing) {
+            continue;
+        }
+
+        auto due = queue.sample.lastProbe + PROBE_INTERVAL;
+        if (due <= now) {
+            printer = entry.first;
+            return true;
+        }
+        wake = std::min(wake, due);
+    }
+    return false;
+}
+
+void SubmissionQueue::probeSample(const std::string& printer, std::unique_lock<std::mutex>& lock) {
+    PrinterQueue& queue = queues_[printer];
+    auto now = ConcurrencyController::Clock::now();
+    if (!probe_ || queue.probing || queue.sample.jobId == 0 || now - queue.sample.lastProbe < PROBE_INTERVAL) {
+        return;
+    }
+
+    CompletionSample sample = queue.sample;
+    CompletionProbe probe = probe_;
+    queue.probing = true;
+    queue.sample.lastProbe = now;
+
+    lock.unlock();
+    bool done = true;
+    try {
+        done = probe(printer, sample.jobId);
+    } catch (...) {
+        // Job vanished or cannot be queried: stop tracking it
+    }
+    auto probed = ConcurrencyController::Clock::now();
+    lock.lock();
+
+    PrinterQueue& current = queues_[printer];
+    current.probing = false;
+    if (done && current.sample.jobId == sample.jobId) {
+        double completionMs = std::chrono::duration<double, std::milli>(probed - sample.submitted).count();
+        current.controller.onCompleted(completionMs, config_);
+        current.sample = CompletionSample();
+    }
+}
+
+} // namespace NodePrinter
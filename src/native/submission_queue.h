@@ -0,0 +1,211 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Submission queue limits
+ */
+struct SubmissionQueueConfig {
+    size_t maxInFlight = 8;                     // Concurrent submissions per printer (ceiling when adaptive)
+    uint64_t maxQueuedBytes = 64 * 1024 * 1024; // Data/file bytes held per printer (waiting + in flight)
+    size_t maxQueuedJobs = 1000;                // Jobs held per printer (waiting + in flight)
+    size_t workers = 4;                         // Threads shared by all printers (can only grow)
+    bool adaptive = true;                       // Tune each printer's limit between 1 and maxInFlight
+    size_t initialInFlight = 2;                 // Starting limit for adaptive printers
+    double latencyTolerance = 2.0;              // Back off once submit latency exceeds this multiple of the best seen
+};
+
+/**
+ * AIMD in-flight limit for one printer, in the style of TCP congestion control
+ *
+ * Grows by one slot per window of fast, successful submissions; shrinks
+ * multiplicatively on errors or when submit latency rises well above the best
+ * seen. A growing time-to-completed means the printer itself is the bottleneck,
+ * so the limit holds instead of growing.
+ */
+class ConcurrencyController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ConcurrencyController(double initialLimit = 2.0) : limit_(initialLimit) {}
+
+    double limit() const { return limit_; }
+
+    /**
+     * Record a finished submission
+     * @param inFlight Submissions still running for the printer, excluding this one
+     */
+    void onSubmitted(double latencyMs, bool ok, size_t inFlight, const SubmissionQueueConfig& config);
+
+    /**
+     * Record how long a sampled job took from submission to a final state
+     */
+    void onCompleted(double completionMs, const SubmissionQueueConfig& config);
+
+    void clamp(const SubmissionQueueConfig& config);
+
+    double latencyMs() const { return latencyMs_; }
+    double baselineLatencyMs() const { return baselineMs_; }
+    double errorRate() const { return errorRate_; }
+    double completionMs() const { return completionMs_; }
+    uint64_t decreases() const { return decreases_; }
+    const std::string& reason() const { return reason_; }
+
+private:
+    double limit_;
+    double latencyMs_ = 0;          // Smoothed submit latency
+    double baselineMs_ = 0;         // Best submit latency seen (drifts up slowly)
+    double errorRate_ = 0;          // Smoothed share of failed submissions
+    double completionMs_ = 0;       // Smoothed time-to-completed of sampled jobs
+    double completionBaselineMs_ = 0;
+    uint64_t decreases_ = 0;
+    std::string reason_;            // Why the limit last stopped growing ("errors", "latency", "backlog")
+    Clock::time_point lastDecrease_;
+
+    void decrease(double factor, const char* reason, const SubmissionQueueConfig& config);
+};
+
+/**
+ * Per-printer queue counters, exposed through getMetrics()
+ */
+struct SubmissionQueueStats {
+    std::string printer;
+    size_t queued = 0;
+    size_t inFlight = 0;
+    uint64_t queuedBytes = 0;
+    uint64_t submitted = 0;
+    uint64_t failed = 0;
+    uint64_t rejected = 0;      // Refused because the queue was full
+
+    // Concurrency tuning
+    double limit = 0;           // Current in-flight limit
+    double latencyMs = 0;
+    double baselineLatencyMs = 0;
+    double errorRate = 0;
+    double completionMs = 0;
+    uint64_t decreases = 0;
+    std::string throttleReason;
+};
+
+/**
+ * Bounded per-printer submission queue
+ *
+ * Jobs wait in memory until their printer has a free in-flight slot, then run
+ * on a small shared worker pool. Admission is refused once a printer holds
+ * maxQueuedJobs or maxQueuedBytes, so bursts cannot pile up unbounded temp
+ * files, memory, or concurrent requests against the spooler.
+ */
+class SubmissionQueue {
+public:
+    // Runs on a worker thread once any throttle wait is over; returns the job ID, or 0 when
+    // the printer did not accept the job
+    using Job = std::function<int(double throttledMs)>;
+    // Called instead of the job when the queue shuts down before it ran
+    using Abandon = std::function<void()>;
+    using ReadyFn = std::function<void()>;
+    // Returns true once a submitted job has reached a final state
+    using CompletionProbe = std::function<bool(const std::string& printer, int jobId)>;
+    // Blocks until a job may be submitted; returns the milliseconds waited
+    using Throttle = std::function<double(const std::string& printer, uint64_t bytes)>;
+
+    SubmissionQueue() = default;
+
+    /**
+     * Stop the workers once their running jobs return
+     * Jobs still waiting are abandoned and waiting callers are released.
+     */
+    ~SubmissionQueue();
+
+    // Non-copyable
+    SubmissionQueue(const SubmissionQueue&) = delete;
+    SubmissionQueue& operator=(const SubmissionQueue&) = delete;
+
+    void configure(const SubmissionQueueConfig& config);
+
+    /**
+     * Enable time-to-completed sampling for adaptive limits
+     * One job per printer is tracked at a time; an idle worker probes it every
+     * 500ms until it finishes, whether or not more jobs arrive.
+     */
+    void setCompletionProbe(CompletionProbe probe);
+
+    /**
+     * Rate-limit submissions; the wait is not counted as submit latency
+     */
+    void setThrottle(Throttle throttle);
+    SubmissionQueueConfig getConfig();
+
+    /**
+     * Queue a job for a printer
+     * A job larger than maxQueuedBytes is still admitted into an empty queue.
+     * @param abandon Called, from the destroying thread, if the queue shuts down before the job runs
+     * @returns false, without taking the job, when the printer's queue is full
+     */
+    bool enqueue(const std::string& printer, uint64_t bytes, Job job, Abandon abandon = nullptr);
+
+    /**
+     * Wait for room in a printer's queue
+     * @returns true if the queue can take a job now (onReady is dropped); otherwise
+     *          onReady is called from a worker thread once it can
+     */
+    bool whenReady(const std::string& printer, ReadyFn onReady);
+
+    std::vector<SubmissionQueueStats> getStats();
+
+private:
+    struct Entry {
+        uint64_t bytes = 0;
+        Job job;
+        Abandon abandon;
+    };
+
+    struct CompletionSample {
+        int jobId = 0;
+        ConcurrencyController::Clock::time_point submitted;
+        ConcurrencyController::Clock::time_point lastProbe;
+    };
+
+    struct PrinterQueue {
+        std::deque<Entry> pending;
+        size_t inFlight = 0;
+        ConcurrencyController controller;
+        CompletionSample sample;
+        bool probing = false;
+        uint64_t queuedBytes = 0;
+        std::vector<ReadyFn> waiters;
+        uint64_t submitted = 0;
+        uint64_t failed = 0;
+        uint64_t rejected = 0;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable work_;
+    std::map<std::string, PrinterQueue> queues_;
+    std::string lastServed_;            // Printers are served round-robin from here
+    SubmissionQueueConfig config_;
+    std::vector<std::thread> workers_;
+    CompletionProbe probe_;
+    Throttle throttle_;
+    bool stopping_ = false;
+
+    PrinterQueue& queueFor(const std::string& printer);
+    size_t inFlightLimit(const PrinterQueue& queue) const;
+    bool hasRoom(const PrinterQueue& queue) const;
+    void probeSample(const std::string& printer, std::unique_lock<std::mutex>& lock);
+    bool nextProbe(std::string& printer, ConcurrencyController::Clock::time_point& wake);
+    bool nextJob(std::string& printer, Entry& entry);
+    void startWorkersLocked();
+    void workerLoop();
+};
+
+} // namespace NodePrinter
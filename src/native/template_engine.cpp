@@ -0,0 +1,198 @@
+#include "template_engine.h"
+#include "errors.h"
+#include <algorithm>
+
+namespace NodePrinter {
+
+// Longest placeholder body accepted, "name:>width"
+static const size_t MAX_PLACEHOLDER = 256;
+
+static bool isNameChar(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_' || c == '-' || c == '.';
+}
+
+/**
+ * Byte length of the first `chars` UTF-8 characters of value (or all of it)
+ */
+static size_t utf8Prefix(const std::string& value, size_t chars, size_t& counted) {
+    size_t i = 0;
+    counted = 0;
+    while (i < value.size() && counted < chars) {
+        // Skip continuation bytes of the current character
+        ++i;
+        while (i < value.size() && (static_cast<uint8_t>(value[i]) & 0xC0) == 0x80) {
+            ++i;
+        }
+        ++counted;
+    }
+    return i;
+}
+
+std::shared_ptr<PrintTemplate> PrintTemplate::compile(const uint8_t* source, size_t length) {
+    auto compiled = std::make_shared<PrintTemplate>();
+    compiled->literals_.reserve(length);
+
+    Segment literal;
+    size_t i = 0;
+    while (i < length) {
+        bool open = i + 1 < length && source[i] == '{' && source[i + 1] == '{';
+        if (!open) {
+            compiled->literals_.push_back(source[i++]);
+            ++literal.length;
+            continue;
+        }
+
+        size_t start = i + 2;
+        size_t end = start;
+        while (end + 1 < length && !(source[end] == '}' && source[end + 1] == '}') && end - start <= MAX_PLACEHOLDER) {
+            ++end;
+        }
+        if (end + 1 >= length || end - start > MAX_PLACEHOLDER) {
+            throw createInvalidArgumentsError("Unterminated placeholder at byte " + std::to_string(i));
+        }
+
+        std::string body(reinterpret_cast<const char*>(source + start), end - start);
+        Segment field;
+        size_t colon = body.find(':');
+        std::string name = body.substr(0, colon);
+
+        if (colon != std::string::npos) {
+            std::string format = body.substr(colon + 1);
+            field.align = Align::LEFT;
+            if (!format.empty() && (format[0] == '>' || format[0] == '<')) {
+                field.align = format[0] == '>' ? Align::RIGHT : Align::LEFT;
+                format.erase(0, 1);
+            }
+            if (format.empty() || format.size() > 4 || format.find_first_not_of("0123456789") != std::string::npos) {
+                throw createInvalidArgumentsError("Invalid width in placeholder {{" + body + "}}");
+            }
+            field.width = static_cast<size_t>(std::stoul(format));
+        }
+
+        if (name.empty()) {
+            throw createInvalidArgumentsError("Empty placeholder at byte " + std::to_string(i));
+        }
+        for (char c : name) {
+            if (!isNameChar(static_cast<uint8_t>(c))) {
+                throw createInvalidArgumentsError("Invalid field name in placeholder {{" + body + "}}");
+            }
+        }
+
+        if (literal.length > 0) {
+            compiled->segments_.push_back(literal);
+        }
+
+        auto known = std::find(compiled->fields_.begin(), compiled->fields_.end(), name);
+        field.field = static_cast<int>(known - compiled->fields_.begin());
+        if (known == compiled->fields_.end()) {
+            compiled->fields_.push_back(name);
+        }
+        compiled->segments_.push_back(field);
+
+        literal = Segment();
+        literal.offset = compiled->literals_.size();
+        i = end + 2;
+    }
+
+    if (literal.length > 0) {
+        compiled->segments_.push_back(literal);
+    }
+    return compiled;
+}
+
+void PrintTemplate::appendField(const Segment& segment, const std::string& value, std::vector<uint8_t>& out) const {
+    if (segment.align == Align::NONE) {
+        out.insert(out.end(), value.begin(), value.end());
+        return;
+    }
+
+    size_t chars = 0;
+    size_t bytes = utf8Prefix(value, segment.width, chars);
+    size_t padding = segment.width - chars;
+
+    if (segment.align == Align::RIGHT) {
+        out.insert(out.end(), padding, ' ');
+    }
+    out.insert(out.end(), value.begin(), value.begin() + bytes);
+    if (segment.align == Align::LEFT) {
+        out.insert(out.end(), padding, ' ');
+    }
+}
+
+void PrintTemplate::render(const std::vector<std::string>& values, size_t records,
+                           const std::string& separator, std::vector<uint8_t>& out) const {
+    size_t fieldCount = fields_.size();
+    if (values.size() < records * fieldCount) {
+        throw createInvalidArgumentsError("Not enough values for " + std::to_string(records) + " records");
+    }
+
+    // Size the output once: literals and separators are exact, fields are close enough
+    size_t needed = records * (literals_.size() + separator.size());
+    for (size_t i = 0; i < records * fieldCount; ++i) {
+        needed += values[i].size();
+    }
+    out.reserve(out.size() + needed);
+
+    for (size_t record = 0; record < records; ++record) {
+        if (record > 0) {
+            out.insert(out.end(), separator.begin(), separator.end());
+        }
+
+        const std::string* recordValues = values.data() + record * fieldCount;
+        for (const auto& segment : segments_) {
+            if (segment.field < 0) {
+                const uint8_t* bytes = literals_.data() + segment.offset;
+                out.insert(out.end(), bytes, bytes + segment.length);
+            } else {
+                appendField(segment, recordValues[segment.field], out);
+            }
+        }
+    }
+}
+
+BufferPool& BufferPool::instance() {
+    static BufferPool pool;
+    return pool;
+}
+
+std::vector<uint8_t> BufferPool::acquire(size_t sizeHint) {
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            buffer = std::move(free_.back());
+            free_.pop_back();
+            ++hits_;
+        } else {
+            ++misses_;
+        }
+    }
+
+    buffer.clear();
+    buffer.reserve(sizeHint);
+    return buffer;
+}
+
+void BufferPool::release(std::vector<uint8_t>&& buffer) {
+    if (buffer.capacity() == 0 || buffer.capacity() > MAX_POOLED_BYTES) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() < MAX_POOLED) {
+        free_.push_back(std::move(buffer));
+    }
+}
+
+uint64_t BufferPool::hits() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t BufferPool::misses() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+} // namespace NodePrinter
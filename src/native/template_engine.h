@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Raw-data layout (ESC/POS, ZPL, ...) with {{field}} placeholders, compiled once
+ *
+ * Placeholders:
+ *   {{name}}      value as-is
+ *   {{name:20}}   left-aligned, padded with spaces or cut to 20 characters
+ *   {{name:>8}}   right-aligned in 8 characters
+ * Everything else, including binary command bytes, is copied verbatim.
+ */
+class PrintTemplate {
+public:
+    /**
+     * @throws PrinterException (INVALID_ARGUMENTS) for unterminated or malformed placeholders
+     */
+    static std::shared_ptr<PrintTemplate> compile(const uint8_t* source, size_t length);
+
+    /**
+     * Distinct field names, in order of first use; values are passed in this order
+     */
+    const std::vector<std::string>& fields() const { return fields_; }
+
+    /**
+     * Append `records` filled-in copies of the layout to `out`
+     * @param values fields().size() values per record, records back to back
+     * @param separator Bytes written between records (e.g. a cut command)
+     */
+    void render(const std::vector<std::string>& values, size_t records,
+                const std::string& separator, std::vector<uint8_t>& out) const;
+
+private:
+    enum class Align { NONE, LEFT, RIGHT };
+
+    struct Segment {
+        size_t offset = 0;        // Literal bytes in literals_
+        size_t length = 0;
+        int field = -1;           // Index into fields_, or -1 for a literal
+        size_t width = 0;
+        Align align = Align::NONE;
+    };
+
+    std::vector<uint8_t> literals_;
+    std::vector<Segment> segments_;
+    std::vector<std::string> fields_;
+
+    void appendField(const Segment& segment, const std::string& value, std::vector<uint8_t>& out) const;
+};
+
+/**
+ * Reusable byte buffers for rendered jobs
+ *
+ * Rendering into a recycled buffer avoids growing a fresh allocation for
+ * every receipt; buffers come back once the job has been submitted or the
+ * JavaScript Buffer wrapping them is collected.
+ */
+class BufferPool {
+public:
+    static BufferPool& instance();
+
+    // Non-copyable
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * Take an empty buffer with room for at least `sizeHint` bytes
+     */
+    std::vector<uint8_t> acquire(size_t sizeHint);
+
+    /**
+     * Return a buffer; oversized buffers and buffers beyond the pool size are freed
+     */
+    void release(std::vector<uint8_t>&& buffer);
+
+    uint64_t hits();
+    uint64_t misses();
+
+private:
+    BufferPool() = default;
+
+    static const size_t MAX_POOLED = 32;
+    static const size_t MAX_POOLED_BYTES = 4 * 1024 * 1024;
+
+    std::mutex mutex_;
+    std::vector<std::vector<uint8_t>> free_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace NodePrinter
@@ -0,0 +1,312 @@
+#include "transcoder.h"
+#include "errors.h"
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <iconv.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NODE_PRINTER_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace NodePrinter {
+
+static const uint32_t INVALID = 0xFFFFFFFF;
+
+// Unicode code points of bytes 0x80-0xFF; 0 where the code page has no character
+static const uint16_t CP437_HIGH[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7, 0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9, 0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA, 0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556, 0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F, 0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B, 0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4, 0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248, 0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0,
+};
+
+static const uint16_t CP858_HIGH[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7, 0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9, 0x00FF, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x00D7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA, 0x00BF, 0x00AE, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x00C1, 0x00C2, 0x00C0, 0x00A9, 0x2563, 0x2551, 0x2557, 0x255D, 0x00A2, 0x00A5, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x00E3, 0x00C3, 0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x00F0, 0x00D0, 0x00CA, 0x00CB, 0x00C8, 0x20AC, 0x00CD, 0x00CE, 0x00CF, 0x2518, 0x250C, 0x2588, 0x2584, 0x00A6, 0x00CC, 0x2580,
+    0x00D3, 0x00DF, 0x00D4, 0x00D2, 0x00F5, 0x00D5, 0x00B5, 0x00FE, 0x00DE, 0x00DA, 0x00DB, 0x00D9, 0x00FD, 0x00DD, 0x00AF, 0x00B4,
+    0x00AD, 0x00B1, 0x2017, 0x00BE, 0x00B6, 0x00A7, 0x00F7, 0x00B8, 0x00B0, 0x00A8, 0x00B7, 0x00B9, 0x00B3, 0x00B2, 0x25A0, 0x00A0,
+};
+
+// 0xA0-0xFF are Latin-1 and filled in when the table is built
+static const uint16_t CP1252_HIGH[32] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017D, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x0000, 0x017E, 0x0178,
+};
+
+/**
+ * Code point -> byte lookup for a single-byte code page
+ * Every character these code pages carry is below U+2600, so a flat table covers them.
+ */
+class SingleByteTable {
+public:
+    static const uint32_t LIMIT = 0x2600;
+
+    explicit SingleByteTable(const uint16_t* high, size_t count) : bytes_(LIMIT, 0) {
+        for (size_t i = 0; i < 128; ++i) {
+            uint16_t codePoint = i < count ? high[i] : static_cast<uint16_t>(0x80 + i);
+            if (codePoint != 0) {
+                bytes_[codePoint] = static_cast<uint8_t>(0x80 + i);
+            }
+        }
+    }
+
+    // 0 when the code page has no such character
+    uint8_t lookup(uint32_t codePoint) const {
+        return codePoint < LIMIT ? bytes_[codePoint] : 0;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+static const SingleByteTable& tableFor(CodePage codePage) {
+    static const SingleByteTable cp437(CP437_HIGH, 128);
+    static const SingleByteTable cp858(CP858_HIGH, 128);
+    static const SingleByteTable cp1252(CP1252_HIGH, 32);
+    switch (codePage) {
+        case CodePage::CP858: return cp858;
+        case CodePage::CP1252: return cp1252;
+        default: return cp437;
+    }
+}
+
+/**
+ * CP932 conversion of single characters through the platform converter
+ */
+class ShiftJisConverter {
+public:
+    ShiftJisConverter() = default;
+    ~ShiftJisConverter() {
+#ifndef _WIN32
+        if (cd_ != reinterpret_cast<iconv_t>(-1)) {
+            iconv_close(cd_);
+        }
+#endif
+    }
+
+    // Non-copyable
+    ShiftJisConverter(const ShiftJisConverter&) = delete;
+    ShiftJisConverter& operator=(const ShiftJisConverter&) = delete;
+
+    /**
+     * Append the bytes of one character
+     * @returns false if CP932 has no such character
+     */
+    bool convert(uint32_t codePoint, std::vector<uint8_t>& out) {
+        // Half-width katakana are single bytes
+        if (codePoint >= 0xFF61 && codePoint <= 0xFF9F) {
+            out.push_back(static_cast<uint8_t>(codePoint - 0xFF61 + 0xA1));
+            return true;
+        }
+
+        char bytes[8];
+        size_t count = 0;
+#ifdef _WIN32
+        wchar_t wide[2];
+        int wideLength = 1;
+        if (codePoint >= 0x10000) {
+            wide[0] = static_cast<wchar_t>(0xD800 + ((codePoint - 0x10000) >> 10));
+            wide[1] = static_cast<wchar_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+            wideLength = 2;
+        } else {
+            wide[0] = static_cast<wchar_t>(codePoint);
+        }
+        BOOL usedDefault = FALSE;
+        int written = WideCharToMultiByte(932, WC_NO_BEST_FIT_CHARS, wide, wideLength, bytes, sizeof(bytes),
+                                          NULL, &usedDefault);
+        if (written <= 0 || usedDefault) {
+            return false;
+        }
+        count = static_cast<size_t>(written);
+#else
+        if (cd_ == reinterpret_cast<iconv_t>(-1)) {
+            cd_ = iconv_open("CP932", "UTF-32LE");
+            if (cd_ == reinterpret_cast<iconv_t>(-1)) {
+                throw createInvalidArgumentsError("Shift-JIS is not available on this system");
+            }
+        }
+        char in[4] = {
+            static_cast<char>(codePoint), static_cast<char>(codePoint >> 8),
+            static_cast<char>(codePoint >> 16), static_cast<char>(codePoint >> 24)
+        };
+        char* inPtr = in;
+        size_t inLeft = sizeof(in);
+        char* outPtr = bytes;
+        size_t outLeft = sizeof(bytes);
+        if (iconv(cd_, &inPtr, &inLeft, &outPtr, &outLeft) == static_cast<size_t>(-1)) {
+            iconv(cd_, NULL, NULL, NULL, NULL);
+            return false;
+        }
+        count = sizeof(bytes) - outLeft;
+#endif
+        out.insert(out.end(), bytes, bytes + count);
+        return true;
+    }
+
+private:
+#ifndef _WIN32
+    iconv_t cd_ = reinterpret_cast<iconv_t>(-1);
+#endif
+};
+
+/**
+ * Length of the ASCII run at the start of text
+ */
+static size_t asciiPrefix(const uint8_t* text, size_t length) {
+    size_t i = 0;
+#ifdef NODE_PRINTER_SSE2
+    for (; i + 16 <= length; i += 16) {
+        unsigned high = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i))));
+        if (high) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, high);
+            return i + index;
+#else
+            return i + static_cast<size_t>(__builtin_ctz(high));
+#endif
+        }
+    }
+#endif
+    while (i < length && text[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Decode the multi-byte character at text[i] and move past it
+ * Invalid or overlong sequences consume one byte and yield INVALID.
+ */
+static uint32_t decodeUtf8(const uint8_t* text, size_t length, size_t& i) {
+    uint8_t lead = text[i];
+    size_t extra;
+    uint32_t codePoint;
+    uint32_t minimum;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        extra = 1; codePoint = lead & 0x1F; minimum = 0x80;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        extra = 2; codePoint = lead & 0x0F; minimum = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        extra = 3; codePoint = lead & 0x07; minimum = 0x10000;
+    } else {
+        ++i;
+        return INVALID;
+    }
+
+    if (length - i <= extra) {
+        ++i;
+        return INVALID;
+    }
+    for (size_t k = 1; k <= extra; ++k) {
+        uint8_t next = text[i + k];
+        if ((next & 0xC0) != 0x80) {
+            ++i;
+            return INVALID;
+        }
+        codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        ++i;
+        return INVALID;
+    }
+
+    i += extra + 1;
+    return codePoint;
+}
+
+void transcodeUtf8(const uint8_t* text, size_t length, const TranscodeOptions& options, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + length);
+
+    const SingleByteTable* table = options.codePage == CodePage::SHIFT_JIS ? nullptr : &tableFor(options.codePage);
+    ShiftJisConverter shiftJis;
+
+    size_t i = 0;
+    while (i < length) {
+        size_t run = asciiPrefix(text + i, length - i);
+        out.insert(out.end(), text + i, text + i + run);
+        i += run;
+        if (i >= length) {
+            break;
+        }
+
+        size_t start = i;
+        uint32_t codePoint = decodeUtf8(text, length, i);
+        if (codePoint != INVALID) {
+            if (table) {
+                uint8_t byte = table->lookup(codePoint);
+                if (byte != 0) {
+                    out.push_back(byte);
+                    continue;
+                }
+            } else if (shiftJis.convert(codePoint, out)) {
+                continue;
+            }
+        }
+
+        switch (options.unmappable) {
+            case Unmappable::REPLACE:
+                out.insert(out.end(), options.replacement.begin(), options.replacement.end());
+                break;
+            case Unmappable::SKIP:
+                break;
+            case Unmappable::FAIL:
+                if (codePoint == INVALID) {
+                    throw createInvalidArgumentsError("Invalid UTF-8 at byte " + std::to_string(start));
+                }
+                char hex[9];
+                std::snprintf(hex, sizeof(hex), "%04X", codePoint);
+                throw createInvalidArgumentsError("Character U+" + std::string(hex) + " at byte " +
+                                                  std::to_string(start) + " has no mapping in the code page");
+        }
+    }
+}
+
+bool parseCodePage(const std::string& name, CodePage& codePage) {
+    if (name == "cp437") {
+        codePage = CodePage::CP437;
+    } else if (name == "cp858") {
+        codePage = CodePage::CP858;
+    } else if (name == "cp1252") {
+        codePage = CodePage::CP1252;
+    } else if (name == "shift_jis") {
+        codePage = CodePage::SHIFT_JIS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseUnmappable(const std::string& name, Unmappable& unmappable) {
+    if (name == "replace") {
+        unmappable = Unmappable::REPLACE;
+    } else if (name == "skip") {
+        unmappable = Unmappable::SKIP;
+    } else if (name == "error") {
+        unmappable = Unmappable::FAIL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace NodePrinter
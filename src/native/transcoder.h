@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NodePrinter {
+
+/**
+ * Printer code pages text can be transcoded to
+ */
+enum class CodePage {
+    CP437,          // IBM PC, the ESC/POS default
+    CP858,          // Multilingual Latin 1 with the euro sign
+    CP1252,         // Windows Latin 1
+    SHIFT_JIS       // Japanese (CP932 flavour)
+};
+
+/**
+ * What happens to characters the code page cannot represent (and to invalid UTF-8)
+ */
+enum class Unmappable {
+    REPLACE,        // Write the replacement bytes
+    SKIP,           // Drop the character
+    FAIL            // Throw INVALID_ARGUMENTS
+};
+
+struct TranscodeOptions {
+    CodePage codePage = CodePage::CP437;
+    Unmappable unmappable = Unmappable::REPLACE;
+    std::string replacement = "?";    // Already in the target code page
+};
+
+/**
+ * Append UTF-8 text to `out` in a printer code page
+ * Runs of ASCII (including control bytes such as ESC/POS commands) are copied
+ * 16 bytes at a time; other characters go through per-code-page tables, and
+ * Shift-JIS kanji through the platform converter.
+ * @throws PrinterException (INVALID_ARGUMENTS) for unmappable characters with Unmappable::FAIL
+ */
+void transcodeUtf8(const uint8_t* text, size_t length, const TranscodeOptions& options, std::vector<uint8_t>& out);
+
+/**
+ * Parse "cp437", "cp858", "cp1252" or "shift_jis"
+ * @returns false for unknown names
+ */
+bool parseCodePage(const std::string& name, CodePage& codePage);
+
+/**
+ * Parse "replace", "skip" or "error"
+ * @returns false for unknown names
+ */
+bool parseUnmappable(const std::string& name, Unmappable& unmappable);
+
+} // namespace NodePrinter
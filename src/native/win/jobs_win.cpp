@@ -3,12 +3,16 @@
 
 #include "../job_api.h"
 #include "../errors.h"
+#include "../format_sniffer.h"
 #include "../../mapping/job_state.h"
 #include "win_utils.h"
 #include <vector>
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <algorithm>
 
 namespace NodePrinter {
 
@@ -19,8 +23,89 @@ private:
   // Threshold for using temporary files (same as CUPS implementation)
   static const size_t STREAM_THRESHOLD = 4 * 1024 * 1024; // 4 MiB
   
+  // Threads enumerating queues in parallel for getAllJobs
+  static constexpr size_t ALL_JOBS_THREADS = 8;
+  
+  // Map job-priority (1-100) onto the spooler's MIN_PRIORITY..MAX_PRIORITY range
+  static bool setJobPriority(HANDLE handle, DWORD jobId, int priority) {
+    DWORD needed = 0;
+    GetJobW(handle, jobId, 1, NULL, 0, &needed);
+    if (needed == 0) {
+      return false;
+    }
+    
+    std::vector<BYTE> buffer(needed);
+    JOB_INFO_1W* pJob = reinterpret_cast<JOB_INFO_1W*>(buffer.data());
+    if (!GetJobW(handle, jobId, 1, buffer.data(), needed, &needed)) {
+      return false;
+    }
+    
+    if (priority < MIN_PRIORITY) priority = MIN_PRIORITY;
+    if (priority > MAX_PRIORITY) priority = MAX_PRIORITY;
+    pJob->Priority = static_cast<DWORD>(priority);
+    pJob->Position = JOB_POSITION_UNSPECIFIED;
+    return SetJobW(handle, jobId, 1, buffer.data(), 0) != FALSE;
+  }
+  
+  // The spooler only supports fixed daily windows per printer, not per-job hold times
+  static void rejectHoldUntil(const std::string& holdUntil) {
+    if (!holdUntil.empty()) {
+      throw PrinterException("holdUntil is not supported on Windows", PrinterErrorCode::UNSUPPORTED_OPERATION);
+    }
+  }
+  
+  static JobInfo toJobInfo(const JOB_INFO_2W& job, const std::string& printer) {
+    JobInfo info;
+    info.id = job.JobId;
+    info.state = JobMapping::mapJobState(job.Status);
+    info.printer = printer;
+    
+    if (job.pDocument) {
+      info.title = WinUtils::ws_to_utf8(job.pDocument);
+    }
+    
+    if (job.pUserName) {
+      info.user = WinUtils::ws_to_utf8(job.pUserName);
+    }
+    
+    info.pages = job.TotalPages;
+    info.size = job.Size;
+    
+    if (job.Submitted.wYear > 0) {
+      info.creationTime = systemtime_to_unix_timestamp(job.Submitted);
+    }
+    
+    return info;
+  }
+  
+  // Local and connected queues; names only (PRINTER_INFO_4 needs no driver or port lookups)
+  static std::vector<std::string> queueNames() {
+    std::vector<std::string> names;
+    DWORD needed = 0, returned = 0, flags = PRINTER_ENUM_LOCAL | PRINTER_ENUM_CONNECTIONS;
+    
+    EnumPrintersW(flags, NULL, 4, NULL, 0, &needed, &returned);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+      return names; // No printers
+    }
+    
+    std::vector<BYTE> buffer(needed);
+    PRINTER_INFO_4W* pPrinters = reinterpret_cast<PRINTER_INFO_4W*>(buffer.data());
+    if (!EnumPrintersW(flags, NULL, 4, buffer.data(), needed, &needed, &returned)) {
+      throw ErrorMappers::createWindowsError("Failed to enumerate printers");
+    }
+    
+    for (DWORD i = 0; i < returned; ++i) {
+      if (pPrinters[i].pPrinterName) {
+        names.push_back(WinUtils::ws_to_utf8(pPrinters[i].pPrinterName));
+      }
+    }
+    return names;
+  }
+  
 public:
   int printFile(const PrintFileRequest& request) override {
+    rejectHoldUntil(request.options.holdUntil);
+    
     std::wstring printerName = WinUtils::utf8_to_ws(request.printer);
     WinUtils::PrinterHandle handle(printerName.c_str());
     
@@ -57,10 +142,14 @@ public:
       throw ErrorMappers::createWindowsError("Failed to start print job");
     }
     
+    if (request.options.priority > 0) {
+      setJobPriority(handle, jobId, request.options.priority);
+    }
+    
     // Start page  
     if (!StartPagePrinter(handle)) {
       EndDocPrinter(handle);
-      throw ErrorMappers::createWindowsError("Failed to start page");
+      throw ErrorMappers::createWindowsError("Failed to start page").setJobCreated();
     }
     
     // Write data
@@ -68,7 +157,7 @@ public:
     if (!WritePrinter(handle, content.data(), static_cast<DWORD>(fileSize), &bytesWritten)) {
       EndPagePrinter(handle);
       EndDocPrinter(handle);
-      throw ErrorMappers::createWindowsError("Failed to write to printer");
+      throw ErrorMappers::createWindowsError("Failed to write to printer").setJobCreated();
     }
     
     // End page and document
@@ -79,6 +168,8 @@ public:
   }
   
   int printRaw(const PrintRawRequest& request) override {
+    rejectHoldUntil(request.options.holdUntil);
+    
     std::wstring printerName = WinUtils::utf8_to_ws(request.printer);
     WinUtils::PrinterHandle handle(printerName.c_str());
     
@@ -88,7 +179,13 @@ public:
     
     // Start print job
     std::wstring jobName = WinUtils::utf8_to_ws(request.options.jobName.empty() ? "Node.js Print Job" : request.options.jobName);
-    std::wstring dataType = WinUtils::utf8_to_ws(request.format.empty() ? "RAW" : request.format);
+    std::string format = request.format.empty() ? "RAW" : request.format;
+    if (isDetectFormat(format)) {
+      // The spooler only distinguishes TEXT from data the printer understands itself
+      DocumentFormat detected = sniffDocumentFormat(request.data.data(), request.data.size());
+      format = std::string(detected.mimeType) == "text/plain" ? "TEXT" : "RAW";
+    }
+    std::wstring dataType = WinUtils::utf8_to_ws(format);
     
     DWORD jobId = 0;
     
@@ -151,10 +248,14 @@ public:
         throw ErrorMappers::createWindowsError("Failed to start print job");
       }
       
+      if (request.options.priority > 0) {
+        setJobPriority(handle, jobId, request.options.priority);
+      }
+      
       // Start page  
       if (!StartPagePrinter(handle)) {
         EndDocPrinter(handle);
-        throw ErrorMappers::createWindowsError("Failed to start page");
+        throw ErrorMappers::createWindowsError("Failed to start page").setJobCreated();
       }
       
       // Write data
@@ -163,7 +264,7 @@ public:
                         static_cast<DWORD>(request.data.size()), &bytesWritten)) {
         EndPagePrinter(handle);
         EndDocPrinter(handle);
-        throw ErrorMappers::createWindowsError("Failed to write to printer");
+        throw ErrorMappers::createWindowsError("Failed to write to printer").setJobCreated();
       }
       
       // End page and document
@@ -174,6 +275,80 @@ public:
     return static_cast<int>(jobId);
   }
   
+  int printDocuments(const PrintDocumentsRequest& request) override {
+    rejectHoldUntil(request.options.holdUntil);
+    if (request.documents.empty()) {
+      throw createInvalidArgumentsError("At least one document is required");
+    }
+    
+    // Check every file before the job exists, so a bad document never leaves a partial job
+    for (const auto& document : request.documents) {
+      if (!document.filename.empty() && !std::ifstream(document.filename).is_open()) {
+        throw createFileNotFoundError(document.filename);
+      }
+    }
+    
+    std::wstring printerName = WinUtils::utf8_to_ws(request.printer);
+    WinUtils::PrinterHandle handle(printerName.c_str());
+    
+    if (!handle.isOk()) {
+      throw ErrorMappers::createWindowsError("Failed to open printer: " + request.printer);
+    }
+    
+    std::wstring jobName = WinUtils::utf8_to_ws(request.options.jobName.empty() ? "Node.js Print Job" : request.options.jobName);
+    std::wstring dataType = WinUtils::utf8_to_ws(request.format == "TEXT" ? "TEXT" : "RAW");
+    
+    DOC_INFO_1W docInfo;
+    docInfo.pDocName = const_cast<LPWSTR>(jobName.c_str());
+    docInfo.pOutputFile = NULL;
+    docInfo.pDatatype = const_cast<LPWSTR>(dataType.c_str());
+    
+    DWORD jobId = StartDocPrinterW(handle, 1, reinterpret_cast<LPBYTE>(&docInfo));
+    if (jobId == 0) {
+      throw ErrorMappers::createWindowsError("Failed to start print job");
+    }
+    
+    if (request.options.priority > 0) {
+      setJobPriority(handle, jobId, request.options.priority);
+    }
+    
+    // One spool job; each document is its own page of the job's data stream
+    std::vector<char> chunk(64 * 1024);
+    for (const auto& document : request.documents) {
+      if (!StartPagePrinter(handle)) {
+        SetJobW(handle, jobId, 0, NULL, JOB_CONTROL_DELETE);
+        EndDocPrinter(handle);
+        throw ErrorMappers::createWindowsError("Failed to start page").setJobCreated();
+      }
+      
+      bool written = true;
+      DWORD bytesWritten = 0;
+      if (document.filename.empty()) {
+        written = WritePrinter(handle, const_cast<uint8_t*>(document.data.data()),
+                               static_cast<DWORD>(document.data.size()), &bytesWritten) != FALSE;
+      } else {
+        std::ifstream file(document.filename, std::ios::binary);
+        while (written && file) {
+          file.read(chunk.data(), chunk.size());
+          if (file.gcount() > 0) {
+            written = WritePrinter(handle, chunk.data(), static_cast<DWORD>(file.gcount()), &bytesWritten) != FALSE;
+          }
+        }
+        written = written && !file.bad();
+      }
+      
+      EndPagePrinter(handle);
+      if (!written) {
+        SetJobW(handle, jobId, 0, NULL, JOB_CONTROL_DELETE);
+        EndDocPrinter(handle);
+        throw ErrorMappers::createWindowsError("Failed to write to printer").setJobCreated();
+      }
+    }
+    
+    EndDocPrinter(handle);
+    return static_cast<int>(jobId);
+  }
+  
   JobInfo getJob(const std::string& printer, int jobId) override {
     std::wstring printerName = WinUtils::utf8_to_ws(printer);
     WinUtils::PrinterHandle handle(printerName.c_str());
@@ -250,30 +425,110 @@ public:
     
     // Convert to JobInfo structs
     for (DWORD i = 0; i < returned; ++i) {
-      JobInfo info;
-      info.id = pJobs[i].JobId;
-      info.state = JobMapping::mapJobState(pJobs[i].Status);
-      info.printer = printer;
-      
-      if (pJobs[i].pDocument) {
-        info.title = WinUtils::ws_to_utf8(pJobs[i].pDocument);
-      }
-      
-      if (pJobs[i].pUserName) {
-        info.user = WinUtils::ws_to_utf8(pJobs[i].pUserName);
+      jobs.push_back(toJobInfo(pJobs[i], printer));
+    }
+    
+    return jobs;
+  }
+  
+  JobPage getJobsPage(const JobPageRequest& request) override {
+    JobPage page;
+    
+    if (request.printer.empty()) {
+      return page; // Same as getJobs: no all-printers listing on Windows
+    }
+    
+    std::wstring printerName = WinUtils::utf8_to_ws(request.printer);
+    WinUtils::PrinterHandle handle(printerName.c_str());
+    
+    if (!handle.isOk()) {
+      throw createPrinterNotFoundError(request.printer);
+    }
+    
+    // The spooler pages by queue position, so the cursor is the position of the
+    // next job; jobs that finish between pages shift the rest forward by one
+    DWORD first = static_cast<DWORD>(request.cursor);
+    DWORD limit = static_cast<DWORD>(request.limit);
+    DWORD needed = 0, returned = 0;
+    EnumJobsW(handle, first, limit, 2, NULL, 0, &needed, &returned);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+      return page; // No jobs at or past this position
+    }
+    
+    std::vector<BYTE> buffer(needed);
+    JOB_INFO_2W* pJobs = reinterpret_cast<JOB_INFO_2W*>(buffer.data());
+    
+    if (!EnumJobsW(handle, first, limit, 2, buffer.data(), needed, &needed, &returned)) {
+      throw ErrorMappers::createWindowsError("Failed to list jobs for " + request.printer);
+    }
+    
+    for (DWORD i = 0; i < returned; ++i) {
+      JobInfo info = toJobInfo(pJobs[i], request.printer);
+      if (jobMatches(info, request.which)) {
+        page.jobs.push_back(std::move(info));
       }
-      
-      info.pages = pJobs[i].TotalPages;
-      info.size = pJobs[i].Size;
-      
-      if (pJobs[i].Submitted.wYear > 0) {
-        info.creationTime = systemtime_to_unix_timestamp(pJobs[i].Submitted);
+    }
+    
+    if (returned >= limit) {
+      page.nextCursor = static_cast<int>(first + returned);
+    }
+    return page;
+  }
+  
+  std::vector<PrinterJobs> getAllJobs(const AllJobsRequest& request) override {
+    // The spooler has no all-queues listing, so a few threads split the queues between them
+    std::vector<std::string> printers = queueNames();
+    std::vector<PrinterJobs> groups(printers.size());
+    std::atomic<size_t> next{0};
+    
+    auto work = [&]() {
+      for (size_t i = next++; i < printers.size(); i = next++) {
+        groups[i].printer = printers[i];
+        try {
+          for (auto& job : getJobs(printers[i])) {
+            if (jobMatches(job, request.which)) {
+              groups[i].jobs.push_back(std::move(job));
+            }
+          }
+        } catch (const PrinterException& e) {
+          groups[i].error = e.what();
+          groups[i].errorCode = e.getCode();
+        } catch (const std::exception& e) {
+          groups[i].error = e.what();
+        }
       }
-      
-      jobs.push_back(std::move(info));
+    };
+    
+    runLanes(std::min(printers.size(), ALL_JOBS_THREADS), work);
+    
+    // Same shape as the CUPS listing: only printers with jobs (or errors to report)
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const PrinterJobs& group) {
+      return group.jobs.empty() && group.error.empty();
+    }), groups.end());
+    limitJobs(groups, request.limit);
+    return groups;
+  }
+  
+  int getQueuedJobCount(const std::string& printer) override {
+    std::wstring printerName = WinUtils::utf8_to_ws(printer);
+    WinUtils::PrinterHandle handle(printerName.c_str());
+    
+    if (!handle.isOk()) {
+      throw createPrinterNotFoundError(printer);
     }
     
-    return jobs;
+    DWORD needed = 0;
+    GetPrinterW(handle, 2, NULL, 0, &needed);
+    if (needed == 0) {
+      throw ErrorMappers::createWindowsError("Failed to get printer info");
+    }
+    
+    std::vector<BYTE> buffer(needed);
+    if (!GetPrinterW(handle, 2, buffer.data(), needed, &needed)) {
+      throw ErrorMappers::createWindowsError("Failed to get printer info");
+    }
+    
+    return static_cast<int>(reinterpret_cast<PRINTER_INFO_2W*>(buffer.data())->cJobs);
   }
   
   void setJob(const std::string& printer, int jobId, JobCommand command) override {
@@ -303,6 +558,24 @@ public:
       throw ErrorMappers::createWindowsError("Failed to set job command");
     }
   }
+  
+  void updateJob(const std::string& printer, int jobId, const JobUpdate& update) override {
+    rejectHoldUntil(update.holdUntil);
+    if (update.priority <= 0) {
+      throw createInvalidArgumentsError("Nothing to update: priority required");
+    }
+    
+    std::wstring printerName = WinUtils::utf8_to_ws(printer);
+    WinUtils::PrinterHandle handle(printerName.c_str());
+    
+    if (!handle.isOk()) {
+      throw createPrinterNotFoundError(printer);
+    }
+    
+    if (!setJobPriority(handle, jobId, update.priority)) {
+      throw ErrorMappers::createWindowsError("Failed to set job priority");
+    }
+  }
 };
 
 } // namespace NodePrinter
\ No newline at end of file
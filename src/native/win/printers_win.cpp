@@ -44,6 +44,19 @@ static const std::vector<std::pair<std::string, DWORD>>& getStatusMap() {
   return v;
 }
 
+// Status bits as lower-case reason keywords, in the style of IPP printer-state-reasons
+static std::vector<std::string> statusReasons(DWORD status) {
+  std::vector<std::string> reasons;
+  for (const auto& entry : getStatusMap()) {
+    if (status & entry.second) {
+      std::string reason = entry.first;
+      std::transform(reason.begin(), reason.end(), reason.begin(), ::tolower);
+      reasons.push_back(reason);
+    }
+  }
+  return reasons;
+}
+
 class WinPrinterAPI : public IPrinterAPI {
 public:
   std::vector<PrinterInfo> getPrinters() override {
@@ -70,6 +83,7 @@ public:
       PrinterInfo info;
       info.name = WinUtils::ws_to_utf8(pPrinters[i].pPrinterName);
       info.state = StateMapping::mapPrinterState(pPrinters[i].Status, pPrinters[i].Attributes);
+      info.stateReasons = statusReasons(pPrinters[i].Status);
       
       if (pPrinters[i].pLocation) {
         info.location = WinUtils::ws_to_utf8(pPrinters[i].pLocation);
@@ -117,6 +131,7 @@ public:
     PrinterInfo info;
     info.name = name;
     info.state = StateMapping::mapPrinterState(pPrinter->Status, pPrinter->Attributes);
+    info.stateReasons = statusReasons(pPrinter->Status);
     
     if (pPrinter->pLocation) {
       info.location = WinUtils::ws_to_utf8(pPrinter->pLocation);